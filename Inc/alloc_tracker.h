@@ -0,0 +1,120 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_ALLOC_TRACKER_H
+#define OPENGL_PRACTICE_ALLOC_TRACKER_H
+
+#include <profiler.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// what an allocation is counted under: the innermost ALLOC_SCOPE of the thread making it
+enum AllocSubsystem {
+    ALLOC_OTHER,
+    // the frame loop's drawing
+    ALLOC_RENDER,
+    ALLOC_MODELS,
+    // decoding, cooking and caching textures
+    ALLOC_TEXTURES,
+    // the texture streamer and GPU residency
+    ALLOC_STREAMING,
+    // the profilers, the HUD and the other instrumentation
+    ALLOC_PROFILER,
+    // the run's own record of itself (the headless frame time histories): counted, but the only allocations
+    // AssertSteadyState lets through, since they grow with the run rather than the scene
+    ALLOC_RECORDING,
+    ALLOC_SUBSYSTEM_COUNT
+};
+
+struct AllocCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+// Counts every heap allocation of the process (a replacement of the global operator new) by subsystem, and those
+// made during each frame of the render loop, to find the heap traffic behind uneven frame times. AssertSteadyState
+// turns the counting into a check: from the given frame on, any allocation by the frame loop's thread prints what
+// was allocated and aborts, so a debugger stops right at it. Counting starts with Enable and costs one relaxed
+// atomic load per allocation before that. The hook is compiled in with the zones, by -DBLOB_SEA_PROFILE=ON;
+// without it nothing is counted.
+class AllocTracker {
+public:
+    // returns the single instance shared by the whole process
+    static AllocTracker &Instance();
+
+    void Enable();
+    bool Enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // closes the previous frame's count and starts the next. Call it first thing every frame, from the frame
+    // loop's thread
+    void BeginFrame();
+    // the frame loop is over: nothing counts as in a frame any more and the assertion is off
+    void EndFrames();
+    // aborts on any allocation of the calling thread in a frame (but ALLOC_RECORDING ones), from frame firstFrame on
+    // (counting from 0)
+    void AssertSteadyState(unsigned int firstFrame);
+
+    AllocCounts Subsystem(AllocSubsystem subsystem) const;
+    // allocations in the last complete frame
+    uint64_t LastFrameAllocations() const { return lastFrameAllocations; }
+    // the frames counted, how many of them allocated at all, and the most any one allocated
+    unsigned int Frames() const { return frames; }
+    unsigned int AllocatingFrames() const { return allocatingFrames; }
+    uint64_t MaxFrameAllocations() const { return maxFrameAllocations; }
+
+    // allocations per frame and bytes per subsystem, on stdout
+    void Print();
+
+    // for the operator new replacement
+    void Count(size_t bytes);
+
+private:
+    AllocTracker() = default;
+    AllocTracker(const AllocTracker &) = delete;
+    AllocTracker &operator=(const AllocTracker &) = delete;
+
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> allocations[ALLOC_SUBSYSTEM_COUNT] = {};
+    std::atomic<uint64_t> bytes[ALLOC_SUBSYSTEM_COUNT] = {};
+
+    // by every thread, since the current frame began
+    std::atomic<bool> inFrame{false};
+    std::atomic<uint64_t> frameAllocations{0};
+    std::atomic<uint64_t> frameBytes{0};
+
+    // only touched by the frame loop's thread
+    unsigned int frames = 0;
+    unsigned int allocatingFrames = 0;
+    uint64_t frameAllocationsTotal = 0;
+    uint64_t frameBytesTotal = 0;
+    uint64_t lastFrameAllocations = 0;
+    uint64_t maxFrameAllocations = 0;
+    unsigned int maxFrame = 0;
+    // ~0u while the assertion is off
+    unsigned int assertFrom = ~0u;
+};
+
+// counts the calling thread's allocations in the rest of the enclosing scope under subsystem
+class AllocScope {
+public:
+    explicit AllocScope(AllocSubsystem subsystem);
+    ~AllocScope();
+
+    AllocScope(const AllocScope &) = delete;
+    AllocScope &operator=(const AllocScope &) = delete;
+
+private:
+    AllocSubsystem previous;
+};
+
+#ifdef BLOB_SEA_PROFILE
+// ALLOC_SCOPE(ALLOC_TEXTURES) counts the thread's allocations in the rest of the enclosing scope as texture ones
+#define ALLOC_SCOPE(subsystem) AllocScope PROFILE_CONCAT(allocScope, __LINE__)(subsystem)
+#else
+#define ALLOC_SCOPE(subsystem) ((void)0)
+#endif
+
+#endif //OPENGL_PRACTICE_ALLOC_TRACKER_H
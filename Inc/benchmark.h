@@ -0,0 +1,75 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_BENCHMARK_H
+#define OPENGL_PRACTICE_BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+// how a benchmark is run: warmed up for warmupMs, then timed over repetitions samples of about sampleMs each
+struct BenchmarkOptions {
+    double warmupMs = 100.0;
+    unsigned int repetitions = 101;
+    double sampleMs = 5.0;
+};
+
+// time per operation of a benchmark, over its samples
+struct BenchmarkResult {
+    std::string name;
+    // operations per sample (calibrated during warmup) and samples taken
+    size_t operations = 0;
+    unsigned int samples = 0;
+    double medianNs = 0.0;
+    double p99Ns = 0.0;
+    double minNs = 0.0;
+    double meanNs = 0.0;
+    // median absolute deviation from the median, how noisy the samples were
+    double madNs = 0.0;
+};
+
+// The body of a benchmark runs the measured operation the given number of times. Taking the count instead of being
+// called once per operation keeps the call overhead out of the timings of the small ones.
+typedef std::function<void(size_t operations)> BenchmarkBody;
+
+// Runs body until warmupMs has passed, doubling the operations per call until a call takes about sampleMs, then times
+// repetitions calls of that many operations. The median and p99 are of the per operation time of each sample, so the
+// occasional interrupted sample shows up in p99 and not in the median.
+BenchmarkResult RunBenchmark(const std::string &name, const BenchmarkBody &body, const BenchmarkOptions &options);
+
+// keeps the compiler from optimizing away a result that's never used otherwise
+template<typename T>
+inline void KeepValue(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &value;
+#endif
+}
+
+// writes the results as {"benchmarks": [{"name": ..., "median_ns": ..., ...}, ...]}, one benchmark per line
+bool WriteBenchmarkJson(const std::string &path, const std::vector<BenchmarkResult> &results);
+
+// reads back what WriteBenchmarkJson wrote (name and times), to compare against. Returns false if the file can't be read
+bool ReadBenchmarkJson(const std::string &path, std::vector<BenchmarkResult> &results);
+
+// a benchmark whose median got slower than in the baseline by more than the threshold
+struct BenchmarkRegression {
+    std::string name;
+    double baselineNs = 0.0;
+    double currentNs = 0.0;
+    // current / baseline
+    double ratio = 1.0;
+};
+
+// compares the medians of the benchmarks both have. A slowdown counts when it's over threshold (0.1 is 10%) and also
+// over the noise of both runs (their median absolute deviations), so a noisy benchmark doesn't flag on its own
+std::vector<BenchmarkRegression> CompareBenchmarks(const std::vector<BenchmarkResult> &baseline,
+                                                   const std::vector<BenchmarkResult> &current, double threshold);
+
+#endif //OPENGL_PRACTICE_BENCHMARK_H
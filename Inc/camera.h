@@ -9,6 +9,8 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <frustum.h>
+
 #include <vector>
 
 enum Camera_Movement {
@@ -25,8 +27,14 @@ const float SPEED       =  7.5f;
 const float SENSITIVITY =  0.15f;
 const float ZOOM        =  45.0f;
 const float ZOOM_SPEED  =  3.5f;
+const float NEAR_PLANE  =  0.1f;
+const float FAR_PLANE   =  100.0f;
 
 
+// The view, projection and view-projection matrices (and their inverses, and the frustum) are cached: every getter
+// first compares the attributes they were built from with the current ones, and only rebuilds what changed, so the
+// attributes can still be written directly. Version() changes whenever any of them is rebuilt, which lets users
+// (uniform uploads, culling) skip their work on frames where the camera didn't move.
 class Camera {
 public:
     // camera Attributes
@@ -51,7 +59,28 @@ public:
     Camera(float posX, float posY, float posZ, float upX, float upY, float upZ, float yaw, float pitch);
 
     // returns the view matrix calculated using Euler Angles and the LookAt Matrix
-    glm::mat4 GetViewMatrix();
+    const glm::mat4 &GetViewMatrix();
+
+    // perspective projection with Zoom as the vertical field of view and the framebuffer's aspect ratio
+    const glm::mat4 &GetProjectionMatrix();
+    // projection * view
+    const glm::mat4 &GetViewProjectionMatrix();
+    const glm::mat4 &GetInverseViewMatrix();
+    const glm::mat4 &GetInverseProjectionMatrix();
+    const glm::mat4 &GetInverseViewProjectionMatrix();
+
+    // the world space view frustum
+    const Frustum &GetFrustum();
+
+    // changes every time the matrices are rebuilt (never 0 once they've been built)
+    unsigned int Version();
+
+    // the framebuffer size sets the aspect ratio; call it from the framebuffer size callback. Sizes of 0 (minimized) are ignored.
+    void SetViewport(int width, int height);
+    int ViewportWidth() const { return viewportWidth; }
+    int ViewportHeight() const { return viewportHeight; }
+
+    void SetClipPlanes(float nearPlane, float farPlane);
 
     // processes input received from any keyboard-like input system. Accepts input parameter in the form of camera defined ENUM (to abstract it from windowing systems)
     void ProcessKeyboard(Camera_Movement direction, float deltaTime);
@@ -61,9 +90,30 @@ public:
     // processes input received from a mouse scroll-wheel event. Only requires input on the vertical wheel-axis
     void ProcessMouseScroll(float yoffset);
 
+    // puts the camera at a position with the given angles and field of view (recorded or authored camera paths)
+    void SetPose(const glm::vec3 &position, float yaw, float pitch, float zoom);
+
 private:
     // calculates the front vector from the Camera's (updated) Euler Angles
     void updateCameraVectors();
+
+    // rebuilds whichever matrices are out of date
+    void updateMatrices();
+
+    int viewportWidth = 800;
+    int viewportHeight = 600;
+    float nearPlane = NEAR_PLANE;
+    float farPlane = FAR_PLANE;
+
+    // what the cached matrices were built from
+    bool built = false;
+    glm::vec3 builtPosition, builtFront, builtUp;
+    float builtZoom = 0.0f, builtAspect = 0.0f, builtNear = 0.0f, builtFar = 0.0f;
+
+    glm::mat4 view, projection, viewProjection;
+    glm::mat4 inverseView, inverseProjection, inverseViewProjection;
+    Frustum frustum;
+    unsigned int version = 0;
 };
 
 #endif //OPENGL_PRACTICE_CAMERA_H
@@ -0,0 +1,41 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_CAMERA_PATH_H
+#define OPENGL_PRACTICE_CAMERA_PATH_H
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+// where the camera is and where it looks at one point of a path
+struct CameraKey {
+    float time = 0.0f;
+    glm::vec3 position = glm::vec3(0.0f);
+    float yaw = 0.0f, pitch = 0.0f, zoom = 45.0f;
+};
+
+// An authored camera path: keyframes read from a text file, one per line as
+//   time x y z yaw pitch [zoom]
+// with times in seconds, increasing, and angles in degrees like Camera's (lines starting with # are comments).
+// Between keyframes the camera follows a Catmull-Rom spline, which goes through every keyframe and keeps the
+// motion smooth across them. Sampled at fixed time steps, every run renders exactly the same views.
+class CameraPath {
+public:
+    // false (with a message) if the file can't be read or a line isn't a keyframe
+    bool Load(const std::string &path);
+
+    bool Empty() const { return keys.empty(); }
+    // time of the last keyframe
+    float Duration() const { return keys.empty() ? 0.0f : keys.back().time; }
+
+    // the camera at time t, held at the first and last keyframe outside the path
+    CameraKey Sample(float t) const;
+
+private:
+    std::vector<CameraKey> keys;
+};
+
+#endif //OPENGL_PRACTICE_CAMERA_PATH_H
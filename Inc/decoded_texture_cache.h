@@ -0,0 +1,43 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_DECODED_TEXTURE_CACHE_H
+#define OPENGL_PRACTICE_DECODED_TEXTURE_CACHE_H
+
+#include <ktx.h>
+
+#include <cstddef>
+#include <string>
+
+// On-disk cache of decoded, already mipmapped textures, so warm starts skip decoding and filtering altogether.
+// Entries are uncompressed KTX files named after a hash of the source file's bytes and the load parameters:
+// an edited source simply misses, and copies or renames of a file share one entry. TextureFromFile maps hits
+// (see MappedFile) and uploads straight from the mapping.
+class DecodedTextureCache {
+public:
+    // returns the single instance shared by the whole process
+    static DecodedTextureCache &Instance();
+
+    // where entries live, relative to the working directory unless absolute. "" turns the cache off.
+    void SetDirectory(const std::string &directory);
+    const std::string &Directory() const { return directory; }
+    bool Enabled() const { return !directory.empty(); }
+
+    // the entry a source image (its file contents) loaded with these parameters maps to, "" when disabled.
+    // The entry doesn't have to exist yet.
+    std::string EntryPath(const unsigned char *source, size_t size, bool gamma, int channels) const;
+
+    // writes an entry, through a temporary file so a crash or a concurrent launch never sees a torn one
+    bool Store(const std::string &entryPath, const KtxImage &image);
+
+private:
+    DecodedTextureCache() = default;
+    DecodedTextureCache(const DecodedTextureCache &) = delete;
+    DecodedTextureCache &operator=(const DecodedTextureCache &) = delete;
+
+    std::string directory = "texture_cache";
+    bool directoryCreated = false;
+};
+
+#endif //OPENGL_PRACTICE_DECODED_TEXTURE_CACHE_H
@@ -0,0 +1,40 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_FRAME_HISTOGRAM_H
+#define OPENGL_PRACTICE_FRAME_HISTOGRAM_H
+
+#include <cstdint>
+
+// frame times are counted in buckets growing by the same ratio, this many per doubling (about 4.4% wide each),
+// from FRAME_HISTOGRAM_MIN_MS over FRAME_HISTOGRAM_OCTAVES doublings (up to 4 s, longer frames go in the last one)
+const unsigned int FRAME_HISTOGRAM_BUCKETS_PER_OCTAVE = 16;
+const unsigned int FRAME_HISTOGRAM_OCTAVES = 16;
+const float FRAME_HISTOGRAM_MIN_MS = 1.0f / 16.0f;
+
+// Counts frame times in logarithmic buckets, so any number of frames takes the same little memory and adding one is
+// a few instructions, and gives their percentiles to within a bucket. The longest frame is kept exactly.
+class FrameHistogram {
+public:
+    FrameHistogram() { Reset(); }
+
+    void Add(float ms);
+
+    // the time p (0.5 for the median, 0.99 ...) of the frames took at most: the top of the bucket the frame at that
+    // rank fell in, but never more than Max(). 0 without frames
+    float Percentile(double p) const;
+    float Max() const { return maximum; }
+    uint64_t Count() const { return count; }
+
+    void Reset();
+
+private:
+    static const unsigned int BUCKETS = FRAME_HISTOGRAM_BUCKETS_PER_OCTAVE * FRAME_HISTOGRAM_OCTAVES;
+
+    uint32_t buckets[BUCKETS];
+    uint64_t count;
+    float maximum;
+};
+
+#endif //OPENGL_PRACTICE_FRAME_HISTOGRAM_H
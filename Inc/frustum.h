@@ -0,0 +1,65 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_FRUSTUM_H
+#define OPENGL_PRACTICE_FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// the six planes of a view frustum as (normal, distance): a point p is inside a plane when dot(normal, p) + distance >= 0.
+// Order: left, right, bottom, top, near, far.
+struct Frustum {
+    glm::vec4 planes[6];
+};
+
+// extracts the planes from a projection * view (* model) matrix; with a model matrix in the product the planes end up in
+// that model's object space. normalize makes the plane normals unit length, which sphere tests need (box tests don't).
+Frustum ExtractFrustum(const glm::mat4 &clip, bool normalize = true);
+
+// the same frustum seen from the object space of `model` (for testing a model's untransformed bounds). Planes aren't
+// normalized afterwards, so only use the result for box tests unless the model matrix has no scale.
+Frustum TransformFrustum(const Frustum &frustum, const glm::mat4 &model);
+
+bool SphereInFrustum(const Frustum &frustum, const glm::vec3 &center, float radius);
+bool AabbInFrustum(const Frustum &frustum, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+
+// bounding spheres laid out as separate arrays (structure of arrays), so the culling loops test 4 or 8 at a time
+struct BoundingSpheres {
+    std::vector<float> x, y, z, radius;
+
+    void Add(const glm::vec3 &center, float r);
+    void Clear();
+    size_t Size() const { return x.size(); }
+};
+
+// axis aligned boxes, kept as centers and half extents for the same reason
+struct BoundingBoxes {
+    std::vector<float> centerX, centerY, centerZ;
+    std::vector<float> extentX, extentY, extentZ;
+
+    void Add(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax);
+    void Clear();
+    size_t Size() const { return centerX.size(); }
+};
+
+// the loops CullSpheres and CullBoxes can take; all of them give the same result
+enum CullPath {
+    CULL_SCALAR,
+    CULL_SSE,
+    // falls back to SSE on CPUs without AVX
+    CULL_AVX
+};
+
+// tests every sphere/box against the frustum and writes the indices of the ones at least partly inside, in order,
+// to visible (resized to the number of visible ones, so a vector reused every frame stops allocating).
+// Uses AVX when the CPU has it, SSE otherwise; path picks a narrower loop (e.g. to benchmark them). Boxes are tested
+// conservatively: one that straddles two planes outside a frustum corner can pass.
+void CullSpheres(const Frustum &frustum, const BoundingSpheres &spheres, std::vector<unsigned int> &visible,
+                 CullPath path = CULL_AVX);
+void CullBoxes(const Frustum &frustum, const BoundingBoxes &boxes, std::vector<unsigned int> &visible,
+               CullPath path = CULL_AVX);
+
+#endif //OPENGL_PRACTICE_FRUSTUM_H
@@ -0,0 +1,156 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_GL_CAPTURE_H
+#define OPENGL_PRACTICE_GL_CAPTURE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// A capture file ("BSGL", a version, the size of the default framebuffer) holds one record per GL call: the call's
+// id and the size of what follows (both 32 bit), then its arguments, all 8 byte aligned so arrays can be handed to
+// GL where they are. Pointers into buffer objects are stored as offsets, client memory (texels, buffer data,
+// uniform arrays, shader sources) is copied in. Gen and Create calls store the names GL returned, which the
+// replayer maps to its own. A GLCALL_FRAME record starts each captured frame; what comes before the first one
+// recreates the objects and the state the frames start from.
+enum GlCaptureCall {
+    GLCALL_FRAME = 1,
+    GLCALL_ENABLE,
+    GLCALL_DISABLE,
+    GLCALL_BLEND_FUNC,
+    GLCALL_DEPTH_FUNC,
+    GLCALL_DEPTH_MASK,
+    GLCALL_COLOR_MASK,
+    GLCALL_CULL_FACE,
+    GLCALL_VIEWPORT,
+    GLCALL_SCISSOR,
+    GLCALL_CLEAR_COLOR,
+    GLCALL_CLEAR,
+    GLCALL_DRAW_ARRAYS,
+    GLCALL_DRAW_ELEMENTS,
+    GLCALL_DRAW_ARRAYS_INSTANCED,
+    GLCALL_DRAW_ELEMENTS_INSTANCED,
+    GLCALL_PIXEL_STORE,
+    GLCALL_ACTIVE_TEXTURE,
+    GLCALL_GEN_TEXTURES,
+    GLCALL_DELETE_TEXTURES,
+    GLCALL_BIND_TEXTURE,
+    GLCALL_TEX_PARAMETER_I,
+    GLCALL_TEX_PARAMETER_F,
+    GLCALL_TEX_IMAGE_2D,
+    GLCALL_TEX_SUB_IMAGE_2D,
+    GLCALL_TEX_IMAGE_3D,
+    GLCALL_TEX_SUB_IMAGE_3D,
+    GLCALL_COMPRESSED_TEX_IMAGE_2D,
+    GLCALL_COMPRESSED_TEX_SUB_IMAGE_2D,
+    GLCALL_COMPRESSED_TEX_IMAGE_3D,
+    GLCALL_COMPRESSED_TEX_SUB_IMAGE_3D,
+    GLCALL_GENERATE_MIPMAP,
+    GLCALL_GEN_BUFFERS,
+    GLCALL_DELETE_BUFFERS,
+    GLCALL_BIND_BUFFER,
+    GLCALL_BUFFER_DATA,
+    GLCALL_BUFFER_SUB_DATA,
+    GLCALL_GEN_VERTEX_ARRAYS,
+    GLCALL_DELETE_VERTEX_ARRAYS,
+    GLCALL_BIND_VERTEX_ARRAY,
+    GLCALL_ENABLE_VERTEX_ATTRIB_ARRAY,
+    GLCALL_DISABLE_VERTEX_ATTRIB_ARRAY,
+    GLCALL_VERTEX_ATTRIB_POINTER,
+    GLCALL_VERTEX_ATTRIB_I_POINTER,
+    GLCALL_VERTEX_ATTRIB_DIVISOR,
+    GLCALL_GEN_FRAMEBUFFERS,
+    GLCALL_DELETE_FRAMEBUFFERS,
+    GLCALL_BIND_FRAMEBUFFER,
+    GLCALL_FRAMEBUFFER_TEXTURE_2D,
+    GLCALL_FRAMEBUFFER_RENDERBUFFER,
+    GLCALL_GEN_RENDERBUFFERS,
+    GLCALL_DELETE_RENDERBUFFERS,
+    GLCALL_BIND_RENDERBUFFER,
+    GLCALL_RENDERBUFFER_STORAGE,
+    GLCALL_CREATE_SHADER,
+    GLCALL_SHADER_SOURCE,
+    GLCALL_COMPILE_SHADER,
+    GLCALL_DELETE_SHADER,
+    GLCALL_CREATE_PROGRAM,
+    GLCALL_ATTACH_SHADER,
+    GLCALL_LINK_PROGRAM,
+    GLCALL_USE_PROGRAM,
+    GLCALL_DELETE_PROGRAM,
+    GLCALL_GET_UNIFORM_LOCATION,
+    GLCALL_UNIFORM_1I,
+    GLCALL_UNIFORM_1F,
+    GLCALL_UNIFORM_2F,
+    GLCALL_UNIFORM_3F,
+    GLCALL_UNIFORM_4F,
+    GLCALL_UNIFORM_3FV,
+    GLCALL_UNIFORM_4FV,
+    GLCALL_UNIFORM_MATRIX_3FV,
+    GLCALL_UNIFORM_MATRIX_4FV,
+    GLCALL_GEN_QUERIES,
+    GLCALL_DELETE_QUERIES,
+    GLCALL_BEGIN_QUERY,
+    GLCALL_END_QUERY,
+    GLCALL_QUERY_COUNTER
+};
+
+// how the texels of a texture upload are stored: none (allocation only), copied in, or an offset into the bound
+// pixel unpack buffer
+enum GlCapturePixels {
+    GL_CAPTURE_PIXELS_NONE = 0,
+    GL_CAPTURE_PIXELS_DATA,
+    GL_CAPTURE_PIXELS_OFFSET
+};
+
+const char GL_CAPTURE_MAGIC[4] = {'B', 'S', 'G', 'L'};
+const uint32_t GL_CAPTURE_VERSION = 1;
+
+// Records the GL calls of a run into a capture file for blob_sea_replay (see replay.cpp), which plays the frames in
+// a loop to measure what the driver and the GPU spend on exactly this command stream, without the app around it,
+// and on another driver (llvmpipe against the hardware one) for the same frames.
+// Start swaps glad's function pointers for ones that call GL and record the call, so it has to come right after
+// gladLoadGLLoader, before anything creates GL objects. Frames before the first captured one are recorded without
+// their draws and clears, which keeps their uploads and state changes; the captured frames are recorded whole.
+// Queries and other reads back (glGet*, glReadPixels) aren't recorded, they change nothing the frames draw.
+// Not thread safe: everything is expected to call GL from the thread that owns the context.
+class GlCapture {
+public:
+    static GlCapture &Instance();
+
+    GlCapture(const GlCapture &) = delete;
+    GlCapture &operator=(const GlCapture &) = delete;
+
+    // opens the file and hooks GL. width and height are the default framebuffer's, the replayer sizes its own to
+    // match. Returns false (with a message) if the file can't be written.
+    bool Start(const std::string &path, int width, int height, unsigned int firstFrame, unsigned int frames);
+    bool Capturing() const { return file != nullptr; }
+
+    // call at the start of every frame. After the last captured frame the file is finished and GL unhooked.
+    void BeginFrame();
+
+    // finishes the capture early, with the frames recorded so far
+    void del();
+
+private:
+    friend class GlCaptureRecord;
+
+    GlCapture() = default;
+
+    void write(const uint8_t *data, size_t size);
+    void finish();
+
+    FILE *file = nullptr;
+    std::string path;
+    // records are gathered here and written out in large blocks
+    std::vector<uint8_t> pending;
+    uint64_t written = 0;
+    unsigned int frame = 0;
+    unsigned int firstFrame = 0;
+    unsigned int lastFrame = 0;
+    bool recordDraws = false;
+};
+
+#endif //OPENGL_PRACTICE_GL_CAPTURE_H
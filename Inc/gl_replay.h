@@ -0,0 +1,68 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_GL_REPLAY_H
+#define OPENGL_PRACTICE_GL_REPLAY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Plays back a file written by GlCapture (see gl_capture.h) on the current context. The objects the capture
+// created are created again under whatever names this driver hands out, and the captured names are mapped to
+// them, uniform locations too. The frames can be played any number of times and in any order once the setup (the
+// calls before the first frame) has run; objects a frame creates without deleting pile up over repeated plays.
+class GlReplay {
+public:
+    GlReplay() = default;
+    GlReplay(const GlReplay &) = delete;
+    GlReplay &operator=(const GlReplay &) = delete;
+
+    // reads the whole capture into memory and finds its frames. Returns false (with a message) if it isn't one.
+    bool Load(const std::string &path);
+
+    // the default framebuffer's size when it was captured
+    int Width() const { return width; }
+    int Height() const { return height; }
+    unsigned int Frames() const { return (unsigned int)frames.size(); }
+
+    // what binding framebuffer 0 binds instead, e.g. an OffscreenTarget's when there is no window
+    void SetDefaultFramebuffer(unsigned int framebuffer) { defaultFramebuffer = framebuffer; }
+
+    // the calls before the first frame, once before any PlayFrame
+    void PlaySetup();
+    void PlayFrame(unsigned int frame);
+    // calls the last PlaySetup or PlayFrame made
+    unsigned int Calls() const { return calls; }
+
+    // deletes what the replay created
+    void del();
+
+private:
+    typedef std::unordered_map<unsigned int, unsigned int> NameMap;
+
+    void play(size_t begin, size_t end);
+    unsigned int name(const NameMap &map, unsigned int captured) const;
+    int location(int captured) const;
+
+    // 64 bit words, so the records' 8 byte alignment holds in memory
+    std::vector<uint64_t> storage;
+    size_t size = 0;
+    int width = 0;
+    int height = 0;
+    // byte offsets of the frames' first records, the setup ends where the first frame starts
+    std::vector<size_t> frames;
+    size_t setupBegin = 0;
+    unsigned int calls = 0;
+
+    unsigned int defaultFramebuffer = 0;
+    NameMap buffers, textures, vertexArrays, framebuffers, renderbuffers, queries, shaders, programs;
+    // (captured program << 32 | captured location) to the location here
+    std::unordered_map<uint64_t, int> locations;
+    // the captured name of the program in use, the uniform calls' locations are its
+    unsigned int program = 0;
+};
+
+#endif //OPENGL_PRACTICE_GL_REPLAY_H
@@ -0,0 +1,97 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_GPU_PROFILER_H
+#define OPENGL_PRACTICE_GPU_PROFILER_H
+
+#include <glad/glad.h>
+#include <profiler.h>
+
+#include <vector>
+
+// frames of timer queries in flight. A frame's results are read when its queries come round again, this many frames
+// later, by which time the GPU (or llvmpipe's threads) has long finished it, so reading never stalls
+const unsigned int GPU_PROFILE_FRAMES = 4;
+
+// Times GPU work with GL_TIMESTAMP queries (a timestamp where a zone begins and one where it ends, so zones nest)
+// and adds the results to the Profiler's GPU track, lined up with the CPU zones. With a software GL (llvmpipe) this
+// is the time the rasterizer threads spent on the zone's commands, which the CPU zones of the main thread don't show.
+// Queries come from a pool per frame that is reused once the frame's results were read; a frame whose results still
+// aren't there by then is dropped rather than waited for. Only use it from the thread owning the GL context.
+class GpuProfiler {
+public:
+    // returns the single instance shared by the whole process
+    static GpuProfiler &Instance();
+
+    // starts a frame: collects the frame issued GPU_PROFILE_FRAMES frames ago and reuses its queries. True when that
+    // frame's results came in (LastFrameMs is then its time), false when there was none or it was dropped
+    bool BeginFrame();
+
+    // GPU zones, see PROFILE_GPU_ZONE. Zones begun before the first BeginFrame are ignored
+    void Begin(const char *name);
+    void End();
+
+    // waits for every frame still in flight and records it, e.g. before writing a trace
+    void Flush();
+
+    // GPU time of the last collected frame (its outermost zones added up), in milliseconds
+    double LastFrameMs() const { return lastFrameMs; }
+    // frames whose results weren't ready when their queries were due for reuse
+    unsigned int DroppedFrames() const { return dropped; }
+
+    void del();
+
+private:
+    GpuProfiler() = default;
+    GpuProfiler(const GpuProfiler &) = delete;
+    GpuProfiler &operator=(const GpuProfiler &) = delete;
+
+    struct Zone {
+        const char *name;
+        unsigned int beginQuery;
+        unsigned int endQuery;
+        unsigned int depth;
+    };
+    struct Frame {
+        std::vector<unsigned int> queries;
+        unsigned int used = 0;
+        std::vector<Zone> zones;
+    };
+
+    bool init();
+    unsigned int nextQuery(Frame &frame);
+    // records a frame's zones and empties it; without wait a frame the GPU hasn't finished is dropped. True when
+    // the frame had zones and their results were read
+    bool collect(Frame &frame, bool wait);
+
+    Frame frames[GPU_PROFILE_FRAMES];
+    unsigned int current = 0;
+    // zones of the current frame that are still open (indices into its zones), ~0u for ignored ones
+    std::vector<unsigned int> open;
+    // 0 until the first BeginFrame, 1 once the queries work, -1 if the context has no timer queries
+    int state = 0;
+    double lastFrameMs = 0.0;
+    unsigned int dropped = 0;
+};
+
+// times the GPU work issued in the scope it's declared in
+class GpuZone {
+public:
+    explicit GpuZone(const char *name) { GpuProfiler::Instance().Begin(name); }
+    ~GpuZone() { GpuProfiler::Instance().End(); }
+
+    GpuZone(const GpuZone &) = delete;
+    GpuZone &operator=(const GpuZone &) = delete;
+};
+
+#ifdef BLOB_SEA_PROFILE
+// PROFILE_GPU_ZONE("name") times the GL commands issued in the rest of the enclosing scope
+#define PROFILE_GPU_ZONE(name) GpuZone PROFILE_CONCAT(gpuZone, __LINE__)(name)
+#define PROFILE_GPU_FRAME() GpuProfiler::Instance().BeginFrame()
+#else
+#define PROFILE_GPU_ZONE(name) ((void)0)
+#define PROFILE_GPU_FRAME() ((void)0)
+#endif
+
+#endif //OPENGL_PRACTICE_GPU_PROFILER_H
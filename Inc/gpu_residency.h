@@ -0,0 +1,139 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_GPU_RESIDENCY_H
+#define OPENGL_PRACTICE_GPU_RESIDENCY_H
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <functional>
+#include <set>
+#include <unordered_map>
+
+enum GpuResourceKind {
+    GPU_BUFFER = 0,
+    GPU_TEXTURE = 1,
+    GPU_RESOURCE_KINDS
+};
+
+// resources drawn during the current frame or this many frames before it are the working set, which is never evicted
+const unsigned int RESIDENCY_WORKING_SET_FRAMES = 1;
+
+// releases a buffer's storage (respecified with size 0), keeping its name valid
+void EvictBuffer(unsigned int buffer);
+// releases every level of a 2D texture (respecified as 0x0), keeping its name and parameters
+void EvictTexture(unsigned int textureID);
+// bytes of storage a 2D texture currently holds in levels [GL_TEXTURE_BASE_LEVEL, GL_TEXTURE_MAX_LEVEL], asked from GL
+size_t TextureBytes(unsigned int textureID);
+
+// Accounts for the GPU memory of every buffer and texture the renderer creates, and keeps it under a hard cap.
+// Owners Track their GL objects with the size of their storage and Touch them whenever they're drawn; once the
+// budget is exceeded the resources that were drawn longest ago are evicted: their storage is released but their
+// GL names stay valid, so nothing holding an id has to know. The next Touch of an evicted resource reloads it,
+// either through the reload function it was tracked with or, if it has none, by telling the owner to re-upload.
+// Resources tracked without an evict function (e.g. streamed textures, which the TextureStreamer manages itself)
+// are pinned: they count against the budget but are never evicted here.
+// Like every other GL object in the project it must only be used from the thread owning the context.
+class GpuResidency {
+public:
+    // returns the single instance shared by the whole process
+    static GpuResidency &Instance();
+
+    // hard cap on resident bytes, 0 (the default) only accounts without ever evicting. Takes effect at the next EndFrame.
+    void SetBudget(size_t bytes) { budget = bytes; }
+    size_t Budget() const { return budget; }
+
+    // bytes resident right now, in total or of one kind
+    size_t UsedBytes() const { return usedBytes[GPU_BUFFER] + usedBytes[GPU_TEXTURE]; }
+    size_t UsedBytes(GpuResourceKind kind) const { return usedBytes[kind]; }
+    // the most that was ever resident at once, since the start or the last ResetHighWater
+    size_t HighWaterBytes() const { return highWaterBytes; }
+    void ResetHighWater() { highWaterBytes = UsedBytes(); }
+    // bytes tracked but currently evicted
+    size_t EvictedBytes() const { return evictedBytes; }
+    // how many evictions and reloads happened so far
+    unsigned int Evictions() const { return evictions; }
+    unsigned int Reloads() const { return reloads; }
+
+    // starts accounting for a GL object whose storage was just allocated, then evicts other resources if that
+    // went over budget. evict releases the storage (see EvictBuffer and EvictTexture), reload brings it back and
+    // returns false if it couldn't; without evict the object is pinned.
+    void Track(GpuResourceKind kind, unsigned int name, size_t bytes,
+               std::function<void()> evict = nullptr, std::function<bool()> reload = nullptr);
+    // the object's storage changed size (only meaningful while it's resident)
+    void Resize(GpuResourceKind kind, unsigned int name, size_t bytes);
+    // stops accounting for the object, call it right before deleting it. Unknown objects are ignored.
+    void Untrack(GpuResourceKind kind, unsigned int name);
+
+    // records that the object is drawn this frame. If it had been evicted, room is made for it and it's reloaded;
+    // returns false if the owner has to re-upload it itself (it was tracked without a reload function).
+    bool Touch(GpuResourceKind kind, unsigned int name);
+
+    // evicts resources until the budget can hold `bytes` more, coldest first, never touching the working set.
+    // Returns false if that's not possible.
+    bool Reserve(size_t bytes);
+
+    // brings usage back under the budget and starts the next frame; call once per frame, after drawing
+    void EndFrame();
+
+    unsigned int Frame() const { return frame; }
+
+private:
+    struct Resource {
+        GpuResourceKind kind;
+        unsigned int name;
+        size_t bytes;
+        bool resident;
+        unsigned int lastUsed;          // frame of the last Touch (or Track)
+        std::function<void()> evict;
+        std::function<bool()> reload;
+    };
+
+    GpuResidency() = default;
+    GpuResidency(const GpuResidency &) = delete;
+    GpuResidency &operator=(const GpuResidency &) = delete;
+
+    // where an evictable resident resource is in the eviction order: oldest first, and the larger one of two equally
+    // old resources so fewer evictions free the same space
+    struct Recency {
+        unsigned int lastUsed;
+        size_t bytes;
+        unsigned long long key;
+
+        bool operator<(const Recency &other) const
+        {
+            if (lastUsed != other.lastUsed)
+                return lastUsed < other.lastUsed;
+            if (bytes != other.bytes)
+                return bytes > other.bytes;
+            return key < other.key;
+        }
+    };
+
+    static unsigned long long key(GpuResourceKind kind, unsigned int name) { return ((unsigned long long)kind << 32) | name; }
+    static Recency recency(const Resource &resource) { return {resource.lastUsed, resource.bytes, key(resource.kind, resource.name)}; }
+    // adds the resource to / removes it from the eviction order, if it belongs there (resident and evictable). Call
+    // unlist before changing its lastUsed, bytes or resident and list after
+    void list(const Resource &resource);
+    void unlist(const Resource &resource);
+    // least recently used resource outside the working set that can be evicted, or nullptr
+    Resource *pickVictim();
+    void evictResource(Resource &resource);
+    void addUsage(GpuResourceKind kind, size_t bytes);
+
+    std::unordered_map<unsigned long long, Resource> resources;
+    // the evictable resident resources by age, so picking a victim doesn't have to look at every resource
+    std::set<Recency> evictionOrder;
+    size_t budget = 0;
+    size_t usedBytes[GPU_RESOURCE_KINDS] = {0, 0};
+    size_t highWaterBytes = 0;
+    size_t evictedBytes = 0;
+    unsigned int evictions = 0;
+    unsigned int reloads = 0;
+    unsigned int frame = 0;
+    bool warnedWorkingSet = false;
+};
+
+#endif //OPENGL_PRACTICE_GPU_RESIDENCY_H
@@ -0,0 +1,64 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_HEADLESS_H
+#define OPENGL_PRACTICE_HEADLESS_H
+
+#include <glad/glad.h>
+
+#include <string>
+
+// An OpenGL 3.3 core context that needs neither a window nor a display server, for build machines and CI.
+// It's created through EGL on Mesa's surfaceless platform (which software rendering with llvmpipe supports),
+// falling back to EGL's default display. There is no default framebuffer, draw into an OffscreenTarget.
+// EGL support is only compiled in when the project is configured with -DBLOB_SEA_HEADLESS=ON.
+class HeadlessContext {
+public:
+    HeadlessContext() = default;
+    HeadlessContext(const HeadlessContext &) = delete;
+    HeadlessContext &operator=(const HeadlessContext &) = delete;
+
+    // creates the context and makes it current on this thread. Returns false (and prints why) on failure.
+    bool Create();
+
+    // for gladLoadGLLoader, once the context is current
+    static void *GetProcAddress(const char *name);
+
+    // the GL_RENDERER string, e.g. "llvmpipe (LLVM 15.0.7, 256 bits)"
+    std::string Renderer() const;
+
+    void del();
+
+private:
+    // EGLDisplay and EGLContext, kept opaque so EGL's headers stay out of everything including this one
+    void *display = nullptr;
+    void *context = nullptr;
+};
+
+// A framebuffer object with a colour and a depth renderbuffer, the render target of the headless mode.
+class OffscreenTarget {
+public:
+    // creates the framebuffer and binds it. Returns false if it isn't complete.
+    bool Create(int width, int height);
+
+    void Bind() const;
+
+    unsigned int Framebuffer() const { return framebuffer; }
+    int Width() const { return width; }
+    int Height() const { return height; }
+
+    // reads the colour buffer back and writes it as a binary PPM (top row first), for comparing frames between runs
+    bool WritePpm(const std::string &path) const;
+
+    void del();
+
+private:
+    unsigned int framebuffer = 0;
+    unsigned int colour = 0;
+    unsigned int depth = 0;
+    int width = 0;
+    int height = 0;
+};
+
+#endif //OPENGL_PRACTICE_HEADLESS_H
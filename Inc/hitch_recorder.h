@@ -0,0 +1,67 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_HITCH_RECORDER_H
+#define OPENGL_PRACTICE_HITCH_RECORDER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// The flight recorder for hitches: the Profiler's rings already hold the last zones of every thread
+// (PROFILE_RING_EVENTS each), so whenever a frame takes longer than the threshold the zones of the last
+// window are written out as a Chrome trace, <prefix>_0001.json, <prefix>_0002.json ..., for diagnosing a rare hitch
+// after the fact. The trace is written from a thread of its own so the dump isn't another hitch, and hitches within
+// a window of the last dump are only logged, so a stretch of slow frames writes one trace rather than one each.
+// A thread with many small zones (the stress scene's per mesh ones) can go through its ring in less than the window;
+// the trace then marks where its zones start and the dump says how much of the window it covers. The writer thread
+// is started by Configure and waits for dumps, so a hitch allocates nothing in the frame loop (see --alloc-assert).
+// Zones are only recorded when the project is configured with -DBLOB_SEA_PROFILE=ON (cheap enough to leave on);
+// without them, hitches are only logged.
+class HitchRecorder {
+public:
+    HitchRecorder() = default;
+    HitchRecorder(const HitchRecorder &) = delete;
+    HitchRecorder &operator=(const HitchRecorder &) = delete;
+    ~HitchRecorder() { del(); }
+
+    // frames longer than thresholdMs are hitches (0 turns the recorder off). Starts the writer thread when on
+    void Configure(float thresholdMs, float windowSeconds, const std::string &prefix);
+    bool Enabled() const { return thresholdMs > 0.0f; }
+
+    // call once per frame with the last complete frame's time, e.g. RenderStats::LastFrameMs
+    void FrameEnded(float ms);
+
+    unsigned int Hitches() const { return hitches; }
+    unsigned int Dumps() const { return dumps; }
+
+    // waits for a trace still being written and ends the writer thread
+    void del();
+
+private:
+    float thresholdMs = 0.0f;
+    float windowSeconds = 5.0f;
+    std::string prefix = "hitch";
+
+    unsigned int frames = 0;
+    unsigned int hitches = 0;
+    unsigned int dumps = 0;
+    std::chrono::steady_clock::time_point lastDump;
+
+    // waits for dumps until del(), so FrameEnded only has to hand one over
+    void writeDumps();
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable wake;
+    // the dump the writer thread is to write next, handed over under mutex
+    bool dumpPending = false;
+    bool stopping = false;
+    char dumpPath[512] = {};
+    uint64_t dumpSince = 0;
+};
+
+#endif //OPENGL_PRACTICE_HITCH_RECORDER_H
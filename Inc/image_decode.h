@@ -0,0 +1,22 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_IMAGE_DECODE_H
+#define OPENGL_PRACTICE_IMAGE_DECODE_H
+
+#include <string>
+
+// stbi_load, except that the file is read into memory first: stb_image only splits a JPEG at its restart
+// markers when it decodes from memory. free the result with stbi_image_free. (TextureFromFile decodes from its
+// mapping of the source instead.)
+unsigned char *DecodeImageFile(const std::string &path, int *width, int *height, int *components, int channels);
+
+// number of threads a single JPEG with restart markers is decoded on, 0 uses every hardware thread and
+// 1 (the default) decodes serially
+void SetImageDecodeThreads(int threads);
+
+// restart interval (in MCUs) of a JPEG file, 0 if it has none, -1 if it isn't a readable JPEG
+int JpegRestartInterval(const std::string &path);
+
+#endif //OPENGL_PRACTICE_IMAGE_DECODE_H
@@ -0,0 +1,88 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_INPUT_LOG_H
+#define OPENGL_PRACTICE_INPUT_LOG_H
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+// the keys that move the camera and the blob, as bits of FrameInput::keys
+enum InputKey {
+    INPUT_FORWARD = 1 << 0,
+    INPUT_BACKWARD = 1 << 1,
+    INPUT_LEFT = 1 << 2,
+    INPUT_RIGHT = 1 << 3,
+    INPUT_BLOB_LEFT = 1 << 4,
+    INPUT_BLOB_RIGHT = 1 << 5,
+    INPUT_BLOB_UP = 1 << 6,
+    INPUT_BLOB_DOWN = 1 << 7
+};
+
+// everything that moved the camera or the blob during one frame, and the time step it was applied with
+struct FrameInput {
+    float deltaTime = 0.0f;
+    uint8_t keys = 0;
+    // mouse movement (already turned into the camera's x and y offsets) and scrolling, added up over the frame
+    float mouseX = 0.0f, mouseY = 0.0f;
+    float scroll = 0.0f;
+};
+
+// where the camera and the blob were when a recording started, so playing it back starts from the same place
+struct InputStart {
+    glm::vec3 position = glm::vec3(0.0f);
+    float yaw = 0.0f, pitch = 0.0f, zoom = 0.0f;
+    float blobX = 0.0f, blobZ = 0.0f;
+};
+
+// Writes a FrameInput per frame to a compact binary log: "BSIN", a version, the InputStart, then per frame the key
+// bits, a byte saying whether mouse movement and scrolling follow, the time step and only the values that were
+// there, so a frame without mouse input takes 6 bytes. Values are written in the machine's byte order.
+class InputRecorder {
+public:
+    InputRecorder() = default;
+    InputRecorder(const InputRecorder &) = delete;
+    InputRecorder &operator=(const InputRecorder &) = delete;
+    ~InputRecorder() { Close(); }
+
+    bool Open(const std::string &path, const InputStart &start);
+    bool IsOpen() const { return file != nullptr; }
+    void Add(const FrameInput &input);
+    unsigned int Frames() const { return frames; }
+    void Close();
+
+private:
+    FILE *file = nullptr;
+    unsigned int frames = 0;
+};
+
+// Reads an InputRecorder log back a frame at a time. Playing it back applies each frame's input with its recorded
+// time step, one logged frame per rendered frame however long rendering takes, so the camera goes through exactly
+// the views of the recording and two builds can be compared frame by frame.
+class InputPlayback {
+public:
+    InputPlayback() = default;
+    InputPlayback(const InputPlayback &) = delete;
+    InputPlayback &operator=(const InputPlayback &) = delete;
+    ~InputPlayback() { Close(); }
+
+    // opens the log and reads its start, false (with a message) if it isn't one
+    bool Open(const std::string &path);
+    bool IsOpen() const { return file != nullptr; }
+    const InputStart &Start() const { return start; }
+    // the next frame's input, false at the end of the log
+    bool Next(FrameInput &input);
+    unsigned int Frames() const { return frames; }
+    void Close();
+
+private:
+    FILE *file = nullptr;
+    InputStart start;
+    unsigned int frames = 0;
+};
+
+#endif //OPENGL_PRACTICE_INPUT_LOG_H
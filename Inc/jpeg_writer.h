@@ -0,0 +1,25 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_JPEG_WRITER_H
+#define OPENGL_PRACTICE_JPEG_WRITER_H
+
+#include <string>
+#include <vector>
+
+struct JpegEncodeOptions {
+    int quality = 95;           // 1..100, IJG scaling of the standard quantization tables
+    bool subsample = true;      // 4:2:0 chroma, otherwise 4:4:4
+    int restartInterval = -1;   // MCUs between restart markers, -1 puts one at the end of every MCU row, 0 none
+};
+
+// baseline (sequential, huffman coded) JPEG encoder. 1 and 2 channel images are written as greyscale, 3 and 4
+// channel ones as YCbCr; alpha is dropped. the restart markers are what lets the loader decode one image on
+// several threads.
+std::vector<unsigned char> EncodeJpeg(const unsigned char *pixels, int width, int height, int channels,
+                                      const JpegEncodeOptions &options);
+bool WriteJpeg(const std::string &path, const unsigned char *pixels, int width, int height, int channels,
+               const JpegEncodeOptions &options);
+
+#endif //OPENGL_PRACTICE_JPEG_WRITER_H
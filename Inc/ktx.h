@@ -0,0 +1,75 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_KTX_H
+#define OPENGL_PRACTICE_KTX_H
+
+#include <glad/glad.h>
+
+#include <string>
+#include <vector>
+
+// A 2D texture with its whole mip chain, as stored in a KTX 1.1 file. Compressed images keep glFormat/glType at 0,
+// uncompressed ones store rows padded to 4 bytes (GL's default unpack alignment), so every level can be handed to
+// glCompressedTexImage2D/glTexImage2D as is.
+struct KtxImage {
+    GLenum glInternalFormat = 0;
+    GLenum glBaseInternalFormat = 0;
+    GLenum glFormat = 0;
+    GLenum glType = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<std::vector<unsigned char>> levels;     // level 0 (full size) first
+
+    bool compressed() const { return glFormat == 0; }
+};
+
+// where a level's data lives inside a KTX file
+struct KtxLevelRange {
+    size_t offset = 0;
+    unsigned int size = 0;
+};
+
+inline int KtxLevelWidth(const KtxImage &image, int level) { return (image.width >> level) > 0 ? (image.width >> level) : 1; }
+inline int KtxLevelHeight(const KtxImage &image, int level) { return (image.height >> level) > 0 ? (image.height >> level) : 1; }
+
+// the cooked file a source image is looked up under, e.g. "diffuse.jpg" -> "diffuse.jpg.ktx"
+std::string CookedTexturePath(const std::string &sourcePath);
+
+// true if the cooked/cached file exists and is at least as new as its source image
+bool IsCookedTextureFresh(const std::string &cookedPath, const std::string &sourcePath);
+
+// reads/writes a KTX file. Both return false (and print why) on failure.
+bool ReadKtx(const std::string &filename, KtxImage &image);
+bool WriteKtx(const std::string &filename, const KtxImage &image);
+
+// reads only the header and where every level lives in the file (image.levels stays empty), so that levels can be
+// streamed in one at a time with ReadKtxLevel
+bool ReadKtxLayout(const std::string &filename, KtxImage &image, std::vector<KtxLevelRange> &ranges);
+bool ReadKtxLevel(const std::string &filename, const KtxLevelRange &range, std::vector<unsigned char> &data);
+
+// the same layout parsed from a KTX file already in memory (e.g. mapped), offsets are relative to data.
+// filename is only used in error messages.
+bool ParseKtxLayout(const unsigned char *data, size_t size, const std::string &filename, KtxImage &image,
+                    std::vector<KtxLevelRange> &ranges);
+
+// switches the image's internal format to the sRGB (srgb) or linear variant of the same format, so that a texture
+// cooked for one color space samples right when loaded for the other. The blocks or pixels are the same either way,
+// only how the GPU decodes them changes. Returns false if the format has no sRGB variant (BC4/BC5): the caller has
+// to decode the source instead. R8 and RG8 are what decoding gives for those anyway, and match either way.
+bool MatchKtxColorSpace(KtxImage &image, bool srgb);
+
+// uploads a single level into the texture currently bound to GL_TEXTURE_2D
+void UploadKtxLevel(const KtxImage &image, int level, const unsigned char *data, unsigned int size);
+
+// uploads every level from firstLevel on into the (already generated) texture and sets up mipmapped filtering.
+// Skipped levels take no memory, GL_TEXTURE_BASE_LEVEL starts sampling at firstLevel (see TextureQuality).
+// Returns false if the context can't sample the image's format.
+bool UploadKtx(const KtxImage &image, unsigned int textureID, int firstLevel = 0);
+
+// as above, but straight from a KTX file in memory, laid out as returned by ParseKtxLayout
+bool UploadKtx(const KtxImage &layout, const unsigned char *data, const std::vector<KtxLevelRange> &ranges, unsigned int textureID,
+               int firstLevel = 0);
+
+#endif //OPENGL_PRACTICE_KTX_H
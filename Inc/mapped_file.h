@@ -0,0 +1,37 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_MAPPED_FILE_H
+#define OPENGL_PRACTICE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// a whole file mapped read-only into memory (mmap, MapViewOfFile on Windows). pages are only read in when touched
+// and are shared with the OS file cache, so nothing is copied onto the heap.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // maps the file, replacing any previous mapping. empty files can't be mapped and fail like missing ones.
+    bool Open(const std::string &path);
+    void Close();
+
+    bool IsOpen() const { return data != nullptr; }
+    const unsigned char *Data() const { return data; }
+    size_t Size() const { return size; }
+
+private:
+    const unsigned char *data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void *file = nullptr;
+    void *mapping = nullptr;
+#endif
+};
+
+#endif //OPENGL_PRACTICE_MAPPED_FILE_H
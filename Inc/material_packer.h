@@ -0,0 +1,47 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_MATERIAL_PACKER_H
+#define OPENGL_PRACTICE_MATERIAL_PACKER_H
+
+#include <glad/glad.h>
+
+#include <mesh.h>
+
+#include <unordered_map>
+#include <vector>
+
+// Packs 2D textures into GL_TEXTURE_2D_ARRAYs so that a whole set of meshes can be drawn without binding textures
+// in between: textures with the same size, format and mip count become layers of one array, every array is bound
+// to its own texture unit once (Bind), and each mesh only sets which unit/layer its samplers read.
+// Shaders drawn with a packer declare the usual "texture_diffuseN" (etc.) samplers as sampler2DArray and read the
+// layer from an int uniform of the same name with a "_layer" suffix, e.g. texture(texture_diffuse1, vec3(uv, texture_diffuse1_layer)).
+// Textures are copied into the arrays, the packer doesn't take ownership of the 2D originals.
+class MaterialPacker {
+public:
+    // queues a texture for packing, duplicates are ignored
+    void Add(unsigned int textureID);
+
+    // builds the arrays out of every queued texture. Textures added afterwards need another Pack.
+    void Pack();
+
+    // where a texture was packed, {0, -1} if it wasn't
+    PackedLayer Find(unsigned int textureID) const;
+
+    // binds every array to its texture unit: array i goes to GL_TEXTURE0 + i
+    void Bind() const;
+
+    // number of arrays built
+    size_t Size() const { return arrays.size(); }
+
+    // deletes the arrays
+    void del();
+
+private:
+    std::vector<unsigned int> pending;
+    std::unordered_map<unsigned int, PackedLayer> layers;
+    std::vector<unsigned int> arrays;
+};
+
+#endif //OPENGL_PRACTICE_MATERIAL_PACKER_H
@@ -40,25 +40,52 @@ struct Texture {
     std::string path;
 };
 
+// where a texture ended up after a MaterialPacker put it into a texture array
+struct PackedLayer {
+    unsigned int array;     // index of the array in the packer, which is also the texture unit it's bound to
+    int layer;
+};
+
 class Mesh {
 public:
     // mesh Data
     std::vector<Vertex>       vertices;
     std::vector<unsigned int> indices;
     std::vector<Texture>      textures;
+    std::vector<PackedLayer>  layers;   // where each of textures was packed (see Model::UsePacker), empty when not packed
     unsigned int VAO;
+    // object space bounding box of the vertices, computed once at construction
+    glm::vec3 boundsMin;
+    glm::vec3 boundsMax;
 
-    // constructor
+    // constructor, moving from the vectors it's given (pass them with std::move to avoid copying them)
     Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
 
     // render the mesh
     void Draw(Shader &shader);
 
+    // render the mesh with its textures read from texture arrays that are already bound (MaterialPacker::Bind),
+    // so only sampler and layer uniforms change between meshes
+    void DrawPacked(Shader &shader);
+
+    // deletes the GL objects; copies of the mesh share them, so only one of them may call this
+    void del();
+
 private:
     // render data
     unsigned int VBO, EBO;
+    // the sampler uniform of each of textures (texture_diffuse1, texture_specular1 ...) and of its layer when packed,
+    // named once at construction rather than with string temporaries on every draw
+    std::vector<std::string> samplerNames;
+    std::vector<std::string> layerNames;
+
+    // fills samplerNames and layerNames
+    void setupSamplerNames();
 
     // initializes all the buffer objects/arrays
     void setupMesh();
+
+    // refills the buffers from vertices and indices after GpuResidency evicted them
+    void uploadBuffers();
 };
 #endif //OPENGL_PRACTICE_MESH_H
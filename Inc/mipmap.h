@@ -0,0 +1,28 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_MIPMAP_H
+#define OPENGL_PRACTICE_MIPMAP_H
+
+#include <ktx.h>
+
+enum MipFilter {
+    MIP_FILTER_BOX,     // 2x2 average, cheapest
+    MIP_FILTER_KAISER   // Kaiser windowed sinc, keeps detail without ringing much
+};
+
+// Builds the full mip chain of an 8 bit image on the CPU, replacing glGenerateMipmap.
+// The image is filtered in linear float space: with srgb set the colour channels of 3/4 channel images are
+// converted from sRGB first (alpha and 1/2 channel images are always treated as linear data).
+// Rows are split across worker threads (0 uses every hardware thread) and the inner loops use SSE, or AVX when
+// the CPU has it. The result is a ready to upload (and to cache) uncompressed KtxImage with GL_UNSIGNED_BYTE levels,
+// an sRGB internal format when srgb is set, and rows padded to 4 bytes.
+void BuildMipChain(const unsigned char *pixels, int width, int height, int channels, bool srgb, MipFilter filter,
+                   KtxImage &image, int threads = 0);
+
+// the same chain for a tightly packed RGBA8 image, without row padding (what the block compressor wants)
+std::vector<std::vector<unsigned char>> BuildMipChainRgba(const unsigned char *rgba, int width, int height, bool srgb,
+                                                          MipFilter filter, int threads = 0);
+
+#endif //OPENGL_PRACTICE_MIPMAP_H
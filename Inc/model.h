@@ -16,15 +16,22 @@
 
 #include <mesh.h>
 #include <shader.h>
+#include <material_packer.h>
+#include <frustum.h>
 
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
-unsigned int TextureFromFile(const char *path, const std::string &directory, bool gamma = false);
+// loads an image from directory/path into a new mipmapped GL texture. channels forces the number of components (0 keeps the file's),
+// type is the material texture type ("texture_normal" ...) that picks the TextureQuality along with the path.
+// prefer TextureCache::Acquire, which shares textures between everything that loads the same file.
+unsigned int TextureFromFile(const char *path, const std::string &directory, bool gamma = false, int channels = 0,
+                             const std::string &type = "");
 
 class Model
 {
@@ -41,7 +48,40 @@ public:
     // draws the model, and thus all its meshes
     void Draw(Shader &shader);
 
+    // draws only the meshes whose bounds intersect the frustum (world space, e.g. Camera::GetFrustum) when placed with model
+    void Draw(Shader &shader, const Frustum &frustum, const glm::mat4 &model);
+
+    // hands every texture of the model to the packer; call MaterialPacker::Pack and then UsePacker afterwards
+    void AddTextures(MaterialPacker &packer);
+
+    // looks up which array layer each mesh's textures were packed into. Returns false if some texture has none, or
+    // sits in an array past the texture units; the packed draw would read the wrong texture for it
+    bool UsePacker(const MaterialPacker &packer);
+
+    // draws the model with its textures read from the packer's arrays: they're bound once instead of per mesh
+    void Draw(Shader &shader, const MaterialPacker &packer);
+
+    // the packed draw, culled like Draw(shader, frustum, model)
+    void Draw(Shader &shader, const MaterialPacker &packer, const Frustum &frustum, const glm::mat4 &model);
+
+    // tells the TextureStreamer how large each mesh's textures appear from the camera, so it can stream their mips
+    void StreamTextures(const glm::mat4 &model, const glm::vec3 &cameraPosition, float fovY, int viewportHeight);
+
+    // gives this model's references to its textures back to the TextureCache and deletes the meshes' buffers
+    void del();
+
 private:
+    // material path, colour space and type ("a.png|srgb|texture_diffuse") -> index into textures_loaded
+    std::unordered_map<std::string, size_t> textures_index;
+
+    // object space bounds of every mesh (same order as meshes), gathered once after loading for the batched culling
+    BoundingBoxes meshBounds;
+    // indices of the meshes that passed the last cull, kept around so culling doesn't allocate every frame
+    std::vector<unsigned int> visibleMeshes;
+
+    // fills visibleMeshes with the meshes inside the frustum
+    void cullMeshes(const Frustum &frustum, const glm::mat4 &model);
+
     // loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
     void loadModel(std::string const &path);
 
@@ -55,5 +95,8 @@ private:
     std::vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, std::string typeName);
 };
 
+// converts the vertices of an assimp mesh (positions, normals, first texture coordinates and tangent frame) to ours,
+// appending them to vertices. The vertex half of Model::processMesh, on its own for blob_sea_bench
+void ConvertMeshVertices(const aiMesh *mesh, std::vector<Vertex> &vertices);
 
 #endif //OPENGL_PRACTICE_MODEL_H
@@ -0,0 +1,43 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_NULL_GL_H
+#define OPENGL_PRACTICE_NULL_GL_H
+
+#include <cstdint>
+
+// what reached the null backend since the last Reset
+struct NullGlCounters {
+    uint64_t calls = 0;
+    uint64_t draws = 0;
+    // vertices (or indices) the draws submitted, times their instances
+    uint64_t vertices = 0;
+    // binds, enables and the other render state changes
+    uint64_t stateChanges = 0;
+    uint64_t uniforms = 0;
+    // buffer and texture uploads, and the bytes they copied from client memory
+    uint64_t uploads = 0;
+    uint64_t uploadBytes = 0;
+    uint64_t objectsCreated = 0;
+    uint64_t objectsDeleted = 0;
+};
+
+// An OpenGL 3.3 core "driver" that draws nothing: glad loads it like a real one (gladLoadGLLoader with
+// NullGl::GetProcAddress) and every entry point the renderer calls then only counts the call and keeps the little
+// state the renderer reads back: object names, bindings, the viewport, and the size and format of each texture level
+// (GpuResidency and MaterialPacker ask for those). Reads of pixels and query results return zeros; compiles and
+// links succeed and framebuffers are complete. It needs neither a display nor a GPU, so the CPU side of drawing
+// (Shader's setters, Mesh::Draw, the grid) can be timed on its own, anywhere. blob_sea_bench runs its GL benchmarks
+// on it when configured with -DBLOB_SEA_NULL_GL=ON.
+// Entry points the renderer doesn't use are left unloaded (null), so calling a new one shows up at once.
+class NullGl {
+public:
+    // for gladLoadGLLoader
+    static void *GetProcAddress(const char *name);
+
+    static const NullGlCounters &Counters();
+    static void Reset();
+};
+
+#endif //OPENGL_PRACTICE_NULL_GL_H
@@ -0,0 +1,55 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_OVERDRAW_H
+#define OPENGL_PRACTICE_OVERDRAW_H
+
+#include <shader.h>
+
+#include <memory>
+#include <vector>
+
+// The overdraw view: the passes are drawn into a float counter target with additive blending, through shaders that
+// output 1 per fragment (shader_overdraw.frag with each pass's own vertex shader), then the counts are read back and
+// measured, and shown as a heat map instead of the scene.
+// With depth testing, a pixel counts the fragments that passed the test in the order the passes drew them: what
+// sorting front to back would bring down to 1. Without it, every fragment rasterized, which is what a depth prepass
+// would bring the shading down to. Reading the counts back waits for the frame, it's a diagnostics mode.
+class OverdrawView {
+public:
+    // loads the heat map shader, the target is made by the first Begin
+    void Create();
+
+    // binds the counter target (resized to the viewport if needed), clears it and turns additive blending on
+    void Begin(int width, int height, bool depthTest);
+    // reads the counts back, measures them and rebinds the framebuffer Begin found bound
+    void End();
+    // draws the heat map into the bound framebuffer
+    void Show();
+
+    // fragments per pixel over the whole screen, over the pixels anything was drawn to, and the most on one pixel
+    float MeanOverdraw() const { return mean; }
+    float CoveredMeanOverdraw() const { return coveredMean; }
+    float MaxOverdraw() const { return maximum; }
+
+    void del();
+
+private:
+    void createTarget(int width, int height);
+    void deleteTarget();
+
+    std::unique_ptr<Shader> viewShader;
+    unsigned int framebuffer = 0, counts = 0, depth = 0;
+    unsigned int emptyVAO = 0;
+    int width = 0, height = 0;
+
+    int previousFramebuffer = 0;
+    int previousViewport[4] = {0, 0, 0, 0};
+    bool previousDepthTest = true;
+
+    std::vector<float> readback;
+    float mean = 0.0f, coveredMean = 0.0f, maximum = 0.0f;
+};
+
+#endif //OPENGL_PRACTICE_OVERDRAW_H
@@ -0,0 +1,110 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_PERF_COUNTERS_H
+#define OPENGL_PRACTICE_PERF_COUNTERS_H
+
+#include <profiler.h>
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+enum PerfCounter {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    // last level cache misses
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_COUNTER_COUNT
+};
+
+// the calling thread's counters at one moment, as the kernel counted them: while the group was multiplexed out
+// nothing was counted, so a difference of two readings is scaled by how long the group ran in between (see Record)
+struct PerfCounterValues {
+    uint64_t counts[PERF_COUNTER_COUNT] = {};
+    // the counters the thread has, the others stay 0
+    bool present[PERF_COUNTER_COUNT] = {};
+    // nanoseconds the group was enabled, and actually on the PMU, since it was opened
+    uint64_t timeEnabled = 0;
+    uint64_t timeRunning = 0;
+};
+
+// what the runs of one zone added up to
+struct PerfZoneTotals {
+    const char *name = nullptr;
+    uint64_t runs = 0;
+    // the items the zone's loop went over, summed over its runs
+    uint64_t elements = 0;
+    uint64_t counts[PERF_COUNTER_COUNT] = {};
+    bool present[PERF_COUNTER_COUNT] = {};
+};
+
+// Hardware counters (cycles, instructions, LLC misses and branch misses) of the zones marked with PROFILE_COUNTERS,
+// read through Linux's perf_event_open as one group per thread, user space only. Unlike a zone's time they tell
+// whether a faster loop really misses the cache less or only moved its misses elsewhere: Print reports each zone's
+// IPC and its cycles and misses per element. Counters the CPU or the kernel don't offer (in most VMs, or with
+// /proc/sys/kernel/perf_event_paranoid above 2) read as missing; off Linux none exist and zones cost nothing more
+// than a check. Compiled in with the other zones, by -DBLOB_SEA_PROFILE=ON.
+class PerfCounters {
+public:
+    // returns the single instance shared by the whole process
+    static PerfCounters &Instance();
+
+    // whether the calling thread has any counters (opens them on its first call)
+    bool Available();
+    // the calling thread's counts so far, false without counters
+    bool Read(PerfCounterValues &values);
+
+    // adds one run of a zone over the given number of elements. name has to outlive the instance (a string literal)
+    void Record(const char *name, uint64_t elements, const PerfCounterValues &begin, const PerfCounterValues &end);
+
+    // the zones recorded since the last Reset, in the order they first ran
+    std::vector<PerfZoneTotals> Totals();
+    // a table of Totals() on stdout, nothing if no zone ran
+    void Print();
+    void Reset();
+
+private:
+    PerfCounters() = default;
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    std::mutex mutex;
+    std::vector<PerfZoneTotals> zones;
+};
+
+// counts the scope it's declared in as one run of the zone over elements items
+class PerfCounterZone {
+public:
+    PerfCounterZone(const char *name, uint64_t elements) : name(name), elements(elements)
+    {
+        counting = PerfCounters::Instance().Read(begin);
+    }
+    ~PerfCounterZone()
+    {
+        PerfCounterValues end;
+        if (counting && PerfCounters::Instance().Read(end))
+            PerfCounters::Instance().Record(name, elements, begin, end);
+    }
+
+    PerfCounterZone(const PerfCounterZone &) = delete;
+    PerfCounterZone &operator=(const PerfCounterZone &) = delete;
+
+private:
+    const char *name;
+    uint64_t elements;
+    bool counting;
+    PerfCounterValues begin;
+};
+
+#ifdef BLOB_SEA_PROFILE
+// PROFILE_COUNTERS("name", n) counts the rest of the enclosing scope as a loop over n elements. Meant for hot loops:
+// reading the counters is a system call at each end
+#define PROFILE_COUNTERS(name, elements) PerfCounterZone PROFILE_CONCAT(perfZone, __LINE__)(name, (uint64_t)(elements))
+#else
+#define PROFILE_COUNTERS(name, elements) ((void)0)
+#endif
+
+#endif //OPENGL_PRACTICE_PERF_COUNTERS_H
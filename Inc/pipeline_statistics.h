@@ -0,0 +1,87 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_PIPELINE_STATISTICS_H
+#define OPENGL_PRACTICE_PIPELINE_STATISTICS_H
+
+#include <glad/glad.h>
+#include <gpu_profiler.h>
+
+#include <cstdint>
+#include <vector>
+
+// what the GPU did for one pass, from GL_ARB_pipeline_statistics_query
+struct PassStatistics {
+    const char *name = nullptr;
+    uint64_t verticesSubmitted = 0;
+    uint64_t vertexShaderInvocations = 0;
+    // primitives going into clipping, and coming out of it (clipped into pieces, or culled)
+    uint64_t clippingInputPrimitives = 0;
+    uint64_t clippingOutputPrimitives = 0;
+    uint64_t fragmentShaderInvocations = 0;
+};
+
+// A diagnostics mode measuring each pass with pipeline statistics queries, where the driver has
+// GL_ARB_pipeline_statistics_query (Mesa does, llvmpipe included). Vertex shader invocations against vertices
+// submitted shows how well the post-transform cache does, fragment shader invocations against the pixels on screen
+// how much overdraw there is. Results are read GPU_PROFILE_FRAMES frames late like GpuProfiler's, so measuring
+// doesn't stall. Passes don't nest: a pass begun inside another is counted as part of it.
+// Only use it from the thread owning the GL context.
+class PipelineStatistics {
+public:
+    // returns the single instance shared by the whole process
+    static PipelineStatistics &Instance();
+
+    // turns measuring on or off; returns false (and stays off) if the extension is missing
+    bool SetEnabled(bool enabled);
+    bool Enabled() const { return enabled; }
+
+    // starts a frame: collects the frame issued GPU_PROFILE_FRAMES frames ago and reuses its queries
+    void BeginFrame();
+
+    void Begin(const char *name);
+    void End();
+
+    // the passes of the last collected frame, in the order they began
+    const std::vector<PassStatistics> &LastFrame() const { return lastFrame; }
+
+    void del();
+
+private:
+    PipelineStatistics() = default;
+    PipelineStatistics(const PipelineStatistics &) = delete;
+    PipelineStatistics &operator=(const PipelineStatistics &) = delete;
+
+    // a query of each of these targets per pass (queries of different targets can be active at once)
+    static const int TARGETS = 5;
+
+    struct Frame {
+        // TARGETS queries per pass, reused once the frame was collected
+        std::vector<unsigned int> queries;
+        std::vector<const char *> passes;
+    };
+
+    void collect(Frame &frame);
+
+    Frame frames[GPU_PROFILE_FRAMES];
+    unsigned int current = 0;
+    bool enabled = false;
+    // nesting depth of Begin, only the outermost pass is measured
+    unsigned int depth = 0;
+    // whether the outermost pass began queries
+    bool measuring = false;
+    std::vector<PassStatistics> lastFrame;
+};
+
+// measures the scope it's declared in as a pass, when PipelineStatistics is enabled
+class PipelineStatisticsPass {
+public:
+    explicit PipelineStatisticsPass(const char *name) { PipelineStatistics::Instance().Begin(name); }
+    ~PipelineStatisticsPass() { PipelineStatistics::Instance().End(); }
+
+    PipelineStatisticsPass(const PipelineStatisticsPass &) = delete;
+    PipelineStatisticsPass &operator=(const PipelineStatisticsPass &) = delete;
+};
+
+#endif //OPENGL_PRACTICE_PIPELINE_STATISTICS_H
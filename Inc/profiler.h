@@ -0,0 +1,140 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_PROFILER_H
+#define OPENGL_PRACTICE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define PROFILE_RDTSC 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// zones each thread keeps, the oldest are overwritten once a thread recorded more (a power of two)
+const unsigned int PROFILE_RING_EVENTS = 1 << 15;
+
+// a CPU timestamp in ticks: the time stamp counter on x86 (a few cycles to read), steady_clock nanoseconds elsewhere.
+// Only differences mean anything, the trace export converts them to microseconds.
+inline uint64_t ProfileTimestamp()
+{
+#ifdef PROFILE_RDTSC
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct ProfileEvent {
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// the zones of one thread. Only the owning thread writes, and head is only published after the event it counts
+// was written, so the exporter can read without stopping it
+struct ProfileRing {
+    ProfileEvent events[PROFILE_RING_EVENTS];
+    std::atomic<uint64_t> head{0};
+    // shown as the thread's name in the trace
+    std::string name;
+    // trace thread id, rings of threads that exited are handed to the next new thread
+    unsigned int id = 0;
+    bool owned = false;
+    // the GPU track: begin and end are GPU timestamps in nanoseconds, not ticks
+    bool gpu = false;
+};
+
+// Records nested CPU zones (see PROFILE_ZONE) into a lock-free ring per thread and writes them out as Chrome
+// trace-event JSON, which chrome://tracing and https://ui.perfetto.dev open. GPU zones (see GpuProfiler) go on a
+// track of their own in the same timeline. Zones are compiled in only when the
+// project is configured with -DBLOB_SEA_PROFILE=ON, otherwise the macros expand to nothing.
+class Profiler {
+public:
+    // returns the single instance shared by the whole process
+    static Profiler &Instance();
+
+    // adds a finished zone to the calling thread's ring. name has to outlive the profiler (a string literal)
+    void Record(const char *name, uint64_t begin, uint64_t end);
+
+    // names the calling thread in the trace
+    void SetThreadName(const char *name);
+
+    // adds a finished GPU zone (GL_TIMESTAMP nanoseconds) to the GPU track, from the thread owning the GL context.
+    // Needs SyncGpuClock first, which places GPU time on the CPU timeline
+    void RecordGpu(const char *name, uint64_t beginNs, uint64_t endNs);
+    // pairs the GPU clock (glGetInteger64v(GL_TIMESTAMP)) with ProfileTimestamp() read at the same moment
+    void SyncGpuClock(uint64_t gpuNs, uint64_t ticks);
+
+    // writes every zone still in the rings as trace events ("ph":"X", microseconds since the profiler started), or
+    // only those that ended at sinceTicks or later. Threads may keep recording meanwhile, zones overwritten during
+    // the copy are dropped. A thread whose ring wrapped after sinceTicks gets an instant event where its zones start;
+    // lostSeconds (if given) is set to how much of the time since sinceTicks some thread has no zones for, 0 if none.
+    // Safe to call from any thread.
+    bool WriteChromeTrace(const std::string &path, uint64_t sinceTicks = 0, double *lostSeconds = nullptr);
+
+    // the ProfileTimestamp() of the given number of seconds ago (the profiler's start, if it's younger than that)
+    uint64_t TicksAgo(double seconds);
+
+private:
+    Profiler();
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    ProfileRing *threadRing();
+    // ticks per microsecond of ProfileTimestamp(), measured against steady_clock since the start
+    double ticksPerMicrosecond();
+    friend struct ProfileThreadRing;
+    void releaseRing(ProfileRing *ring);
+
+    // guards rings (not their contents): only taken when a thread records its first zone, exits, or on export
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ProfileRing>> rings;
+
+    // the clock at startup, the export converts ticks to microseconds from here
+    uint64_t startTicks;
+    std::chrono::steady_clock::time_point startTime;
+
+    ProfileRing *gpuRing = nullptr;
+    uint64_t gpuSyncNs = 0;
+    uint64_t gpuSyncTicks = 0;
+};
+
+// times the scope it's declared in
+class ProfileZone {
+public:
+    explicit ProfileZone(const char *name) : name(name), begin(ProfileTimestamp()) {}
+    ~ProfileZone() { Profiler::Instance().Record(name, begin, ProfileTimestamp()); }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *name;
+    uint64_t begin;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef BLOB_SEA_PROFILE
+// PROFILE_ZONE("name") times the rest of the enclosing scope, zones in zones nest in the trace
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD(name) Profiler::Instance().SetThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#endif
+
+#endif //OPENGL_PRACTICE_PROFILER_H
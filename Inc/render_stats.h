@@ -0,0 +1,111 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_RENDER_STATS_H
+#define OPENGL_PRACTICE_RENDER_STATS_H
+
+#include <glad/glad.h>
+#include <frame_histogram.h>
+
+#include <chrono>
+#include <cstddef>
+
+// what the renderer asked GL to do during one frame
+struct RenderCounters {
+    unsigned int drawCalls = 0;
+    size_t triangles = 0;
+    size_t vertices = 0;
+    // glUseProgram calls that changed the bound program
+    unsigned int programSwitches = 0;
+    unsigned int textureBinds = 0;
+    size_t bufferUploadBytes = 0;
+    unsigned int uniformUpdates = 0;
+};
+
+// frames the frame time history keeps, the width of the HUD's graph
+const unsigned int RENDER_STATS_HISTORY = 240;
+
+// Per frame counts of draw calls, triangles, vertices, program switches, texture binds, buffer uploads and uniform
+// updates, the time of the last RENDER_STATS_HISTORY frames and a histogram of every frame's time. The renderer
+// counts through the Counted* wrappers below (and Shader's setters), which do exactly what the GL call they wrap does.
+// Like the GL calls it counts, it must only be used from the thread owning the context.
+class RenderStats {
+public:
+    // returns the single instance shared by the whole process
+    static RenderStats &Instance();
+
+    // closes the previous frame (its counters become Last, the time since it began goes into the history) and
+    // starts counting a new one. Call it first thing every frame
+    void BeginFrame();
+
+    // the frame being counted, and the last complete one
+    RenderCounters &Current() { return current; }
+    const RenderCounters &Last() const { return last; }
+
+    // milliseconds from the start of one frame to the start of the next, for the frames in the history: 0 is the
+    // oldest, FrameCount() - 1 the last complete frame
+    unsigned int FrameCount() const { return frameCount; }
+    float FrameMs(unsigned int index) const;
+    // the time of the last complete frame, 0 before there is one
+    float LastFrameMs() const { return frameCount == 0 ? 0.0f : FrameMs(frameCount - 1); }
+    // the times of all the frames so far, for their percentiles
+    const FrameHistogram &Histogram() const { return histogram; }
+
+    void CountDraw(GLenum mode, size_t vertices);
+    void CountProgram(unsigned int program);
+
+private:
+    RenderStats() = default;
+    RenderStats(const RenderStats &) = delete;
+    RenderStats &operator=(const RenderStats &) = delete;
+
+    RenderCounters current;
+    RenderCounters last;
+    unsigned int boundProgram = 0;
+
+    float frameMs[RENDER_STATS_HISTORY] = {};
+    unsigned int frameCount = 0;
+    unsigned int nextFrame = 0;
+    FrameHistogram histogram;
+    bool started = false;
+    std::chrono::steady_clock::time_point frameStart;
+};
+
+inline void CountedDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    RenderStats::Instance().CountDraw(mode, (size_t)count);
+    glDrawArrays(mode, first, count);
+}
+
+inline void CountedDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    RenderStats::Instance().CountDraw(mode, (size_t)count);
+    glDrawElements(mode, count, type, indices);
+}
+
+inline void CountedUseProgram(unsigned int program)
+{
+    RenderStats::Instance().CountProgram(program);
+    glUseProgram(program);
+}
+
+inline void CountedBindTexture(GLenum target, unsigned int texture)
+{
+    RenderStats::Instance().Current().textureBinds++;
+    glBindTexture(target, texture);
+}
+
+inline void CountedBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    RenderStats::Instance().Current().bufferUploadBytes += (size_t)size;
+    glBufferData(target, size, data, usage);
+}
+
+inline void CountedUniform1i(GLint location, GLint value)
+{
+    RenderStats::Instance().Current().uniformUpdates++;
+    glUniform1i(location, value);
+}
+
+#endif //OPENGL_PRACTICE_RENDER_STATS_H
@@ -24,12 +24,12 @@ public:
     void use();
     void del();
 
-    // for uniforms
-    void setBool(const std::string &name, bool value) const;
-    void setInt(const std::string &name, int value) const;
-    void setFloat(const std::string &name, float value) const;
-    void setMat4(const std::string &name, glm::mat4 value) const;
-    void setVec4(const std::string &name, float v1, float v2, float v3, float v4) const;
+    // for uniforms (names are C strings, so a literal doesn't become a std::string every call)
+    void setBool(const char *name, bool value) const;
+    void setInt(const char *name, int value) const;
+    void setFloat(const char *name, float value) const;
+    void setMat4(const char *name, const glm::mat4 &value) const;
+    void setVec4(const char *name, float v1, float v2, float v3, float v4) const;
 };
 
 #endif //OPENGL_PRACTICE_SHADER_H
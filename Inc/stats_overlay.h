@@ -0,0 +1,40 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_STATS_OVERLAY_H
+#define OPENGL_PRACTICE_STATS_OVERLAY_H
+
+#include <shader.h>
+#include <overdraw.h>
+
+#include <memory>
+#include <vector>
+
+// The HUD: RenderStats' counters of the last frame and a graph of the recent frame times, drawn over the top left
+// corner of the scene with a built in 5x7 pixel font. Its own GL calls aren't counted. When they're on, the overdraw
+// measurements and the PipelineStatistics of each pass are listed as well.
+class StatsOverlay {
+public:
+    // builds the font texture, the shader (../Resources/shader_hud.*) and the vertex buffer
+    void Create();
+
+    // draws over whatever is in the bound framebuffer. Leaves depth testing on and blending off, like it finds them.
+    // overdraw is the active overdraw view, if any
+    void Draw(int viewportWidth, int viewportHeight, const OverdrawView *overdraw = nullptr);
+
+    void del();
+
+private:
+    void addQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, const glm::vec4 &colour);
+    void addSolid(float x0, float y0, float x1, float y1, const glm::vec4 &colour);
+    void addText(float x, float y, const char *text, const glm::vec4 &colour);
+
+    std::unique_ptr<Shader> shader;
+    unsigned int fontTexture = 0;
+    unsigned int VAO = 0, VBO = 0;
+    // position, texture coordinates and colour of every vertex, rebuilt each frame
+    std::vector<float> vertices;
+};
+
+#endif //OPENGL_PRACTICE_STATS_OVERLAY_H
@@ -267,6 +267,13 @@ RECENT REVISION HISTORY:
 // (at least this is true for iOS and Android). Therefore, the NEON support is
 // toggled by a build flag: define STBI_NEON to get NEON loops.
 //
+// On x86 builds that have SSE2, the JPEG IDCT, YCbCr-to-RGB conversion and
+// chroma upsampling additionally have AVX2 versions. These are compiled with
+// a per-function target attribute (GCC/Clang) and picked at run time with a
+// CPUID test, so the binary itself does not require AVX2. They produce
+// bit-identical output to the SSE2 and C versions. Define STBI_NO_AVX2 to
+// leave them out.
+//
 // If for some reason you do not want to use any of SIMD code, or if
 // you have issues compiling it, you can disable it entirely by
 // defining STBI_NO_SIMD.
@@ -521,6 +528,26 @@ STBIDEF void stbi_set_unpremultiply_on_load_thread(int flag_true_if_should_unpre
 STBIDEF void stbi_convert_iphone_png_to_rgb_thread(int flag_true_if_should_convert);
 STBIDEF void stbi_set_flip_vertically_on_load_thread(int flag_true_if_should_flip);
 
+// JPEG decoding of a single image on several threads. baseline JPEGs that carry
+// restart markers (DRI) and are decoded from memory get split at the markers,
+// and the segments are decoded through this hook: it must call task(context, i)
+// for every i in [0, count), from whatever threads it likes, and return once all
+// of them have finished. NULL (the default) decodes serially, as do images
+// without restart markers and callback/FILE based loads.
+typedef void stbi_parallel_task(void *context, int index);
+typedef void stbi_parallel_for(stbi_parallel_task *task, void *context, int count);
+STBIDEF void stbi_set_jpeg_parallel_for(stbi_parallel_for *parallel_for);
+
+// caps the JPEG kernels at a SIMD level, to measure or compare the paths: the
+// best one the CPU supports up to the cap is used. the default is STBI_SIMD_AVX2
+enum
+{
+   STBI_SIMD_SCALAR = 0,
+   STBI_SIMD_SSE2   = 1, // or NEON
+   STBI_SIMD_AVX2   = 2
+};
+STBIDEF void stbi_set_jpeg_simd_level(int level);
+
 // ZLIB client - used by PNG, available for other purposes
 
 STBIDEF char *stbi_zlib_decode_malloc_guesssize(const char *buffer, int len, int initial_size, int *outlen);
@@ -771,6 +798,37 @@ static int stbi__sse2_available(void)
 #endif
 #endif
 
+// AVX2 kernels are only an add-on to the SSE2 ones, selected at run time
+#if defined(STBI_SSE2) && !defined(STBI_NO_AVX2) && !defined(STBI_NO_JPEG) && \
+    ((defined(_MSC_VER) && _MSC_VER >= 1800) || defined(__GNUC__) || defined(__clang__))
+#define STBI_AVX2
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#define STBI__AVX2_TARGET
+static int stbi__avx2_available(void)
+{
+   int info[4];
+   __cpuid(info,0);
+   if (info[0] < 7) return 0;
+   __cpuid(info,1);
+   // OSXSAVE and AVX, then make sure the OS saves the ymm state
+   if (((info[2] >> 27) & 1) == 0 || ((info[2] >> 28) & 1) == 0) return 0;
+   if ((_xgetbv(0) & 6) != 6) return 0;
+   __cpuidex(info,7,0);
+   return ((info[1] >> 5) & 1) != 0;
+}
+#else
+#define STBI__AVX2_TARGET __attribute__((target("avx2")))
+static int stbi__avx2_available(void)
+{
+   // checks CPUID and the OS ymm state for us
+   __builtin_cpu_init();
+   return __builtin_cpu_supports("avx2") != 0;
+}
+#endif
+#endif
+
 // ARM NEON
 #if defined(STBI_NO_SIMD) && defined(STBI_NEON)
 #undef STBI_NEON
@@ -1114,6 +1172,20 @@ STBIDEF void stbi_set_flip_vertically_on_load_thread(int flag_true_if_should_fli
                                          : stbi__vertically_flip_on_load_global)
 #endif // STBI_THREAD_LOCAL
 
+static stbi_parallel_for *stbi__jpeg_parallel_for = NULL;
+
+STBIDEF void stbi_set_jpeg_parallel_for(stbi_parallel_for *parallel_for)
+{
+    stbi__jpeg_parallel_for = parallel_for;
+}
+
+static int stbi__jpeg_simd_level = STBI_SIMD_AVX2;
+
+STBIDEF void stbi_set_jpeg_simd_level(int level)
+{
+    stbi__jpeg_simd_level = level;
+}
+
 static void *stbi__load_main(stbi__context *s, int *x, int *y, int *comp, int req_comp, stbi__result_info *ri, int bpc)
 {
     memset(ri, 0, sizeof(*ri)); // make sure it's initialized if we add new fields
@@ -1978,6 +2050,7 @@ typedef struct
     void (*idct_block_kernel)(stbi_uc *out, int out_stride, short data[64]);
     void (*YCbCr_to_RGB_kernel)(stbi_uc *out, const stbi_uc *y, const stbi_uc *pcb, const stbi_uc *pcr, int count, int step);
     stbi_uc *(*resample_row_hv_2_kernel)(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs);
+    stbi_uc *(*resample_row_h_2_kernel)(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs);
 } stbi__jpeg;
 
 static int stbi__build_huffman(stbi__huffman *h, int *count)
@@ -2670,6 +2743,175 @@ static void stbi__idct_simd(stbi_uc *out, int out_stride, short data[64])
 
 #endif // STBI_SSE2
 
+#ifdef STBI_AVX2
+// avx2 integer IDCT. same math as the sse2 version, but the eight 32-bit
+// intermediates of a row fit in one register instead of a lo/hi pair, which
+// halves the multiply-adds and wide adds in both passes. still bit-identical
+// to the generic C version.
+static STBI__AVX2_TARGET void stbi__idct_avx2(stbi_uc *out, int out_stride, short data[64])
+{
+    __m128i row0, row1, row2, row3, row4, row5, row6, row7;
+    __m128i tmp;
+
+    // dot product constant: even elems=x, odd elems=y
+#define dct_const(x,y)  _mm256_setr_epi16((x),(y),(x),(y),(x),(y),(x),(y),(x),(y),(x),(y),(x),(y),(x),(y))
+
+    // out(0) = c0[even]*x + c0[odd]*y   (c0, x, y 16-bit, out 32-bit)
+    // out(1) = c1[even]*x + c1[odd]*y
+    // the low lane gets elements 0..3, the high lane 4..7, so results come
+    // out in element order.
+#define dct_rot(out0,out1, x,y,c0,c1) \
+      __m256i c0##xy = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16((x),(y))), \
+                                               _mm_unpackhi_epi16((x),(y)), 1); \
+      __m256i out0 = _mm256_madd_epi16(c0##xy, c0); \
+      __m256i out1 = _mm256_madd_epi16(c0##xy, c1)
+
+    // out = in << 12  (in 16-bit, out 32-bit)
+#define dct_widen(out, in) \
+      __m256i out = _mm256_slli_epi32(_mm256_cvtepi16_epi32(in), 12)
+
+    // butterfly a/b, add bias, then shift by "s" and pack
+#define dct_bfly32o(out0, out1, a,b,bias,s) \
+      { \
+         __m256i abiased = _mm256_add_epi32(a, bias); \
+         __m256i sum = _mm256_srai_epi32(_mm256_add_epi32(abiased, b), s); \
+         __m256i dif = _mm256_srai_epi32(_mm256_sub_epi32(abiased, b), s); \
+         /* packs works per lane: s0-3 d0-3 | s4-7 d4-7, reorder the qwords */ \
+         __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(sum, dif), 0xd8); \
+         out0 = _mm256_castsi256_si128(packed); \
+         out1 = _mm256_extracti128_si256(packed, 1); \
+      }
+
+    // 8-bit interleave step (for transposes)
+#define dct_interleave8(a, b) \
+      tmp = a; \
+      a = _mm_unpacklo_epi8(a, b); \
+      b = _mm_unpackhi_epi8(tmp, b)
+
+    // 16-bit interleave step (for transposes)
+#define dct_interleave16(a, b) \
+      tmp = a; \
+      a = _mm_unpacklo_epi16(a, b); \
+      b = _mm_unpackhi_epi16(tmp, b)
+
+#define dct_pass(bias,shift) \
+      { \
+         /* even part */ \
+         dct_rot(t2e,t3e, row2,row6, rot0_0,rot0_1); \
+         __m128i sum04 = _mm_add_epi16(row0, row4); \
+         __m128i dif04 = _mm_sub_epi16(row0, row4); \
+         dct_widen(t0e, sum04); \
+         dct_widen(t1e, dif04); \
+         __m256i x0 = _mm256_add_epi32(t0e, t3e); \
+         __m256i x3 = _mm256_sub_epi32(t0e, t3e); \
+         __m256i x1 = _mm256_add_epi32(t1e, t2e); \
+         __m256i x2 = _mm256_sub_epi32(t1e, t2e); \
+         /* odd part */ \
+         dct_rot(y0o,y2o, row7,row3, rot2_0,rot2_1); \
+         dct_rot(y1o,y3o, row5,row1, rot3_0,rot3_1); \
+         __m128i sum17 = _mm_add_epi16(row1, row7); \
+         __m128i sum35 = _mm_add_epi16(row3, row5); \
+         dct_rot(y4o,y5o, sum17,sum35, rot1_0,rot1_1); \
+         __m256i x4 = _mm256_add_epi32(y0o, y4o); \
+         __m256i x5 = _mm256_add_epi32(y1o, y5o); \
+         __m256i x6 = _mm256_add_epi32(y2o, y5o); \
+         __m256i x7 = _mm256_add_epi32(y3o, y4o); \
+         dct_bfly32o(row0,row7, x0,x7,bias,shift); \
+         dct_bfly32o(row1,row6, x1,x6,bias,shift); \
+         dct_bfly32o(row2,row5, x2,x5,bias,shift); \
+         dct_bfly32o(row3,row4, x3,x4,bias,shift); \
+      }
+
+    __m256i rot0_0 = dct_const(stbi__f2f(0.5411961f), stbi__f2f(0.5411961f) + stbi__f2f(-1.847759065f));
+    __m256i rot0_1 = dct_const(stbi__f2f(0.5411961f) + stbi__f2f( 0.765366865f), stbi__f2f(0.5411961f));
+    __m256i rot1_0 = dct_const(stbi__f2f(1.175875602f) + stbi__f2f(-0.899976223f), stbi__f2f(1.175875602f));
+    __m256i rot1_1 = dct_const(stbi__f2f(1.175875602f), stbi__f2f(1.175875602f) + stbi__f2f(-2.562915447f));
+    __m256i rot2_0 = dct_const(stbi__f2f(-1.961570560f) + stbi__f2f( 0.298631336f), stbi__f2f(-1.961570560f));
+    __m256i rot2_1 = dct_const(stbi__f2f(-1.961570560f), stbi__f2f(-1.961570560f) + stbi__f2f( 3.072711026f));
+    __m256i rot3_0 = dct_const(stbi__f2f(-0.390180644f) + stbi__f2f( 2.053119869f), stbi__f2f(-0.390180644f));
+    __m256i rot3_1 = dct_const(stbi__f2f(-0.390180644f), stbi__f2f(-0.390180644f) + stbi__f2f( 1.501321110f));
+
+    // rounding biases in column/row passes, see stbi__idct_block for explanation.
+    __m256i bias_0 = _mm256_set1_epi32(512);
+    __m256i bias_1 = _mm256_set1_epi32(65536 + (128<<17));
+
+    // load
+    row0 = _mm_load_si128((const __m128i *) (data + 0*8));
+    row1 = _mm_load_si128((const __m128i *) (data + 1*8));
+    row2 = _mm_load_si128((const __m128i *) (data + 2*8));
+    row3 = _mm_load_si128((const __m128i *) (data + 3*8));
+    row4 = _mm_load_si128((const __m128i *) (data + 4*8));
+    row5 = _mm_load_si128((const __m128i *) (data + 5*8));
+    row6 = _mm_load_si128((const __m128i *) (data + 6*8));
+    row7 = _mm_load_si128((const __m128i *) (data + 7*8));
+
+    // column pass
+    dct_pass(bias_0, 10);
+
+    {
+        // 16bit 8x8 transpose pass 1
+        dct_interleave16(row0, row4);
+        dct_interleave16(row1, row5);
+        dct_interleave16(row2, row6);
+        dct_interleave16(row3, row7);
+
+        // transpose pass 2
+        dct_interleave16(row0, row2);
+        dct_interleave16(row1, row3);
+        dct_interleave16(row4, row6);
+        dct_interleave16(row5, row7);
+
+        // transpose pass 3
+        dct_interleave16(row0, row1);
+        dct_interleave16(row2, row3);
+        dct_interleave16(row4, row5);
+        dct_interleave16(row6, row7);
+    }
+
+    // row pass
+    dct_pass(bias_1, 17);
+
+    {
+        // pack
+        __m128i p0 = _mm_packus_epi16(row0, row1); // a0a1a2a3...a7b0b1b2b3...b7
+        __m128i p1 = _mm_packus_epi16(row2, row3);
+        __m128i p2 = _mm_packus_epi16(row4, row5);
+        __m128i p3 = _mm_packus_epi16(row6, row7);
+
+        // 8bit 8x8 transpose pass 1
+        dct_interleave8(p0, p2); // a0e0a1e1...
+        dct_interleave8(p1, p3); // c0g0c1g1...
+
+        // transpose pass 2
+        dct_interleave8(p0, p1); // a0c0e0g0...
+        dct_interleave8(p2, p3); // b0d0f0h0...
+
+        // transpose pass 3
+        dct_interleave8(p0, p2); // a0b0c0d0...
+        dct_interleave8(p1, p3); // a4b4c4d4...
+
+        // store
+        _mm_storel_epi64((__m128i *) out, p0); out += out_stride;
+        _mm_storel_epi64((__m128i *) out, _mm_shuffle_epi32(p0, 0x4e)); out += out_stride;
+        _mm_storel_epi64((__m128i *) out, p2); out += out_stride;
+        _mm_storel_epi64((__m128i *) out, _mm_shuffle_epi32(p2, 0x4e)); out += out_stride;
+        _mm_storel_epi64((__m128i *) out, p1); out += out_stride;
+        _mm_storel_epi64((__m128i *) out, _mm_shuffle_epi32(p1, 0x4e)); out += out_stride;
+        _mm_storel_epi64((__m128i *) out, p3); out += out_stride;
+        _mm_storel_epi64((__m128i *) out, _mm_shuffle_epi32(p3, 0x4e));
+    }
+
+#undef dct_const
+#undef dct_rot
+#undef dct_widen
+#undef dct_bfly32o
+#undef dct_interleave8
+#undef dct_interleave16
+#undef dct_pass
+}
+
+#endif // STBI_AVX2
+
 #ifdef STBI_NEON
 
 // NEON integer IDCT. should produce bit-identical
@@ -2912,9 +3154,158 @@ static void stbi__jpeg_reset(stbi__jpeg *j)
     // since we don't even allow 1<<30 pixels
 }
 
+// decodes restart units [first, last) of a baseline scan. a unit is one block
+// for non-interleaved scans and one MCU otherwise, the same thing the restart
+// interval counts.
+static int stbi__jpeg_decode_units(stbi__jpeg *z, int first, int last)
+{
+    STBI_SIMD_ALIGN(short, data[64]);
+    int u;
+    if (z->scan_n == 1) {
+        int n = z->order[0];
+        int w = (z->img_comp[n].x+7) >> 3;
+        int ha = z->img_comp[n].ha;
+        for (u = first; u < last; ++u) {
+            int i = u % w, j = u / w;
+            if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+            z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*j*8+i*8, z->img_comp[n].w2, data);
+        }
+    } else {
+        for (u = first; u < last; ++u) {
+            int i = u % z->img_mcu_x, j = u / z->img_mcu_x;
+            int k,x,y;
+            for (k=0; k < z->scan_n; ++k) {
+                int n = z->order[k];
+                for (y=0; y < z->img_comp[n].v; ++y) {
+                    for (x=0; x < z->img_comp[n].h; ++x) {
+                        int x2 = (i*z->img_comp[n].h + x)*8;
+                        int y2 = (j*z->img_comp[n].v + y)*8;
+                        int ha = z->img_comp[n].ha;
+                        if (!stbi__jpeg_decode_block(z, data, z->huff_dc+z->img_comp[n].hd, z->huff_ac+ha, z->fast_ac[ha], n, z->dequant[z->img_comp[n].tq])) return 0;
+                        z->idct_block_kernel(z->img_comp[n].data+z->img_comp[n].w2*y2+x2, z->img_comp[n].w2, data);
+                    }
+                }
+            }
+        }
+    }
+    return 1;
+}
+
+// at most this many tasks are handed to the parallel_for hook per scan; each
+// one decodes a contiguous run of restart segments with its own decoder state
+#define STBI__JPEG_MAX_TASKS 64
+
+typedef struct
+{
+    stbi__jpeg *z;
+    stbi_uc **seg_begin, **seg_end; // entropy coded bytes of each segment, markers excluded
+    int segments, units, tasks;
+    int *ok;
+} stbi__jpeg_segments;
+
+static void stbi__jpeg_decode_segments(void *context, int task)
+{
+    stbi__jpeg_segments *p = (stbi__jpeg_segments *) context;
+    int base = p->segments / p->tasks, extra = p->segments % p->tasks;
+    int first = task * base + (task < extra ? task : extra);
+    int last  = first + base + (task < extra);
+    int k, ri = p->z->restart_interval;
+    stbi__context s;
+    stbi__jpeg *j = (stbi__jpeg *) stbi__malloc(sizeof(stbi__jpeg));
+    p->ok[task] = 0;
+    if (!j) return;
+    // private copy for the bit reader and dc predictors; tables and the output
+    // planes are shared read-only/disjointly with the other tasks
+    *j = *p->z;
+    j->s = &s;
+    for (k = first; k < last; ++k) {
+        int u0 = k * ri;
+        int u1 = u0 + ri < p->units ? u0 + ri : p->units;
+        stbi__start_mem(&s, p->seg_begin[k], (int) (p->seg_end[k] - p->seg_begin[k]));
+        stbi__jpeg_reset(j);
+        if (!stbi__jpeg_decode_units(j, u0, u1)) break;
+    }
+    p->ok[task] = (k == last);
+    STBI_FREE(j);
+}
+
+// splits a baseline scan at its restart markers and decodes the segments through
+// the parallel_for hook. returns -1 when the scan doesn't qualify (no hook, no
+// restart interval, not memory backed, or the markers don't match the image), in
+// which case nothing has been consumed and the serial path takes over.
+static int stbi__jpeg_parallel_scan(stbi__jpeg *z)
+{
+    stbi__jpeg_segments p;
+    stbi_uc *c, *end;
+    int k = 0, t, result = 1;
+
+    if (!stbi__jpeg_parallel_for || z->progressive || z->restart_interval == 0 || z->s->read_from_callbacks)
+        return -1;
+
+    if (z->scan_n == 1) {
+        int n = z->order[0];
+        p.units = ((z->img_comp[n].x+7) >> 3) * ((z->img_comp[n].y+7) >> 3);
+    } else {
+        p.units = z->img_mcu_x * z->img_mcu_y;
+    }
+    p.segments = (p.units + z->restart_interval - 1) / z->restart_interval;
+    if (p.segments < 2)
+        return -1;
+
+    p.z = z;
+    p.tasks = p.segments < STBI__JPEG_MAX_TASKS ? p.segments : STBI__JPEG_MAX_TASKS;
+    p.seg_begin = (stbi_uc **) stbi__malloc_mad2(p.segments, 2 * sizeof(stbi_uc *), 0);
+    p.ok = (int *) stbi__malloc_mad2(p.tasks, sizeof(int), 0);
+    if (!p.seg_begin || !p.ok) {
+        STBI_FREE(p.seg_begin);
+        STBI_FREE(p.ok);
+        return -1;
+    }
+    p.seg_end = p.seg_begin + p.segments;
+
+    // find the restart markers. the scan ends at the first other marker (or at
+    // the end of the buffer); 0xff00 is a stuffed 0xff and 0xff runs are fill.
+    c = z->s->img_buffer;
+    end = z->s->img_buffer_end;
+    p.seg_begin[0] = c;
+    while (c < end) {
+        stbi_uc *m;
+        if (*c != 0xff) { ++c; continue; }
+        m = c + 1;
+        while (m < end && *m == 0xff) ++m;
+        if (m == end) break;
+        if (*m == 0) { c = m + 1; continue; }
+        if (!STBI__RESTART(*m)) { c = m - 1; break; } // leave the last 0xff in front of the marker
+        if (++k == p.segments) break; // more segments than the image has units for
+        p.seg_end[k-1] = c;
+        p.seg_begin[k] = c = m + 1;
+    }
+    if (k + 1 != p.segments) {
+        STBI_FREE(p.seg_begin);
+        STBI_FREE(p.ok);
+        return -1;
+    }
+    p.seg_end[k] = c;
+
+    stbi__jpeg_parallel_for(stbi__jpeg_decode_segments, &p, p.tasks);
+    for (t = 0; t < p.tasks; ++t)
+        if (!p.ok[t]) result = stbi__err("bad restart segment", "Corrupt JPEG");
+
+    // resume after the scan, as if the serial decoder had run out of data there
+    z->s->img_buffer = c;
+    z->marker = STBI__MARKER_none;
+    STBI_FREE(p.seg_begin);
+    STBI_FREE(p.ok);
+    return result;
+}
+
 static int stbi__parse_entropy_coded_data(stbi__jpeg *z)
 {
+    int parallel;
     stbi__jpeg_reset(z);
+    parallel = stbi__jpeg_parallel_scan(z);
+    if (parallel >= 0)
+        return parallel;
     if (!z->progressive) {
         if (z->scan_n == 1) {
             int i,j;
@@ -3589,6 +3980,125 @@ static stbi_uc *stbi__resample_row_hv_2_simd(stbi_uc *out, stbi_uc *in_near, stb
 }
 #endif
 
+#ifdef STBI_AVX2
+static STBI__AVX2_TARGET stbi_uc *stbi__resample_row_h_2_avx2(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs)
+{
+    // need to generate two samples horizontally for every one in input
+    int i;
+    stbi_uc *input = in_near;
+
+    if (w == 1) {
+        // if only one sample, can't do any interpolation
+        out[0] = out[1] = input[0];
+        return out;
+    }
+
+    out[0] = input[0];
+    out[1] = stbi__div4(input[0]*3 + input[1] + 2);
+
+    // 16 pixels at a time; the loads of the neighbours stay inside the row
+    // since the last pixel is always left to the scalar tail.
+    for (i=1; i+16 < w; i += 16) {
+        __m256i prev = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (input + i - 1)));
+        __m256i curr = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (input + i)));
+        __m256i next = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (input + i + 1)));
+
+        // n = 3*cur + 2, then even = (n + prev) >> 2, odd = (n + next) >> 2
+        __m256i n    = _mm256_add_epi16(_mm256_add_epi16(curr, _mm256_slli_epi16(curr, 1)), _mm256_set1_epi16(2));
+        __m256i even = _mm256_srli_epi16(_mm256_add_epi16(n, prev), 2);
+        __m256i odd  = _mm256_srli_epi16(_mm256_add_epi16(n, next), 2);
+
+        // interleave within each lane; packing per lane then puts the
+        // outputs of pixels 0..7 in the low half and 8..15 in the high half.
+        __m256i int0 = _mm256_unpacklo_epi16(even, odd);
+        __m256i int1 = _mm256_unpackhi_epi16(even, odd);
+        _mm256_storeu_si256((__m256i *) (out + i*2), _mm256_packus_epi16(int0, int1));
+    }
+
+    for (; i < w-1; ++i) {
+        int n = 3*input[i]+2;
+        out[i*2+0] = stbi__div4(n+input[i-1]);
+        out[i*2+1] = stbi__div4(n+input[i+1]);
+    }
+    out[i*2+0] = stbi__div4(input[w-2]*3 + input[w-1] + 2);
+    out[i*2+1] = input[w-1];
+
+    STBI_NOTUSED(in_far);
+    STBI_NOTUSED(hs);
+
+    return out;
+}
+
+static STBI__AVX2_TARGET stbi_uc *stbi__resample_row_hv_2_avx2(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs)
+{
+    // need to generate 2x2 samples for every one in input
+    int i=0,t0,t1;
+
+    if (w == 1) {
+        out[0] = out[1] = stbi__div4(3*in_near[0] + in_far[0] + 2);
+        return out;
+    }
+
+    t1 = 3*in_near[0] + in_far[0];
+    // same scheme as the sse2 version, 16 pixels per iteration. as there,
+    // the last pixel in a row is left to the scalar code.
+    for (; i < ((w-1) & ~15); i += 16) {
+        // vertical pass, 3*x + y = 4*x + (y - x)
+        __m256i farw  = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (in_far + i)));
+        __m256i nearw = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) (in_near + i)));
+        __m256i diff  = _mm256_sub_epi16(farw, nearw);
+        __m256i nears = _mm256_slli_epi16(nearw, 2);
+        __m256i curr  = _mm256_add_epi16(nears, diff); // current row
+
+        // shift the row by one pixel across the 128-bit lane boundary:
+        // alignr works per lane, so feed it the neighbouring lane.
+        __m256i lo0  = _mm256_permute2x128_si256(curr, curr, 0x08); // 0 | curr.lo
+        __m256i hi0  = _mm256_permute2x128_si256(curr, curr, 0x81); // curr.hi | 0
+        __m256i prv0 = _mm256_alignr_epi8(curr, lo0, 14);
+        __m256i nxt0 = _mm256_alignr_epi8(hi0, curr, 2);
+        __m256i prev = _mm256_insert_epi16(prv0, t1, 0);
+        __m256i next = _mm256_insert_epi16(nxt0, 3*in_near[i+16] + in_far[i+16], 15);
+
+        // horizontal filter, polyphase:
+        // even pixels = cur*4 + (prev - cur), odd pixels = cur*4 + (next - cur)
+        __m256i bias = _mm256_set1_epi16(8);
+        __m256i curs = _mm256_slli_epi16(curr, 2);
+        __m256i prvd = _mm256_sub_epi16(prev, curr);
+        __m256i nxtd = _mm256_sub_epi16(next, curr);
+        __m256i curb = _mm256_add_epi16(curs, bias);
+        __m256i even = _mm256_add_epi16(prvd, curb);
+        __m256i odd  = _mm256_add_epi16(nxtd, curb);
+
+        // interleave even and odd pixels, then undo scaling. packing is per
+        // lane, which is exactly the output order here.
+        __m256i int0 = _mm256_unpacklo_epi16(even, odd);
+        __m256i int1 = _mm256_unpackhi_epi16(even, odd);
+        __m256i de0  = _mm256_srli_epi16(int0, 4);
+        __m256i de1  = _mm256_srli_epi16(int1, 4);
+        _mm256_storeu_si256((__m256i *) (out + i*2), _mm256_packus_epi16(de0, de1));
+
+        // "previous" value for next iter
+        t1 = 3*in_near[i+15] + in_far[i+15];
+    }
+
+    t0 = t1;
+    t1 = 3*in_near[i] + in_far[i];
+    out[i*2] = stbi__div16(3*t1 + t0 + 8);
+
+    for (++i; i < w; ++i) {
+        t0 = t1;
+        t1 = 3*in_near[i]+in_far[i];
+        out[i*2-1] = stbi__div16(3*t0 + t1 + 8);
+        out[i*2  ] = stbi__div16(3*t1 + t0 + 8);
+    }
+    out[w*2-1] = stbi__div4(t1+2);
+
+    STBI_NOTUSED(hs);
+
+    return out;
+}
+#endif
+
 static stbi_uc *stbi__resample_row_generic(stbi_uc *out, stbi_uc *in_near, stbi_uc *in_far, int w, int hs)
 {
     // resample with nearest-neighbor
@@ -3763,25 +4273,102 @@ static void stbi__YCbCr_to_RGB_simd(stbi_uc *out, stbi_uc const *y, stbi_uc cons
 }
 #endif
 
+#ifdef STBI_AVX2
+static STBI__AVX2_TARGET void stbi__YCbCr_to_RGB_avx2(stbi_uc *out, stbi_uc const *y, stbi_uc const *pcb, stbi_uc const *pcr, int count, int step)
+{
+    int i = 0;
+
+    // same fixed-point math as the sse2 path, 16 pixels per iteration; the
+    // remainder (and step != 4) goes through the sse2 version.
+    if (step == 4) {
+        __m128i signflip  = _mm_set1_epi8(-0x80);
+        __m256i cr_const0 = _mm256_set1_epi16(   (short) ( 1.40200f*4096.0f+0.5f));
+        __m256i cr_const1 = _mm256_set1_epi16( - (short) ( 0.71414f*4096.0f+0.5f));
+        __m256i cb_const0 = _mm256_set1_epi16( - (short) ( 0.34414f*4096.0f+0.5f));
+        __m256i cb_const1 = _mm256_set1_epi16(   (short) ( 1.77200f*4096.0f+0.5f));
+        __m256i y_bias = _mm256_set1_epi16(8);
+        __m256i xw = _mm256_set1_epi16(255); // alpha channel
+
+        for (; i+15 < count; i += 16) {
+            // load
+            __m128i y_bytes = _mm_loadu_si128((const __m128i *) (y+i));
+            __m128i cr_biased = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (pcr+i)), signflip); // -128
+            __m128i cb_biased = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (pcb+i)), signflip); // -128
+
+            // widen to short: y*16 + 8 and cr, cb << 8, the values the sse2
+            // path gets from its byte unpacks
+            __m256i yws = _mm256_add_epi16(_mm256_slli_epi16(_mm256_cvtepu8_epi16(y_bytes), 4), y_bias);
+            __m256i crw = _mm256_slli_epi16(_mm256_cvtepi8_epi16(cr_biased), 8);
+            __m256i cbw = _mm256_slli_epi16(_mm256_cvtepi8_epi16(cb_biased), 8);
+
+            // color transform
+            __m256i cr0 = _mm256_mulhi_epi16(cr_const0, crw);
+            __m256i cb0 = _mm256_mulhi_epi16(cb_const0, cbw);
+            __m256i cb1 = _mm256_mulhi_epi16(cbw, cb_const1);
+            __m256i cr1 = _mm256_mulhi_epi16(crw, cr_const1);
+            __m256i rws = _mm256_add_epi16(cr0, yws);
+            __m256i gwt = _mm256_add_epi16(cb0, yws);
+            __m256i bws = _mm256_add_epi16(yws, cb1);
+            __m256i gws = _mm256_add_epi16(gwt, cr1);
+
+            // descale
+            __m256i rw = _mm256_srai_epi16(rws, 4);
+            __m256i bw = _mm256_srai_epi16(bws, 4);
+            __m256i gw = _mm256_srai_epi16(gws, 4);
+
+            // back to byte, set up for transpose (per lane: pixels 0-7 | 8-15)
+            __m256i brb = _mm256_packus_epi16(rw, bw);
+            __m256i gxb = _mm256_packus_epi16(gw, xw);
+
+            // transpose to interleave channels
+            __m256i t0 = _mm256_unpacklo_epi8(brb, gxb);
+            __m256i t1 = _mm256_unpackhi_epi8(brb, gxb);
+            __m256i o0 = _mm256_unpacklo_epi16(t0, t1); // pixels 0-3 | 8-11
+            __m256i o1 = _mm256_unpackhi_epi16(t0, t1); // pixels 4-7 | 12-15
+
+            // store
+            _mm256_storeu_si256((__m256i *) (out + 0), _mm256_permute2x128_si256(o0, o1, 0x20));
+            _mm256_storeu_si256((__m256i *) (out + 32), _mm256_permute2x128_si256(o0, o1, 0x31));
+            out += 64;
+        }
+    }
+
+    if (i < count)
+        stbi__YCbCr_to_RGB_simd(out, y+i, pcb+i, pcr+i, count-i, step);
+}
+#endif
+
 // set up the kernels
 static void stbi__setup_jpeg(stbi__jpeg *j)
 {
     j->idct_block_kernel = stbi__idct_block;
     j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_row;
     j->resample_row_hv_2_kernel = stbi__resample_row_hv_2;
+    j->resample_row_h_2_kernel = stbi__resample_row_h_2;
 
 #ifdef STBI_SSE2
-    if (stbi__sse2_available()) {
+    if (stbi__jpeg_simd_level >= STBI_SIMD_SSE2 && stbi__sse2_available()) {
         j->idct_block_kernel = stbi__idct_simd;
         j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_simd;
         j->resample_row_hv_2_kernel = stbi__resample_row_hv_2_simd;
     }
 #endif
 
+#ifdef STBI_AVX2
+    if (stbi__jpeg_simd_level >= STBI_SIMD_AVX2 && stbi__sse2_available() && stbi__avx2_available()) {
+        j->idct_block_kernel = stbi__idct_avx2;
+        j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_avx2;
+        j->resample_row_hv_2_kernel = stbi__resample_row_hv_2_avx2;
+        j->resample_row_h_2_kernel = stbi__resample_row_h_2_avx2;
+    }
+#endif
+
 #ifdef STBI_NEON
-    j->idct_block_kernel = stbi__idct_simd;
-   j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_simd;
-   j->resample_row_hv_2_kernel = stbi__resample_row_hv_2_simd;
+    if (stbi__jpeg_simd_level >= STBI_SIMD_SSE2) {
+        j->idct_block_kernel = stbi__idct_simd;
+        j->YCbCr_to_RGB_kernel = stbi__YCbCr_to_RGB_simd;
+        j->resample_row_hv_2_kernel = stbi__resample_row_hv_2_simd;
+    }
 #endif
 }
 
@@ -3859,7 +4446,7 @@ static stbi_uc *load_jpeg_image(stbi__jpeg *z, int *out_x, int *out_y, int *comp
 
             if      (r->hs == 1 && r->vs == 1) r->resample = resample_row_1;
             else if (r->hs == 1 && r->vs == 2) r->resample = stbi__resample_row_v_2;
-            else if (r->hs == 2 && r->vs == 1) r->resample = stbi__resample_row_h_2;
+            else if (r->hs == 2 && r->vs == 1) r->resample = z->resample_row_h_2_kernel;
             else if (r->hs == 2 && r->vs == 2) r->resample = z->resample_row_hv_2_kernel;
             else                               r->resample = stbi__resample_row_generic;
         }
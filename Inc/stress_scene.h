@@ -0,0 +1,91 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_STRESS_SCENE_H
+#define OPENGL_PRACTICE_STRESS_SCENE_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// how big a generated scene is: the terrain grid's size, how many blobs stand on it, how many instances of the
+// model stand behind it and how many different textures the blobs go through
+struct StressSceneConfig {
+    int gridDim = 16;
+    int blobs = 1;
+    int models = 0;
+    int textures = 1;
+};
+
+// what a headless run of one configuration measured, averaged over its frames after the first tenth
+struct StressSceneResult {
+    int frames = 0;
+    // issuing the frame's commands, without waiting for the GPU
+    double cpuMs = 0.0;
+    double cpuP99Ms = 0.0;
+    // the frame's GPU time from timer queries, 0 without them
+    double gpuMs = 0.0;
+    // the whole frame, waiting for the GPU included
+    double frameMs = 0.0;
+    unsigned int drawCalls = 0;
+    size_t triangles = 0;
+    // GpuResidency's high water mark, and the process's peak resident set
+    size_t gpuBytes = 0;
+    size_t peakResidentBytes = 0;
+};
+
+// parses a comma separated list of values of at least minimum ("16,64,256"), false if anything else is in it
+bool ParseStressValues(const char *text, int minimum, std::vector<int> &values);
+
+// every combination of the values of the four axes, the last one changing fastest
+std::vector<StressSceneConfig> StressSweepConfigs(const std::vector<int> &gridDims, const std::vector<int> &blobs,
+                                                  const std::vector<int> &models, const std::vector<int> &textures);
+
+// appends a row for the run to a CSV file, writing the header first if the file is new or empty
+bool AppendStressCsv(const std::string &path, const StressSceneConfig &config, const StressSceneResult &result);
+
+// Runs command (the executable and the options all runs share, one argument each) once per configuration, each with
+// that configuration's sizes and --csv path added, so every run appends its row. The arguments go to the process as
+// they are, never through a shell. A process per run keeps the memory columns each configuration's own, and a
+// configuration too big for the machine doesn't end the sweep. Returns the failed runs.
+int RunStressSweep(const std::vector<std::string> &command, const std::vector<StressSceneConfig> &configs,
+                   const std::string &csvPath);
+
+// the most memory this process ever had resident, 0 where that can't be asked
+size_t PeakResidentBytes();
+
+// The parts of a generated scene that the main scene doesn't have: where the blobs and model instances stand, and
+// the extra textures, made up as coloured checkerboards so no image files are needed. They're tracked by
+// GpuResidency (regenerated if evicted) like any other texture.
+class StressScene {
+public:
+    // texture is the first of the blobs' textures; config.textures - 1 more are generated
+    void Create(const StressSceneConfig &config, unsigned int texture);
+
+    int Blobs() const { return config.blobs; }
+    int Models() const { return config.models; }
+
+    // where blob i stands in the blobs' model space, relative to where the single blob of the main scene stands:
+    // a square of them centered there
+    glm::vec3 BlobOffset(int i) const;
+    // the texture blob i is drawn with, cycling through all of them
+    unsigned int BlobTexture(int i) const { return textures[(size_t)i % textures.size()]; }
+
+    // the model matrix of model instance i: a row of them behind the grid
+    glm::mat4 ModelTransform(int i) const;
+
+    // deletes the generated textures (not the first one, which isn't the scene's)
+    void del();
+
+private:
+    StressSceneConfig config;
+    // blobs per row of the square
+    int side = 1;
+    std::vector<unsigned int> textures;
+};
+
+#endif //OPENGL_PRACTICE_STRESS_SCENE_H
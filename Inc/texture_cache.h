@@ -0,0 +1,58 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_TEXTURE_CACHE_H
+#define OPENGL_PRACTICE_TEXTURE_CACHE_H
+
+#include <glad/glad.h>
+
+#include <string>
+#include <unordered_map>
+
+// resolves "directory/path" to an absolute, normalized path so that the same file reached through
+// different relative paths (e.g. "../Resources/a.jpg" and "../Resources/./a.jpg") maps to one cache entry.
+std::string CanonicalTexturePath(const char *path, const std::string &directory);
+
+// Process-wide texture registry. Textures are keyed by canonical path plus the parameters they were loaded with,
+// so every Model (and main.cpp) that asks for the same file shares a single GL texture.
+// Handles are reference counted: every Acquire must be matched by a Release, and the GL texture is deleted when the
+// last user releases it. Like every other GL object in the project it must only be used from the thread owning the context.
+class TextureCache {
+public:
+    // returns the single instance shared by the whole process
+    static TextureCache &Instance();
+
+    // returns the texture for path (relative to directory), loading it on first use. Increments its reference count.
+    // type is the material texture type, which can change the TextureQuality it loads with.
+    unsigned int Acquire(const char *path, const std::string &directory, bool gamma = false, int channels = 0,
+                         const std::string &type = "");
+
+    // adds a reference to a texture that was already acquired
+    void Retain(unsigned int id);
+
+    // drops a reference; the texture is evicted and deleted once nobody uses it anymore
+    void Release(unsigned int id);
+
+    // number of live references to a texture (0 if it isn't in the cache)
+    unsigned int RefCount(unsigned int id) const;
+
+    // number of distinct textures currently resident
+    size_t Size() const { return entries.size(); }
+
+private:
+    struct Entry {
+        unsigned int id;
+        unsigned int refCount;
+    };
+
+    TextureCache() = default;
+    TextureCache(const TextureCache &) = delete;
+    TextureCache &operator=(const TextureCache &) = delete;
+
+    // key -> texture, and texture id -> key so Release doesn't need the path
+    std::unordered_map<std::string, Entry> entries;
+    std::unordered_map<unsigned int, std::string> keys;
+};
+
+#endif //OPENGL_PRACTICE_TEXTURE_CACHE_H
@@ -0,0 +1,61 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_TEXTURE_COMPRESS_H
+#define OPENGL_PRACTICE_TEXTURE_COMPRESS_H
+
+#include <glad/glad.h>
+
+#include <vector>
+
+// block compressed formats aren't all part of the GL 3.3 core headers glad generates for us
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT        0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT       0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT       0x8C4C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM          0x8E8C
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM    0x8E8D
+#endif
+
+// BC1: rgb, 4 bpp         - diffuse/specular maps without alpha
+// BC3: rgba, 8 bpp        - maps with alpha
+// BC4: single channel     - ao/height maps
+// BC5: two channels       - tangent space normal maps (the shader rebuilds z from x and y)
+// BC7: rgba, 8 bpp        - high quality diffuse maps (GL 4.2 / ARB_texture_compression_bptc)
+enum BcFormat {
+    BC1,
+    BC3,
+    BC4,
+    BC5,
+    BC7
+};
+
+// the GL internal format used to upload blocks of the given format
+GLenum BcInternalFormat(BcFormat format, bool srgb);
+
+// size in bytes of a single 4x4 block
+unsigned int BcBlockBytes(BcFormat format);
+
+// size in bytes of a whole width x height image
+unsigned int BcImageBytes(BcFormat format, int width, int height);
+
+// true if the current GL context can sample textures with the given compressed internal format
+bool IsCompressedFormatSupported(GLenum internalFormat);
+
+// encodes a tightly packed RGBA8 image into 4x4 blocks. Rows of blocks are spread across the given number of
+// worker threads (0 uses every hardware thread). Images whose size isn't a multiple of 4 are padded by clamping.
+std::vector<unsigned char> CompressBc(const unsigned char *rgba, int width, int height, BcFormat format, int threads = 0);
+
+#endif //OPENGL_PRACTICE_TEXTURE_COMPRESS_H
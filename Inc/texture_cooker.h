@@ -0,0 +1,38 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_TEXTURE_COOKER_H
+#define OPENGL_PRACTICE_TEXTURE_COOKER_H
+
+#include <jpeg_writer.h>
+#include <texture_compress.h>
+
+#include <string>
+
+// what a texture is used for decides how it gets compressed
+enum TextureUsage {
+    TEXTURE_DIFFUSE,
+    TEXTURE_SPECULAR,
+    TEXTURE_NORMAL,
+    TEXTURE_AO
+};
+
+struct CookOptions {
+    bool srgb = false;          // diffuse maps hold sRGB colours
+    bool highQuality = true;    // BC7 for diffuse maps, otherwise BC1/BC3
+    int threads = 0;            // encoder threads, 0 uses every hardware thread
+};
+
+// picks the block format for a texture of the given usage
+BcFormat CookFormatFor(TextureUsage usage, bool hasAlpha, bool highQuality);
+
+// decodes source, builds its full mip chain, block compresses every level and writes the result as a KTX file.
+// TextureFromFile picks the file up automatically when it's written to CookedTexturePath(source).
+bool CookTexture(const std::string &source, const std::string &destination, TextureUsage usage, const CookOptions &options);
+
+// re-encodes an image as a baseline JPEG with restart markers, so the loader can decode it on several threads.
+// this is a lossy round trip, keep the quality high. source and destination may be the same file.
+bool RestartJpeg(const std::string &source, const std::string &destination, const JpegEncodeOptions &options);
+
+#endif //OPENGL_PRACTICE_TEXTURE_COOKER_H
@@ -0,0 +1,65 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_TEXTURE_QUALITY_H
+#define OPENGL_PRACTICE_TEXTURE_QUALITY_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// how much of a texture's resolution is uploaded. Every load path has a mip chain (cooked and cached files carry
+// one, fresh decodes are filtered by BuildMipChain), so lowering the quality just skips its top levels.
+struct TextureQuality {
+    int skipLevels = 0;     // 0 full, 1 half, 2 quarter resolution ...
+    int maxDimension = 0;   // then keeps skipping until neither side is larger than this, 0 for no cap
+
+    bool operator==(const TextureQuality &other) const { return skipLevels == other.skipLevels && maxDimension == other.maxDimension; }
+    bool operator!=(const TextureQuality &other) const { return !(*this == other); }
+
+    // number of top levels to skip in a chain of `levels` levels starting at width x height (at least one level stays)
+    int FirstLevel(int width, int height, int levels) const;
+
+    // short form for cache keys and messages, e.g. "half" or "full/1024"
+    std::string Name() const;
+};
+
+// parses "full", "half", "quarter", "eighth", a maximum dimension ("1024"), or a tier with a cap ("half/1024").
+// Returns false (leaving quality untouched) on anything else.
+bool ParseTextureQuality(const std::string &text, TextureQuality &quality);
+
+// The process-wide quality setting, plus per-asset overrides so that e.g. normal maps can stay sharper than
+// the diffuse maps on a low-memory machine. An override matches either a material texture type
+// ("texture_normal", as in Mesh::Draw) or a substring of the texture's path; path overrides win over type
+// overrides, and later ones win over earlier ones of the same kind.
+class TextureQualitySettings {
+public:
+    // returns the single instance shared by the whole process
+    static TextureQualitySettings &Instance();
+
+    void SetDefault(const TextureQuality &quality) { defaultQuality = quality; }
+    const TextureQuality &Default() const { return defaultQuality; }
+
+    void SetTypeOverride(const std::string &type, const TextureQuality &quality);
+    void SetPathOverride(const std::string &pattern, const TextureQuality &quality);
+    void ClearOverrides();
+
+    // reads overrides from a text file, one "<type or path pattern> <quality>" per line, '#' starts a comment.
+    // Patterns starting with "texture_" are types. Returns false if the file can't be opened.
+    bool LoadOverrides(const std::string &filename);
+
+    // the quality a texture loads with
+    TextureQuality For(const std::string &path, const std::string &type) const;
+
+private:
+    TextureQualitySettings() = default;
+    TextureQualitySettings(const TextureQualitySettings &) = delete;
+    TextureQualitySettings &operator=(const TextureQualitySettings &) = delete;
+
+    TextureQuality defaultQuality;
+    std::vector<std::pair<std::string, TextureQuality>> typeOverrides;
+    std::vector<std::pair<std::string, TextureQuality>> pathOverrides;
+};
+
+#endif //OPENGL_PRACTICE_TEXTURE_QUALITY_H
@@ -0,0 +1,95 @@
+//
+// Created on 2026-10-18.
+//
+
+#ifndef OPENGL_PRACTICE_TEXTURE_STREAMER_H
+#define OPENGL_PRACTICE_TEXTURE_STREAMER_H
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <ktx.h>
+#include <texture_quality.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// levels at least this small (in both dimensions) are uploaded as soon as a texture is registered
+const int STREAM_INITIAL_SIZE = 64;
+// how many bytes of mip data Update reads and uploads per frame by default
+const size_t STREAM_UPLOAD_BYTES = 4 * 1024 * 1024;
+// a texture nobody asked for during this many frames only keeps its initial levels
+const unsigned int STREAM_GRACE_FRAMES = 60;
+
+// number of pixels a sphere covers vertically on screen, used to estimate which mip level a texture needs
+float ProjectedSize(const glm::vec3 &center, float radius, const glm::vec3 &cameraPosition, float fovY, int viewportHeight);
+
+// Streams the mip levels of cooked (KTX) textures under a fixed memory budget.
+// A registered texture starts out with only its smallest levels; every frame the renderer reports how large each
+// texture appears on screen and Update uploads the next finer level of the textures that need it most, evicting
+// the finest levels of textures that are seen small (or not at all) whenever the budget would be exceeded.
+// GL textures keep their id the whole time, only GL_TEXTURE_BASE_LEVEL moves.
+class TextureStreamer {
+public:
+    // returns the single instance shared by the whole process
+    static TextureStreamer &Instance();
+
+    // byte budget for all streamed textures. 0 (the default) disables streaming: cooked textures are uploaded whole.
+    void SetBudget(size_t bytes) { budget = bytes; }
+    size_t Budget() const { return budget; }
+    bool Enabled() const { return budget > 0; }
+    size_t ResidentBytes() const { return residentBytes; }
+
+    // takes over the cooked texture at ktxPath and uploads its initial levels into textureID. Levels finer than the
+    // quality allows are never streamed in, and the levels are sampled as sRGB when srgb is set (see MatchKtxColorSpace).
+    // Returns false if the file can't be streamed (missing, unsupported format, no variant for srgb), leaving textureID
+    // untouched.
+    bool Register(unsigned int textureID, const std::string &ktxPath, const TextureQuality &quality = TextureQuality(),
+                  bool srgb = false);
+    void Unregister(unsigned int textureID);
+
+    // reports that the texture covers about `pixels` pixels on screen this frame. Unknown textures are ignored.
+    void RequestScreenSize(unsigned int textureID, float pixels);
+
+    // uploads wanted levels and evicts unwanted ones; call once per frame, after that frame's requests
+    void Update(size_t maxUploadBytes = STREAM_UPLOAD_BYTES);
+
+    // finest level currently uploaded, -1 if the texture isn't streamed
+    int ResidentLevel(unsigned int textureID) const;
+
+private:
+    struct StreamedTexture {
+        std::string path;
+        KtxImage layout;                    // format and size, levels are never kept in memory
+        std::vector<KtxLevelRange> ranges;
+        int finestLevel;                    // finest level the TextureQuality allows
+        int initialLevel;                   // coarsest level that is always resident
+        int residentLevel;                  // finest level uploaded
+        int wantedLevel;                    // finest level requested in the last frame it was seen
+        unsigned int lastRequested;         // frame of the last request
+    };
+
+    TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer &) = delete;
+    TextureStreamer &operator=(const TextureStreamer &) = delete;
+
+    // level the texture should have right now
+    int targetLevel(const StreamedTexture &texture) const;
+    // texture whose finest level should go first, or 0 if nothing can be evicted
+    unsigned int pickVictim(unsigned int keep) const;
+    // reads one level of the texture's file, false (and why) if it can't
+    bool readLevel(const StreamedTexture &texture, int level, std::vector<unsigned char> &data);
+    // uploads the next finer level, read by readLevel, and counts it
+    void uploadLevel(unsigned int textureID, StreamedTexture &texture, const std::vector<unsigned char> &data);
+    void evictLevel(unsigned int textureID, StreamedTexture &texture);
+    // reports the resident levels' size to GpuResidency
+    void residencyResize(unsigned int textureID, const StreamedTexture &texture);
+
+    std::unordered_map<unsigned int, StreamedTexture> textures;
+    size_t budget = 0;
+    size_t residentBytes = 0;
+    unsigned int frame = 0;
+};
+
+#endif //OPENGL_PRACTICE_TEXTURE_STREAMER_H
@@ -0,0 +1,13 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoord;
+in vec4 Colour;
+
+// one channel font atlas, glyph pixels are 1
+uniform sampler2D font;
+
+void main()
+{
+    FragColor = vec4(Colour.rgb, Colour.a * texture(font, TexCoord).r);
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#version 330 core
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aColour;
+
+out vec2 TexCoord;
+out vec4 Colour;
+
+// in pixels, with the origin in the top left corner
+uniform vec2 viewport;
+
+void main()
+{
+    gl_Position = vec4(aPos.x / viewport.x * 2.0 - 1.0, 1.0 - aPos.y / viewport.y * 2.0, 0.0, 1.0);
+    TexCoord = aTexCoord;
+    Colour = aColour;
+}
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+// shader_model.frag with the texture read from a layer of one of MaterialPacker's arrays
+uniform sampler2DArray texture_diffuse1;
+uniform int texture_diffuse1_layer;
+
+void main()
+{
+    FragColor = texture(texture_diffuse1, vec3(TexCoords, texture_diffuse1_layer));
+}
\ No newline at end of file
@@ -0,0 +1,8 @@
+#version 330 core
+out vec4 FragColor;
+
+// every fragment adds one to the overdraw counter (blending is additive while counting)
+void main()
+{
+    FragColor = vec4(1.0, 0.0, 0.0, 0.0);
+}
\ No newline at end of file
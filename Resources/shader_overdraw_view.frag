@@ -0,0 +1,16 @@
+#version 330 core
+out vec4 FragColor;
+
+// fragments drawn per pixel, the same size as the viewport
+uniform sampler2D counts;
+
+void main()
+{
+    float count = texelFetch(counts, ivec2(gl_FragCoord.xy), 0).r;
+    // black for nothing, then blue (1), green (2), yellow (3) and red for 4 or more
+    vec3 colour = count < 0.5 ? vec3(0.0) :
+                  count < 1.5 ? vec3(0.1, 0.2, 0.9) :
+                  count < 2.5 ? vec3(0.1, 0.8, 0.2) :
+                  count < 3.5 ? vec3(0.9, 0.8, 0.1) : vec3(0.9, 0.1, 0.1);
+    FragColor = vec4(colour, 1.0);
+}
\ No newline at end of file
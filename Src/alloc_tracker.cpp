@@ -0,0 +1,182 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <alloc_tracker.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static const char *const ALLOC_SUBSYSTEM_NAMES[ALLOC_SUBSYSTEM_COUNT] = {"other", "render", "models", "textures",
+                                                                           "streaming", "profiler", "recording"};
+
+// plain thread locals, so the hook can read them without allocating or taking a lock
+static thread_local AllocSubsystem currentSubsystem = ALLOC_OTHER;
+// set on the thread AssertSteadyState was called from
+static thread_local bool assertThread = false;
+// the assertion's message must not count itself
+static thread_local bool reporting = false;
+
+AllocTracker &AllocTracker::Instance()
+{
+    // constant initialized (only atomics and plain counters), so the hook can use it before main and from the
+    // static initializers of other files
+    static AllocTracker tracker;
+    return tracker;
+}
+
+void AllocTracker::Enable()
+{
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void AllocTracker::Count(size_t size)
+{
+    if (!enabled.load(std::memory_order_relaxed) || reporting)
+        return;
+    AllocSubsystem subsystem = currentSubsystem;
+    allocations[subsystem].fetch_add(1, std::memory_order_relaxed);
+    bytes[subsystem].fetch_add(size, std::memory_order_relaxed);
+    if (!inFrame.load(std::memory_order_relaxed))
+        return;
+    frameAllocations.fetch_add(1, std::memory_order_relaxed);
+    frameBytes.fetch_add(size, std::memory_order_relaxed);
+    if (assertThread && frames >= assertFrom && subsystem != ALLOC_RECORDING)
+    {
+        reporting = true;
+        std::fprintf(stderr, "Alloc: %zu bytes allocated (%s) in frame %u of the steady-state render loop\n", size,
+                     ALLOC_SUBSYSTEM_NAMES[subsystem], frames);
+        std::abort();
+    }
+}
+
+void AllocTracker::BeginFrame()
+{
+    if (inFrame.load(std::memory_order_relaxed))
+    {
+        uint64_t count = frameAllocations.exchange(0, std::memory_order_relaxed);
+        frameBytesTotal += frameBytes.exchange(0, std::memory_order_relaxed);
+        frameAllocationsTotal += count;
+        lastFrameAllocations = count;
+        if (count > 0)
+            allocatingFrames++;
+        if (count > maxFrameAllocations)
+        {
+            maxFrameAllocations = count;
+            maxFrame = frames;
+        }
+        frames++;
+    }
+    inFrame.store(true, std::memory_order_relaxed);
+}
+
+void AllocTracker::EndFrames()
+{
+    // closes the last frame
+    BeginFrame();
+    inFrame.store(false, std::memory_order_relaxed);
+    frameAllocations.store(0, std::memory_order_relaxed);
+    frameBytes.store(0, std::memory_order_relaxed);
+    assertFrom = ~0u;
+    assertThread = false;
+}
+
+void AllocTracker::AssertSteadyState(unsigned int firstFrame)
+{
+    assertFrom = firstFrame;
+    assertThread = true;
+}
+
+AllocCounts AllocTracker::Subsystem(AllocSubsystem subsystem) const
+{
+    AllocCounts counts;
+    counts.allocations = allocations[subsystem].load(std::memory_order_relaxed);
+    counts.bytes = bytes[subsystem].load(std::memory_order_relaxed);
+    return counts;
+}
+
+void AllocTracker::Print()
+{
+    if (!Enabled())
+        return;
+    std::printf("allocations: %u frames, %u of them allocated, %.1f per frame (%.1f kb), most %llu in frame %u, %llu in the last\n",
+                frames, allocatingFrames, frames > 0 ? (double)frameAllocationsTotal / frames : 0.0,
+                frames > 0 ? (double)frameBytesTotal / 1024.0 / frames : 0.0, (unsigned long long)maxFrameAllocations,
+                maxFrame, (unsigned long long)lastFrameAllocations);
+    for (int subsystem = 0; subsystem < ALLOC_SUBSYSTEM_COUNT; subsystem++)
+    {
+        AllocCounts counts = Subsystem((AllocSubsystem)subsystem);
+        std::printf("  %-10s %10llu allocations %12.1f kb\n", ALLOC_SUBSYSTEM_NAMES[subsystem],
+                    (unsigned long long)counts.allocations, (double)counts.bytes / 1024.0);
+    }
+}
+
+AllocScope::AllocScope(AllocSubsystem subsystem) : previous(currentSubsystem)
+{
+    currentSubsystem = subsystem;
+}
+
+AllocScope::~AllocScope()
+{
+    currentSubsystem = previous;
+}
+
+#ifdef BLOB_SEA_PROFILE
+// the replacement global allocation functions: counted, then malloc and free. The array, sized and nothrow forms
+// all come here
+void *operator new(std::size_t size)
+{
+    AllocTracker::Instance().Count(size);
+    void *memory = std::malloc(size > 0 ? size : 1);
+    if (!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    AllocTracker::Instance().Count(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &nothrow) noexcept
+{
+    return operator new(size, nothrow);
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, const std::nothrow_t &) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void *memory, const std::nothrow_t &) noexcept
+{
+    std::free(memory);
+}
+#endif
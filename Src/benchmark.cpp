@@ -0,0 +1,171 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+static double timeCall(const BenchmarkBody &body, size_t operations)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    body(operations);
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// median of sorted values
+static double median(const std::vector<double> &sorted)
+{
+    size_t n = sorted.size();
+    if (n == 0)
+        return 0.0;
+    return n % 2 ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+}
+
+BenchmarkResult RunBenchmark(const std::string &name, const BenchmarkBody &body, const BenchmarkOptions &options)
+{
+    BenchmarkResult result;
+    result.name = name;
+
+    // calibrate: grow the operations per call until a call takes sampleMs, jumping straight there once a call takes
+    // long enough for its time to mean something. This is the first part of the warmup
+    size_t operations = 1;
+    double warmedUp = 0.0;
+    for (;;)
+    {
+        double ms = timeCall(body, operations);
+        warmedUp += ms;
+        if (ms >= options.sampleMs)
+            break;
+        if (ms > options.sampleMs / 16.0)
+            operations = std::max(operations + 1, (size_t)((double)operations * options.sampleMs / ms));
+        else
+            operations *= 2;
+    }
+    while (warmedUp < options.warmupMs)
+        warmedUp += timeCall(body, operations);
+
+    std::vector<double> samples(std::max(1u, options.repetitions));
+    for (double &sample : samples)
+        sample = timeCall(body, operations) * 1e6 / (double)operations;
+
+    double total = 0.0;
+    for (double sample : samples)
+        total += sample;
+    std::sort(samples.begin(), samples.end());
+
+    result.operations = operations;
+    result.samples = (unsigned int)samples.size();
+    result.medianNs = median(samples);
+    // nearest rank
+    result.p99Ns = samples[(size_t)std::ceil(0.99 * (double)samples.size()) - 1];
+    result.minNs = samples.front();
+    result.meanNs = total / (double)samples.size();
+
+    std::vector<double> deviations;
+    deviations.reserve(samples.size());
+    for (double sample : samples)
+        deviations.push_back(std::fabs(sample - result.medianNs));
+    std::sort(deviations.begin(), deviations.end());
+    result.madNs = median(deviations);
+    return result;
+}
+
+bool WriteBenchmarkJson(const std::string &path, const std::vector<BenchmarkResult> &results)
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        std::cout << "Benchmark: can't write " << path << std::endl;
+        return false;
+    }
+    file << "{\"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchmarkResult &result = results[i];
+        // names are the bench's own identifiers, nothing needs escaping
+        file << "{\"name\": \"" << result.name << "\", \"operations\": " << result.operations
+             << ", \"samples\": " << result.samples << ", \"median_ns\": " << result.medianNs
+             << ", \"p99_ns\": " << result.p99Ns << ", \"min_ns\": " << result.minNs
+             << ", \"mean_ns\": " << result.meanNs << ", \"mad_ns\": " << result.madNs << "}"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "]}\n";
+    return (bool)file;
+}
+
+// the number after "key": in line, or false if it isn't there
+static bool readNumber(const std::string &line, const char *key, double &value)
+{
+    std::string quoted = std::string("\"") + key + "\":";
+    size_t at = line.find(quoted);
+    if (at == std::string::npos)
+        return false;
+    value = std::strtod(line.c_str() + at + quoted.size(), nullptr);
+    return true;
+}
+
+bool ReadBenchmarkJson(const std::string &path, std::vector<BenchmarkResult> &results)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cout << "Benchmark: can't read " << path << std::endl;
+        return false;
+    }
+    results.clear();
+    std::string line;
+    while (std::getline(file, line))
+    {
+        size_t at = line.find("\"name\": \"");
+        if (at == std::string::npos)
+            continue;
+        at += std::strlen("\"name\": \"");
+        size_t end = line.find('"', at);
+        if (end == std::string::npos)
+            continue;
+
+        BenchmarkResult result;
+        result.name = line.substr(at, end - at);
+        if (!readNumber(line, "median_ns", result.medianNs))
+            continue;
+        readNumber(line, "p99_ns", result.p99Ns);
+        readNumber(line, "min_ns", result.minNs);
+        readNumber(line, "mean_ns", result.meanNs);
+        readNumber(line, "mad_ns", result.madNs);
+        results.push_back(result);
+    }
+    return true;
+}
+
+std::vector<BenchmarkRegression> CompareBenchmarks(const std::vector<BenchmarkResult> &baseline,
+                                                   const std::vector<BenchmarkResult> &current, double threshold)
+{
+    std::vector<BenchmarkRegression> regressions;
+    for (const BenchmarkResult &now : current)
+    {
+        for (const BenchmarkResult &before : baseline)
+        {
+            if (before.name != now.name || before.medianNs <= 0.0)
+                continue;
+            double slowdown = now.medianNs - before.medianNs;
+            if (slowdown > threshold * before.medianNs && slowdown > before.madNs + now.madNs)
+            {
+                BenchmarkRegression regression;
+                regression.name = now.name;
+                regression.baselineNs = before.medianNs;
+                regression.currentNs = now.medianNs;
+                regression.ratio = now.medianNs / before.medianNs;
+                regressions.push_back(regression);
+            }
+            break;
+        }
+    }
+    return regressions;
+}
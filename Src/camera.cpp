@@ -26,9 +26,101 @@ Camera::Camera(float posX, float posY, float posZ, float upX, float upY, float u
 }
 
 // returns the view matrix calculated using Euler Angles and the LookAt Matrix
-glm::mat4 Camera::GetViewMatrix()
+const glm::mat4 &Camera::GetViewMatrix()
 {
-    return glm::lookAt(Position, Position + Front, Up);
+    updateMatrices();
+    return view;
+}
+
+const glm::mat4 &Camera::GetProjectionMatrix()
+{
+    updateMatrices();
+    return projection;
+}
+
+const glm::mat4 &Camera::GetViewProjectionMatrix()
+{
+    updateMatrices();
+    return viewProjection;
+}
+
+const glm::mat4 &Camera::GetInverseViewMatrix()
+{
+    updateMatrices();
+    return inverseView;
+}
+
+const glm::mat4 &Camera::GetInverseProjectionMatrix()
+{
+    updateMatrices();
+    return inverseProjection;
+}
+
+const glm::mat4 &Camera::GetInverseViewProjectionMatrix()
+{
+    updateMatrices();
+    return inverseViewProjection;
+}
+
+const Frustum &Camera::GetFrustum()
+{
+    updateMatrices();
+    return frustum;
+}
+
+unsigned int Camera::Version()
+{
+    updateMatrices();
+    return version;
+}
+
+void Camera::SetViewport(int width, int height)
+{
+    if (width <= 0 || height <= 0)
+        return;
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+void Camera::SetClipPlanes(float nearPlane, float farPlane)
+{
+    this->nearPlane = nearPlane;
+    this->farPlane = farPlane;
+}
+
+// rebuilds whichever matrices are out of date
+void Camera::updateMatrices()
+{
+    float aspect = (float)viewportWidth / (float)viewportHeight;
+    bool viewChanged = !built || Position != builtPosition || Front != builtFront || Up != builtUp;
+    bool projectionChanged = !built || Zoom != builtZoom || aspect != builtAspect || nearPlane != builtNear || farPlane != builtFar;
+    if (!viewChanged && !projectionChanged)
+        return;
+
+    if (viewChanged)
+    {
+        view = glm::lookAt(Position, Position + Front, Up);
+        inverseView = glm::inverse(view);
+        builtPosition = Position;
+        builtFront = Front;
+        builtUp = Up;
+    }
+    if (projectionChanged)
+    {
+        projection = glm::perspective(glm::radians(Zoom), aspect, nearPlane, farPlane);
+        inverseProjection = glm::inverse(projection);
+        builtZoom = Zoom;
+        builtAspect = aspect;
+        builtNear = nearPlane;
+        builtFar = farPlane;
+    }
+    viewProjection = projection * view;
+    inverseViewProjection = inverseView * inverseProjection;
+    frustum = ExtractFrustum(viewProjection);
+    built = true;
+    // skip 0 on wrap around, so "never uploaded" can stay 0
+    if (++version == 0)
+        version = 1;
 }
 
 // processes input received from any keyboard-like input system. Accepts input parameter in the form of camera defined ENUM (to abstract it from windowing systems)
@@ -77,6 +169,16 @@ void Camera::ProcessMouseScroll(float yoffset)
         Zoom = 45.0f;
 }
 
+// puts the camera at a position with the given angles and field of view (recorded or authored camera paths)
+void Camera::SetPose(const glm::vec3 &position, float yaw, float pitch, float zoom)
+{
+    Position = position;
+    Yaw = yaw;
+    Pitch = pitch;
+    Zoom = zoom;
+    updateCameraVectors();
+}
+
 // calculates the front vector from the Camera's (updated) Euler Angles
 void Camera::updateCameraVectors()
 {
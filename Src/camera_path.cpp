@@ -0,0 +1,91 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <camera_path.h>
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+bool CameraPath::Load(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cout << "Camera path: can't read " << path << std::endl;
+        return false;
+    }
+    keys.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line))
+    {
+        lineNumber++;
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            continue;
+        std::istringstream fields(line);
+        CameraKey key;
+        if (!(fields >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.yaw >> key.pitch))
+        {
+            std::cout << "Camera path: " << path << ":" << lineNumber << " isn't \"time x y z yaw pitch [zoom]\"" << std::endl;
+            return false;
+        }
+        // zoom is optional, the camera's default field of view otherwise
+        if (!(fields >> key.zoom))
+            key.zoom = 45.0f;
+        if (!keys.empty() && key.time <= keys.back().time)
+        {
+            std::cout << "Camera path: " << path << ":" << lineNumber << " goes back in time" << std::endl;
+            return false;
+        }
+        keys.push_back(key);
+    }
+    if (keys.empty())
+        std::cout << "Camera path: no keyframes in " << path << std::endl;
+    return !keys.empty();
+}
+
+// cubic Hermite between p1 and p2 at u in [0, 1], with Catmull-Rom tangents for keyframes that aren't evenly spaced
+// in time: the slope through the neighbours, scaled to the segment's duration
+template<typename T>
+static T catmullRom(const T &p0, const T &p1, const T &p2, const T &p3, float t0, float t1, float t2, float t3, float u)
+{
+    float segment = t2 - t1;
+    T m1 = (p2 - p0) * (segment / (t2 - t0));
+    T m2 = (p3 - p1) * (segment / (t3 - t1));
+    float u2 = u * u, u3 = u2 * u;
+    return p1 * (2.0f * u3 - 3.0f * u2 + 1.0f) + m1 * (u3 - 2.0f * u2 + u) + p2 * (-2.0f * u3 + 3.0f * u2) + m2 * (u3 - u2);
+}
+
+CameraKey CameraPath::Sample(float t) const
+{
+    if (keys.empty())
+        return CameraKey();
+    if (t <= keys.front().time)
+        return keys.front();
+    if (t >= keys.back().time)
+        return keys.back();
+
+    size_t i = 1;
+    while (keys[i].time < t)
+        i++;
+    // the segment from k1 to k2, the ends repeat their keyframe
+    const CameraKey &k1 = keys[i - 1];
+    const CameraKey &k2 = keys[i];
+    const CameraKey &k0 = i >= 2 ? keys[i - 2] : k1;
+    const CameraKey &k3 = i + 1 < keys.size() ? keys[i + 1] : k2;
+    // a repeated end has no time before or after it, so its neighbour's segment length stands in
+    float t0 = &k0 == &k1 ? k1.time - (k2.time - k1.time) : k0.time;
+    float t3 = &k3 == &k2 ? k2.time + (k2.time - k1.time) : k3.time;
+    float u = (t - k1.time) / (k2.time - k1.time);
+
+    CameraKey key;
+    key.time = t;
+    key.position = catmullRom(k0.position, k1.position, k2.position, k3.position, t0, k1.time, k2.time, t3, u);
+    key.yaw = catmullRom(k0.yaw, k1.yaw, k2.yaw, k3.yaw, t0, k1.time, k2.time, t3, u);
+    key.pitch = glm::clamp(catmullRom(k0.pitch, k1.pitch, k2.pitch, k3.pitch, t0, k1.time, k2.time, t3, u), -89.0f, 89.0f);
+    key.zoom = glm::clamp(catmullRom(k0.zoom, k1.zoom, k2.zoom, k3.zoom, t0, k1.time, k2.time, t3, u), 1.0f, 45.0f);
+    return key;
+}
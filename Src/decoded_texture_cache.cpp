@@ -0,0 +1,108 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <decoded_texture_cache.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+// bump whenever what gets cached changes (mip filter, level layout), so stale entries stop matching
+static const unsigned long long CACHE_VERSION = 1;
+
+static unsigned long long mix(unsigned long long x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    x ^= x >> 33;
+    return x;
+}
+
+// 64 bit hash of the source bytes, eight at a time. It runs on every warm load, so it has to stay far cheaper
+// than the decode it saves; it only has to tell files apart, not resist attacks.
+static unsigned long long hashBytes(const unsigned char *data, size_t size, unsigned long long seed)
+{
+    const unsigned long long k = 0x9e3779b97f4a7c15ull;
+    unsigned long long h = seed ^ ((unsigned long long)size * k);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        unsigned long long word;
+        std::memcpy(&word, data + i, sizeof(word));
+        h = (h ^ mix(word)) * k;
+        h ^= h >> 29;
+    }
+    unsigned long long tail = 0;
+    std::memcpy(&tail, data + i, size - i);
+    return mix(h ^ mix(tail ^ k));
+}
+
+static bool makeDirectory(const std::string &path)
+{
+#ifdef _WIN32
+    _mkdir(path.c_str());
+#else
+    mkdir(path.c_str(), 0755);
+#endif
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && (info.st_mode & S_IFDIR) != 0;
+}
+
+DecodedTextureCache &DecodedTextureCache::Instance()
+{
+    static DecodedTextureCache instance;
+    return instance;
+}
+
+void DecodedTextureCache::SetDirectory(const std::string &path)
+{
+    directory = path;
+    directoryCreated = false;
+}
+
+std::string DecodedTextureCache::EntryPath(const unsigned char *source, size_t size, bool gamma, int channels) const
+{
+    if (!Enabled())
+        return std::string();
+    unsigned long long parameters = (CACHE_VERSION << 8) | ((unsigned long long)gamma << 4) | (unsigned long long)channels;
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.ktx", hashBytes(source, size, mix(parameters)));
+    return directory + '/' + name;
+}
+
+bool DecodedTextureCache::Store(const std::string &entryPath, const KtxImage &image)
+{
+    if (!Enabled())
+        return false;
+    if (!directoryCreated && !(directoryCreated = makeDirectory(directory)))
+    {
+        std::cout << "Texture cache: couldn't create " << directory << std::endl;
+        return false;
+    }
+
+    std::string temporary = entryPath + "." + std::to_string(getpid()) + ".tmp";
+    if (!WriteKtx(temporary, image))
+        return false;
+    // rename over an existing entry is atomic on POSIX, Windows' rename refuses to replace so clear the way first
+#ifdef _WIN32
+    std::remove(entryPath.c_str());
+#endif
+    if (std::rename(temporary.c_str(), entryPath.c_str()) != 0)
+    {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,49 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <frame_histogram.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void FrameHistogram::Add(float ms)
+{
+    // bucket i holds (MIN * 2^(i / PER_OCTAVE), MIN * 2^((i + 1) / PER_OCTAVE)], the first one everything shorter
+    unsigned int bucket = 0;
+    if (ms > FRAME_HISTOGRAM_MIN_MS)
+    {
+        float position = std::log2(ms / FRAME_HISTOGRAM_MIN_MS) * (float)FRAME_HISTOGRAM_BUCKETS_PER_OCTAVE;
+        bucket = (unsigned int)std::min((float)(BUCKETS - 1), std::ceil(position) - 1.0f);
+    }
+    buckets[bucket]++;
+    count++;
+    maximum = std::max(maximum, ms);
+}
+
+float FrameHistogram::Percentile(double p) const
+{
+    if (count == 0)
+        return 0.0f;
+    // nearest rank: the frame at this (1 based) rank in sorted order
+    uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(p * (double)count));
+    uint64_t seen = 0;
+    for (unsigned int i = 0; i < BUCKETS; i++)
+    {
+        seen += buckets[i];
+        // the last bucket has no top, everything longer is in it too
+        if (seen >= rank && i == BUCKETS - 1)
+            return maximum;
+        if (seen >= rank)
+            return std::min(maximum, FRAME_HISTOGRAM_MIN_MS * std::exp2((float)(i + 1) / (float)FRAME_HISTOGRAM_BUCKETS_PER_OCTAVE));
+    }
+    return maximum;
+}
+
+void FrameHistogram::Reset()
+{
+    std::memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    maximum = 0.0f;
+}
@@ -0,0 +1,316 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <frustum.h>
+#include <perf_counters.h>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FRUSTUM_SSE2
+#include <emmintrin.h>
+#endif
+
+// like the mip filters, the AVX loops are compiled with a target attribute (gcc/clang) and only picked at run time
+#if defined(FRUSTUM_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define FRUSTUM_AVX
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define FRUSTUM_AVX_TARGET
+#else
+#define FRUSTUM_AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+static bool cpuHasAvx()
+{
+#if defined(FRUSTUM_AVX) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+    return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#elif defined(FRUSTUM_AVX)
+    return __builtin_cpu_supports("avx");
+#else
+    return false;
+#endif
+}
+
+Frustum ExtractFrustum(const glm::mat4 &clip, bool normalize)
+{
+    // glm is column major: row i of the matrix is (clip[0][i], clip[1][i], clip[2][i], clip[3][i])
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++)
+        rows[i] = glm::vec4(clip[0][i], clip[1][i], clip[2][i], clip[3][i]);
+
+    Frustum frustum;
+    frustum.planes[0] = rows[3] + rows[0];
+    frustum.planes[1] = rows[3] - rows[0];
+    frustum.planes[2] = rows[3] + rows[1];
+    frustum.planes[3] = rows[3] - rows[1];
+    frustum.planes[4] = rows[3] + rows[2];
+    frustum.planes[5] = rows[3] - rows[2];
+    if (normalize)
+    {
+        for (glm::vec4 &plane : frustum.planes)
+            plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+Frustum TransformFrustum(const Frustum &frustum, const glm::mat4 &model)
+{
+    // a world space plane p becomes transpose(model) * p in object space
+    Frustum local;
+    for (int i = 0; i < 6; i++)
+        local.planes[i] = frustum.planes[i] * model;
+    return local;
+}
+
+bool SphereInFrustum(const Frustum &frustum, const glm::vec3 &center, float radius)
+{
+    for (const glm::vec4 &plane : frustum.planes)
+    {
+        if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            return false;
+    }
+    return true;
+}
+
+bool AabbInFrustum(const Frustum &frustum, const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+{
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f, extent = (boundsMax - boundsMin) * 0.5f;
+    for (const glm::vec4 &plane : frustum.planes)
+    {
+        glm::vec3 normal = glm::vec3(plane);
+        // the box's projection onto the normal reaches this far past its center
+        if (glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extent) < 0.0f)
+            return false;
+    }
+    return true;
+}
+
+void BoundingSpheres::Add(const glm::vec3 &center, float r)
+{
+    x.push_back(center.x);
+    y.push_back(center.y);
+    z.push_back(center.z);
+    radius.push_back(r);
+}
+
+void BoundingSpheres::Clear()
+{
+    x.clear();
+    y.clear();
+    z.clear();
+    radius.clear();
+}
+
+void BoundingBoxes::Add(const glm::vec3 &boundsMin, const glm::vec3 &boundsMax)
+{
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f, extent = (boundsMax - boundsMin) * 0.5f;
+    centerX.push_back(center.x);
+    centerY.push_back(center.y);
+    centerZ.push_back(center.z);
+    extentX.push_back(extent.x);
+    extentY.push_back(extent.y);
+    extentZ.push_back(extent.z);
+}
+
+void BoundingBoxes::Clear()
+{
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+}
+
+// appends the set bits of a test mask (bit k = object first + k) to the visible list
+static unsigned int *appendVisible(unsigned int *out, unsigned int first, int mask)
+{
+    while (mask != 0)
+    {
+        int bit = 0;
+        while (!(mask & (1 << bit)))
+            bit++;
+        *out++ = first + (unsigned int)bit;
+        mask &= mask - 1;
+    }
+    return out;
+}
+
+// the loops below test `start` onwards and return where they stopped writing; each handles the tail with the scalar
+// test. That one adds up in the same order as the SIMD lanes, so every path gives exactly the same answer
+static unsigned int *cullSpheresScalar(const Frustum &frustum, const BoundingSpheres &spheres, size_t start, unsigned int *out)
+{
+    for (size_t i = start; i < spheres.Size(); i++)
+    {
+        bool inside = true;
+        for (const glm::vec4 &plane : frustum.planes)
+        {
+            float d = plane.x * spheres.x[i] + plane.y * spheres.y[i];
+            d = d + plane.z * spheres.z[i];
+            inside = inside && (d + plane.w) + spheres.radius[i] >= 0.0f;
+        }
+        if (inside)
+            *out++ = (unsigned int)i;
+    }
+    return out;
+}
+
+static unsigned int *cullBoxesScalar(const Frustum &frustum, const BoundingBoxes &boxes, size_t start, unsigned int *out)
+{
+    for (size_t i = start; i < boxes.Size(); i++)
+    {
+        bool inside = true;
+        for (const glm::vec4 &plane : frustum.planes)
+        {
+            float d = plane.x * boxes.centerX[i] + plane.y * boxes.centerY[i];
+            d = d + (plane.z * boxes.centerZ[i] + plane.w);
+            float reach = std::fabs(plane.x) * boxes.extentX[i] + std::fabs(plane.y) * boxes.extentY[i];
+            reach = reach + std::fabs(plane.z) * boxes.extentZ[i];
+            inside = inside && d + reach >= 0.0f;
+        }
+        if (inside)
+            *out++ = (unsigned int)i;
+    }
+    return out;
+}
+
+static unsigned int *cullSpheresSse(const Frustum &frustum, const BoundingSpheres &spheres, unsigned int *out)
+{
+    size_t i = 0;
+#ifdef FRUSTUM_SSE2
+    for (; i + 4 <= spheres.Size(); i += 4)
+    {
+        __m128 x = _mm_loadu_ps(&spheres.x[i]), y = _mm_loadu_ps(&spheres.y[i]), z = _mm_loadu_ps(&spheres.z[i]);
+        __m128 r = _mm_loadu_ps(&spheres.radius[i]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4 &plane : frustum.planes)
+        {
+            // signed distance of the center, plus the radius
+            __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), x), _mm_mul_ps(_mm_set1_ps(plane.y), y));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.z), z));
+            d = _mm_add_ps(_mm_add_ps(d, _mm_set1_ps(plane.w)), r);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_setzero_ps()));
+        }
+        out = appendVisible(out, (unsigned int)i, _mm_movemask_ps(inside));
+    }
+#endif
+    return cullSpheresScalar(frustum, spheres, i, out);
+}
+
+static unsigned int *cullBoxesSse(const Frustum &frustum, const BoundingBoxes &boxes, unsigned int *out)
+{
+    size_t i = 0;
+#ifdef FRUSTUM_SSE2
+    for (; i + 4 <= boxes.Size(); i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(&boxes.centerX[i]), cy = _mm_loadu_ps(&boxes.centerY[i]), cz = _mm_loadu_ps(&boxes.centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&boxes.extentX[i]), ey = _mm_loadu_ps(&boxes.extentY[i]), ez = _mm_loadu_ps(&boxes.extentZ[i]);
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4 &plane : frustum.planes)
+        {
+            // signed distance of the center, plus how far the box reaches along the normal
+            __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), cx), _mm_mul_ps(_mm_set1_ps(plane.y), cy));
+            d = _mm_add_ps(d, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.z), cz), _mm_set1_ps(plane.w)));
+            __m128 reach = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(std::fabs(plane.x)), ex), _mm_mul_ps(_mm_set1_ps(std::fabs(plane.y)), ey));
+            reach = _mm_add_ps(reach, _mm_mul_ps(_mm_set1_ps(std::fabs(plane.z)), ez));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(d, reach), _mm_setzero_ps()));
+        }
+        out = appendVisible(out, (unsigned int)i, _mm_movemask_ps(inside));
+    }
+#endif
+    return cullBoxesScalar(frustum, boxes, i, out);
+}
+
+#ifdef FRUSTUM_AVX
+FRUSTUM_AVX_TARGET static unsigned int *cullSpheresAvx(const Frustum &frustum, const BoundingSpheres &spheres, unsigned int *out)
+{
+    size_t i = 0;
+    for (; i + 8 <= spheres.Size(); i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(&spheres.x[i]), y = _mm256_loadu_ps(&spheres.y[i]), z = _mm256_loadu_ps(&spheres.z[i]);
+        __m256 r = _mm256_loadu_ps(&spheres.radius[i]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const glm::vec4 &plane : frustum.planes)
+        {
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), x), _mm256_mul_ps(_mm256_set1_ps(plane.y), y));
+            d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.z), z));
+            d = _mm256_add_ps(_mm256_add_ps(d, _mm256_set1_ps(plane.w)), r);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        out = appendVisible(out, (unsigned int)i, _mm256_movemask_ps(inside));
+    }
+    return cullSpheresScalar(frustum, spheres, i, out);
+}
+
+FRUSTUM_AVX_TARGET static unsigned int *cullBoxesAvx(const Frustum &frustum, const BoundingBoxes &boxes, unsigned int *out)
+{
+    size_t i = 0;
+    for (; i + 8 <= boxes.Size(); i += 8)
+    {
+        __m256 cx = _mm256_loadu_ps(&boxes.centerX[i]), cy = _mm256_loadu_ps(&boxes.centerY[i]), cz = _mm256_loadu_ps(&boxes.centerZ[i]);
+        __m256 ex = _mm256_loadu_ps(&boxes.extentX[i]), ey = _mm256_loadu_ps(&boxes.extentY[i]), ez = _mm256_loadu_ps(&boxes.extentZ[i]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const glm::vec4 &plane : frustum.planes)
+        {
+            __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), cx), _mm256_mul_ps(_mm256_set1_ps(plane.y), cy));
+            d = _mm256_add_ps(d, _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), cz), _mm256_set1_ps(plane.w)));
+            __m256 reach = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.x)), ex), _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.y)), ey));
+            reach = _mm256_add_ps(reach, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane.z)), ez));
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(d, reach), _mm256_setzero_ps(), _CMP_GE_OQ));
+        }
+        out = appendVisible(out, (unsigned int)i, _mm256_movemask_ps(inside));
+    }
+    return cullBoxesScalar(frustum, boxes, i, out);
+}
+#endif
+
+// the widest path the CPU has, at most the one asked for
+static CullPath pickPath(CullPath path)
+{
+    static const bool avx = cpuHasAvx();
+    if (path == CULL_AVX && !avx)
+        return CULL_SSE;
+    return path;
+}
+
+void CullSpheres(const Frustum &frustum, const BoundingSpheres &spheres, std::vector<unsigned int> &visible, CullPath path)
+{
+    visible.resize(spheres.Size());
+    if (visible.empty())
+        return;
+    unsigned int *end;
+    switch (pickPath(path))
+    {
+#ifdef FRUSTUM_AVX
+    case CULL_AVX: end = cullSpheresAvx(frustum, spheres, visible.data()); break;
+#endif
+    case CULL_SCALAR: end = cullSpheresScalar(frustum, spheres, 0, visible.data()); break;
+    default: end = cullSpheresSse(frustum, spheres, visible.data()); break;
+    }
+    visible.resize((size_t)(end - visible.data()));
+}
+
+void CullBoxes(const Frustum &frustum, const BoundingBoxes &boxes, std::vector<unsigned int> &visible, CullPath path)
+{
+    visible.resize(boxes.Size());
+    if (visible.empty())
+        return;
+    PROFILE_COUNTERS("cull boxes", boxes.Size());
+    unsigned int *end;
+    switch (pickPath(path))
+    {
+#ifdef FRUSTUM_AVX
+    case CULL_AVX: end = cullBoxesAvx(frustum, boxes, visible.data()); break;
+#endif
+    case CULL_SCALAR: end = cullBoxesScalar(frustum, boxes, 0, visible.data()); break;
+    default: end = cullBoxesSse(frustum, boxes, visible.data()); break;
+    }
+    visible.resize((size_t)(end - visible.data()));
+}
@@ -0,0 +1,1110 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <gl_capture.h>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+// pending records are written out once they reach this size
+static const size_t GL_CAPTURE_BLOCK = 4 * 1024 * 1024;
+
+// the GL functions the capture hooks, with their glad pointer types
+#define GL_CAPTURE_FUNCTIONS(X) \
+    X(glEnable, PFNGLENABLEPROC) \
+    X(glDisable, PFNGLDISABLEPROC) \
+    X(glBlendFunc, PFNGLBLENDFUNCPROC) \
+    X(glDepthFunc, PFNGLDEPTHFUNCPROC) \
+    X(glDepthMask, PFNGLDEPTHMASKPROC) \
+    X(glColorMask, PFNGLCOLORMASKPROC) \
+    X(glCullFace, PFNGLCULLFACEPROC) \
+    X(glViewport, PFNGLVIEWPORTPROC) \
+    X(glScissor, PFNGLSCISSORPROC) \
+    X(glClearColor, PFNGLCLEARCOLORPROC) \
+    X(glClear, PFNGLCLEARPROC) \
+    X(glDrawArrays, PFNGLDRAWARRAYSPROC) \
+    X(glDrawElements, PFNGLDRAWELEMENTSPROC) \
+    X(glDrawArraysInstanced, PFNGLDRAWARRAYSINSTANCEDPROC) \
+    X(glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC) \
+    X(glPixelStorei, PFNGLPIXELSTOREIPROC) \
+    X(glActiveTexture, PFNGLACTIVETEXTUREPROC) \
+    X(glGenTextures, PFNGLGENTEXTURESPROC) \
+    X(glDeleteTextures, PFNGLDELETETEXTURESPROC) \
+    X(glBindTexture, PFNGLBINDTEXTUREPROC) \
+    X(glTexParameteri, PFNGLTEXPARAMETERIPROC) \
+    X(glTexParameterf, PFNGLTEXPARAMETERFPROC) \
+    X(glTexImage2D, PFNGLTEXIMAGE2DPROC) \
+    X(glTexSubImage2D, PFNGLTEXSUBIMAGE2DPROC) \
+    X(glTexImage3D, PFNGLTEXIMAGE3DPROC) \
+    X(glTexSubImage3D, PFNGLTEXSUBIMAGE3DPROC) \
+    X(glCompressedTexImage2D, PFNGLCOMPRESSEDTEXIMAGE2DPROC) \
+    X(glCompressedTexSubImage2D, PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC) \
+    X(glCompressedTexImage3D, PFNGLCOMPRESSEDTEXIMAGE3DPROC) \
+    X(glCompressedTexSubImage3D, PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC) \
+    X(glGenerateMipmap, PFNGLGENERATEMIPMAPPROC) \
+    X(glGenBuffers, PFNGLGENBUFFERSPROC) \
+    X(glDeleteBuffers, PFNGLDELETEBUFFERSPROC) \
+    X(glBindBuffer, PFNGLBINDBUFFERPROC) \
+    X(glBufferData, PFNGLBUFFERDATAPROC) \
+    X(glBufferSubData, PFNGLBUFFERSUBDATAPROC) \
+    X(glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC) \
+    X(glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC) \
+    X(glBindVertexArray, PFNGLBINDVERTEXARRAYPROC) \
+    X(glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC) \
+    X(glDisableVertexAttribArray, PFNGLDISABLEVERTEXATTRIBARRAYPROC) \
+    X(glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC) \
+    X(glVertexAttribIPointer, PFNGLVERTEXATTRIBIPOINTERPROC) \
+    X(glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC) \
+    X(glGenFramebuffers, PFNGLGENFRAMEBUFFERSPROC) \
+    X(glDeleteFramebuffers, PFNGLDELETEFRAMEBUFFERSPROC) \
+    X(glBindFramebuffer, PFNGLBINDFRAMEBUFFERPROC) \
+    X(glFramebufferTexture2D, PFNGLFRAMEBUFFERTEXTURE2DPROC) \
+    X(glFramebufferRenderbuffer, PFNGLFRAMEBUFFERRENDERBUFFERPROC) \
+    X(glGenRenderbuffers, PFNGLGENRENDERBUFFERSPROC) \
+    X(glDeleteRenderbuffers, PFNGLDELETERENDERBUFFERSPROC) \
+    X(glBindRenderbuffer, PFNGLBINDRENDERBUFFERPROC) \
+    X(glRenderbufferStorage, PFNGLRENDERBUFFERSTORAGEPROC) \
+    X(glCreateShader, PFNGLCREATESHADERPROC) \
+    X(glShaderSource, PFNGLSHADERSOURCEPROC) \
+    X(glCompileShader, PFNGLCOMPILESHADERPROC) \
+    X(glDeleteShader, PFNGLDELETESHADERPROC) \
+    X(glCreateProgram, PFNGLCREATEPROGRAMPROC) \
+    X(glAttachShader, PFNGLATTACHSHADERPROC) \
+    X(glLinkProgram, PFNGLLINKPROGRAMPROC) \
+    X(glUseProgram, PFNGLUSEPROGRAMPROC) \
+    X(glDeleteProgram, PFNGLDELETEPROGRAMPROC) \
+    X(glGetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC) \
+    X(glUniform1i, PFNGLUNIFORM1IPROC) \
+    X(glUniform1f, PFNGLUNIFORM1FPROC) \
+    X(glUniform2f, PFNGLUNIFORM2FPROC) \
+    X(glUniform3f, PFNGLUNIFORM3FPROC) \
+    X(glUniform4f, PFNGLUNIFORM4FPROC) \
+    X(glUniform3fv, PFNGLUNIFORM3FVPROC) \
+    X(glUniform4fv, PFNGLUNIFORM4FVPROC) \
+    X(glUniformMatrix3fv, PFNGLUNIFORMMATRIX3FVPROC) \
+    X(glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC) \
+    X(glGenQueries, PFNGLGENQUERIESPROC) \
+    X(glDeleteQueries, PFNGLDELETEQUERIESPROC) \
+    X(glBeginQuery, PFNGLBEGINQUERYPROC) \
+    X(glEndQuery, PFNGLENDQUERYPROC) \
+    X(glQueryCounter, PFNGLQUERYCOUNTERPROC)
+
+// glad's own pointers, which the hooks call
+#define GL_CAPTURE_REAL(name, type) static type real_##name = nullptr;
+GL_CAPTURE_FUNCTIONS(GL_CAPTURE_REAL)
+#undef GL_CAPTURE_REAL
+
+// the pixel store state the size of client texel data depends on, and whether a buffer is bound to unpack from
+struct UnpackState {
+    GLint alignment = 4;
+    GLint rowLength = 0;
+    GLint imageHeight = 0;
+    GLint skipPixels = 0;
+    GLint skipRows = 0;
+    GLint skipImages = 0;
+    GLuint buffer = 0;
+};
+static UnpackState unpack;
+
+// One record: the call id and size, then whatever is put. Recording is skipped when nothing is being captured,
+// and for draws and clears before the first captured frame.
+class GlCaptureRecord {
+public:
+    explicit GlCaptureRecord(GlCaptureCall call, bool draw = false)
+        : capture(GlCapture::Instance()), active(capture.file && (!draw || capture.recordDraws))
+    {
+        if (!active)
+            return;
+        start = capture.pending.size();
+        put((uint32_t)call);
+        put((uint32_t)0);
+    }
+
+    ~GlCaptureRecord()
+    {
+        if (!active)
+            return;
+        align();
+        uint32_t size = (uint32_t)(capture.pending.size() - start - 2 * sizeof(uint32_t));
+        std::memcpy(&capture.pending[start + sizeof(uint32_t)], &size, sizeof(size));
+        if (capture.pending.size() >= GL_CAPTURE_BLOCK)
+        {
+            capture.write(capture.pending.data(), capture.pending.size());
+            capture.pending.clear();
+        }
+    }
+
+    bool Active() const { return active; }
+
+    template<typename T>
+    void put(const T &value)
+    {
+        if (!active)
+            return;
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+        capture.pending.insert(capture.pending.end(), bytes, bytes + sizeof(T));
+    }
+
+    // a length, then the bytes starting 8 byte aligned
+    void putData(const void *data, size_t size)
+    {
+        if (!active)
+            return;
+        put((uint64_t)size);
+        align();
+        const uint8_t *bytes = static_cast<const uint8_t *>(data);
+        capture.pending.insert(capture.pending.end(), bytes, bytes + size);
+        align();
+    }
+
+    void putNames(GLsizei n, const GLuint *names)
+    {
+        put((int32_t)n);
+        putData(names, sizeof(GLuint) * (size_t)std::max(0, n));
+    }
+
+    // texel data: copied from client memory, an offset into the bound unpack buffer, or nothing
+    void putPixels(const void *pixels, size_t size)
+    {
+        if (unpack.buffer)
+        {
+            put((uint8_t)GL_CAPTURE_PIXELS_OFFSET);
+            put((uint64_t)reinterpret_cast<uintptr_t>(pixels));
+        }
+        else if (pixels)
+        {
+            put((uint8_t)GL_CAPTURE_PIXELS_DATA);
+            putData(pixels, size);
+        }
+        else
+            put((uint8_t)GL_CAPTURE_PIXELS_NONE);
+    }
+
+private:
+    void align()
+    {
+        capture.pending.resize((capture.pending.size() + 7) & ~(size_t)7, 0);
+    }
+
+    GlCapture &capture;
+    bool active;
+    size_t start = 0;
+};
+
+// bytes per pixel of client texel data
+static size_t pixelBytes(GLenum format, GLenum type)
+{
+    size_t components;
+    switch (format)
+    {
+    case GL_RED: case GL_RED_INTEGER: case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+        components = 1;
+        break;
+    case GL_RG: case GL_RG_INTEGER:
+        components = 2;
+        break;
+    case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+        components = 3;
+        break;
+    default:
+        components = 4;
+    }
+    switch (type)
+    {
+    case GL_UNSIGNED_BYTE: case GL_BYTE:
+        return components;
+    case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT:
+        return components * 2;
+    case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT:
+        return components * 4;
+    case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV:
+        return 1;
+    case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV: case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_4_4_4_4_REV: case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV:
+        return 2;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+        return 8;
+    default:
+        // the other packed types are 32 bit
+        return 4;
+    }
+}
+
+// how many bytes GL reads from client memory for an image of this size, going by the unpack state
+static size_t imageBytes(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, bool volume)
+{
+    if (width <= 0 || height <= 0 || depth <= 0)
+        return 0;
+    size_t pixel = pixelBytes(format, type);
+    size_t alignment = (size_t)std::max(1, unpack.alignment);
+    size_t rowPixels = unpack.rowLength > 0 ? (size_t)unpack.rowLength : (size_t)width;
+    size_t rowBytes = (rowPixels * pixel + alignment - 1) / alignment * alignment;
+    size_t imageStride = rowBytes * (size_t)(volume && unpack.imageHeight > 0 ? unpack.imageHeight : height);
+    size_t skip = (size_t)unpack.skipPixels * pixel + (size_t)unpack.skipRows * rowBytes +
+                  (volume ? (size_t)unpack.skipImages * imageStride : 0);
+    return skip + (size_t)(depth - 1) * imageStride + (size_t)(height - 1) * rowBytes + (size_t)width * pixel;
+}
+
+// the hooks: call GL, then record the call
+
+static void APIENTRY capture_glEnable(GLenum cap)
+{
+    real_glEnable(cap);
+    GlCaptureRecord record(GLCALL_ENABLE);
+    record.put(cap);
+}
+
+static void APIENTRY capture_glDisable(GLenum cap)
+{
+    real_glDisable(cap);
+    GlCaptureRecord record(GLCALL_DISABLE);
+    record.put(cap);
+}
+
+static void APIENTRY capture_glBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    real_glBlendFunc(sfactor, dfactor);
+    GlCaptureRecord record(GLCALL_BLEND_FUNC);
+    record.put(sfactor);
+    record.put(dfactor);
+}
+
+static void APIENTRY capture_glDepthFunc(GLenum func)
+{
+    real_glDepthFunc(func);
+    GlCaptureRecord record(GLCALL_DEPTH_FUNC);
+    record.put(func);
+}
+
+static void APIENTRY capture_glDepthMask(GLboolean flag)
+{
+    real_glDepthMask(flag);
+    GlCaptureRecord record(GLCALL_DEPTH_MASK);
+    record.put(flag);
+}
+
+static void APIENTRY capture_glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    real_glColorMask(red, green, blue, alpha);
+    GlCaptureRecord record(GLCALL_COLOR_MASK);
+    record.put(red);
+    record.put(green);
+    record.put(blue);
+    record.put(alpha);
+}
+
+static void APIENTRY capture_glCullFace(GLenum mode)
+{
+    real_glCullFace(mode);
+    GlCaptureRecord record(GLCALL_CULL_FACE);
+    record.put(mode);
+}
+
+static void APIENTRY capture_glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    real_glViewport(x, y, width, height);
+    GlCaptureRecord record(GLCALL_VIEWPORT);
+    record.put(x);
+    record.put(y);
+    record.put(width);
+    record.put(height);
+}
+
+static void APIENTRY capture_glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    real_glScissor(x, y, width, height);
+    GlCaptureRecord record(GLCALL_SCISSOR);
+    record.put(x);
+    record.put(y);
+    record.put(width);
+    record.put(height);
+}
+
+static void APIENTRY capture_glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    real_glClearColor(red, green, blue, alpha);
+    GlCaptureRecord record(GLCALL_CLEAR_COLOR);
+    record.put(red);
+    record.put(green);
+    record.put(blue);
+    record.put(alpha);
+}
+
+static void APIENTRY capture_glClear(GLbitfield mask)
+{
+    real_glClear(mask);
+    GlCaptureRecord record(GLCALL_CLEAR, true);
+    record.put(mask);
+}
+
+static void APIENTRY capture_glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    real_glDrawArrays(mode, first, count);
+    GlCaptureRecord record(GLCALL_DRAW_ARRAYS, true);
+    record.put(mode);
+    record.put(first);
+    record.put(count);
+}
+
+// the core profile draws indices from the bound element buffer, so indices is an offset into it
+static void APIENTRY capture_glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices)
+{
+    real_glDrawElements(mode, count, type, indices);
+    GlCaptureRecord record(GLCALL_DRAW_ELEMENTS, true);
+    record.put(mode);
+    record.put(count);
+    record.put(type);
+    record.put((uint64_t)reinterpret_cast<uintptr_t>(indices));
+}
+
+static void APIENTRY capture_glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+{
+    real_glDrawArraysInstanced(mode, first, count, instances);
+    GlCaptureRecord record(GLCALL_DRAW_ARRAYS_INSTANCED, true);
+    record.put(mode);
+    record.put(first);
+    record.put(count);
+    record.put(instances);
+}
+
+static void APIENTRY capture_glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instances)
+{
+    real_glDrawElementsInstanced(mode, count, type, indices, instances);
+    GlCaptureRecord record(GLCALL_DRAW_ELEMENTS_INSTANCED, true);
+    record.put(mode);
+    record.put(count);
+    record.put(type);
+    record.put((uint64_t)reinterpret_cast<uintptr_t>(indices));
+    record.put(instances);
+}
+
+static void APIENTRY capture_glPixelStorei(GLenum pname, GLint param)
+{
+    real_glPixelStorei(pname, param);
+    switch (pname)
+    {
+    case GL_UNPACK_ALIGNMENT: unpack.alignment = param; break;
+    case GL_UNPACK_ROW_LENGTH: unpack.rowLength = param; break;
+    case GL_UNPACK_IMAGE_HEIGHT: unpack.imageHeight = param; break;
+    case GL_UNPACK_SKIP_PIXELS: unpack.skipPixels = param; break;
+    case GL_UNPACK_SKIP_ROWS: unpack.skipRows = param; break;
+    case GL_UNPACK_SKIP_IMAGES: unpack.skipImages = param; break;
+    default: break;
+    }
+    GlCaptureRecord record(GLCALL_PIXEL_STORE);
+    record.put(pname);
+    record.put(param);
+}
+
+static void APIENTRY capture_glActiveTexture(GLenum texture)
+{
+    real_glActiveTexture(texture);
+    GlCaptureRecord record(GLCALL_ACTIVE_TEXTURE);
+    record.put(texture);
+}
+
+static void APIENTRY capture_glGenTextures(GLsizei n, GLuint *textures)
+{
+    real_glGenTextures(n, textures);
+    GlCaptureRecord record(GLCALL_GEN_TEXTURES);
+    record.putNames(n, textures);
+}
+
+static void APIENTRY capture_glDeleteTextures(GLsizei n, const GLuint *textures)
+{
+    real_glDeleteTextures(n, textures);
+    GlCaptureRecord record(GLCALL_DELETE_TEXTURES);
+    record.putNames(n, textures);
+}
+
+static void APIENTRY capture_glBindTexture(GLenum target, GLuint texture)
+{
+    real_glBindTexture(target, texture);
+    GlCaptureRecord record(GLCALL_BIND_TEXTURE);
+    record.put(target);
+    record.put(texture);
+}
+
+static void APIENTRY capture_glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    real_glTexParameteri(target, pname, param);
+    GlCaptureRecord record(GLCALL_TEX_PARAMETER_I);
+    record.put(target);
+    record.put(pname);
+    record.put(param);
+}
+
+static void APIENTRY capture_glTexParameterf(GLenum target, GLenum pname, GLfloat param)
+{
+    real_glTexParameterf(target, pname, param);
+    GlCaptureRecord record(GLCALL_TEX_PARAMETER_F);
+    record.put(target);
+    record.put(pname);
+    record.put(param);
+}
+
+static void APIENTRY capture_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                          GLint border, GLenum format, GLenum type, const void *pixels)
+{
+    real_glTexImage2D(target, level, internalformat, width, height, border, format, type, pixels);
+    GlCaptureRecord record(GLCALL_TEX_IMAGE_2D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+    record.put(border);
+    record.put(format);
+    record.put(type);
+    record.putPixels(pixels, imageBytes(width, height, 1, format, type, false));
+}
+
+static void APIENTRY capture_glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                                             GLsizei height, GLenum format, GLenum type, const void *pixels)
+{
+    real_glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels);
+    GlCaptureRecord record(GLCALL_TEX_SUB_IMAGE_2D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(xoffset);
+    record.put(yoffset);
+    record.put(width);
+    record.put(height);
+    record.put(format);
+    record.put(type);
+    record.putPixels(pixels, imageBytes(width, height, 1, format, type, false));
+}
+
+static void APIENTRY capture_glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                          GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels)
+{
+    real_glTexImage3D(target, level, internalformat, width, height, depth, border, format, type, pixels);
+    GlCaptureRecord record(GLCALL_TEX_IMAGE_3D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+    record.put(depth);
+    record.put(border);
+    record.put(format);
+    record.put(type);
+    record.putPixels(pixels, imageBytes(width, height, depth, format, type, true));
+}
+
+static void APIENTRY capture_glTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                                             GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type,
+                                             const void *pixels)
+{
+    real_glTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels);
+    GlCaptureRecord record(GLCALL_TEX_SUB_IMAGE_3D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(xoffset);
+    record.put(yoffset);
+    record.put(zoffset);
+    record.put(width);
+    record.put(height);
+    record.put(depth);
+    record.put(format);
+    record.put(type);
+    record.putPixels(pixels, imageBytes(width, height, depth, format, type, true));
+}
+
+static void APIENTRY capture_glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                                    GLsizei height, GLint border, GLsizei imageSize, const void *data)
+{
+    real_glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data);
+    GlCaptureRecord record(GLCALL_COMPRESSED_TEX_IMAGE_2D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+    record.put(border);
+    record.put(imageSize);
+    record.putPixels(data, (size_t)imageSize);
+}
+
+static void APIENTRY capture_glCompressedTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                                       GLsizei width, GLsizei height, GLenum format, GLsizei imageSize,
+                                                       const void *data)
+{
+    real_glCompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data);
+    GlCaptureRecord record(GLCALL_COMPRESSED_TEX_SUB_IMAGE_2D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(xoffset);
+    record.put(yoffset);
+    record.put(width);
+    record.put(height);
+    record.put(format);
+    record.put(imageSize);
+    record.putPixels(data, (size_t)imageSize);
+}
+
+static void APIENTRY capture_glCompressedTexImage3D(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                                    GLsizei height, GLsizei depth, GLint border, GLsizei imageSize,
+                                                    const void *data)
+{
+    real_glCompressedTexImage3D(target, level, internalformat, width, height, depth, border, imageSize, data);
+    GlCaptureRecord record(GLCALL_COMPRESSED_TEX_IMAGE_3D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+    record.put(depth);
+    record.put(border);
+    record.put(imageSize);
+    record.putPixels(data, (size_t)imageSize);
+}
+
+static void APIENTRY capture_glCompressedTexSubImage3D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                                       GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
+                                                       GLenum format, GLsizei imageSize, const void *data)
+{
+    real_glCompressedTexSubImage3D(target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data);
+    GlCaptureRecord record(GLCALL_COMPRESSED_TEX_SUB_IMAGE_3D);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(level);
+    record.put(xoffset);
+    record.put(yoffset);
+    record.put(zoffset);
+    record.put(width);
+    record.put(height);
+    record.put(depth);
+    record.put(format);
+    record.put(imageSize);
+    record.putPixels(data, (size_t)imageSize);
+}
+
+static void APIENTRY capture_glGenerateMipmap(GLenum target)
+{
+    real_glGenerateMipmap(target);
+    GlCaptureRecord record(GLCALL_GENERATE_MIPMAP);
+    record.put(target);
+}
+
+static void APIENTRY capture_glGenBuffers(GLsizei n, GLuint *buffers)
+{
+    real_glGenBuffers(n, buffers);
+    GlCaptureRecord record(GLCALL_GEN_BUFFERS);
+    record.putNames(n, buffers);
+}
+
+static void APIENTRY capture_glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+    real_glDeleteBuffers(n, buffers);
+    for (GLsizei i = 0; i < n; i++)
+        if (buffers[i] == unpack.buffer)
+            unpack.buffer = 0;
+    GlCaptureRecord record(GLCALL_DELETE_BUFFERS);
+    record.putNames(n, buffers);
+}
+
+static void APIENTRY capture_glBindBuffer(GLenum target, GLuint buffer)
+{
+    real_glBindBuffer(target, buffer);
+    if (target == GL_PIXEL_UNPACK_BUFFER)
+        unpack.buffer = buffer;
+    GlCaptureRecord record(GLCALL_BIND_BUFFER);
+    record.put(target);
+    record.put(buffer);
+}
+
+static void APIENTRY capture_glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
+{
+    real_glBufferData(target, size, data, usage);
+    GlCaptureRecord record(GLCALL_BUFFER_DATA);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put(usage);
+    record.put((uint64_t)size);
+    record.put((uint8_t)(data != nullptr));
+    if (data)
+        record.putData(data, (size_t)size);
+}
+
+static void APIENTRY capture_glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data)
+{
+    real_glBufferSubData(target, offset, size, data);
+    GlCaptureRecord record(GLCALL_BUFFER_SUB_DATA);
+    if (!record.Active())
+        return;
+    record.put(target);
+    record.put((uint64_t)offset);
+    record.putData(data, (size_t)size);
+}
+
+static void APIENTRY capture_glGenVertexArrays(GLsizei n, GLuint *arrays)
+{
+    real_glGenVertexArrays(n, arrays);
+    GlCaptureRecord record(GLCALL_GEN_VERTEX_ARRAYS);
+    record.putNames(n, arrays);
+}
+
+static void APIENTRY capture_glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+    real_glDeleteVertexArrays(n, arrays);
+    GlCaptureRecord record(GLCALL_DELETE_VERTEX_ARRAYS);
+    record.putNames(n, arrays);
+}
+
+static void APIENTRY capture_glBindVertexArray(GLuint array)
+{
+    real_glBindVertexArray(array);
+    GlCaptureRecord record(GLCALL_BIND_VERTEX_ARRAY);
+    record.put(array);
+}
+
+static void APIENTRY capture_glEnableVertexAttribArray(GLuint index)
+{
+    real_glEnableVertexAttribArray(index);
+    GlCaptureRecord record(GLCALL_ENABLE_VERTEX_ATTRIB_ARRAY);
+    record.put(index);
+}
+
+static void APIENTRY capture_glDisableVertexAttribArray(GLuint index)
+{
+    real_glDisableVertexAttribArray(index);
+    GlCaptureRecord record(GLCALL_DISABLE_VERTEX_ATTRIB_ARRAY);
+    record.put(index);
+}
+
+// the core profile sources attributes from the bound array buffer, so pointer is an offset into it
+static void APIENTRY capture_glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized,
+                                                   GLsizei stride, const void *pointer)
+{
+    real_glVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    GlCaptureRecord record(GLCALL_VERTEX_ATTRIB_POINTER);
+    record.put(index);
+    record.put(size);
+    record.put(type);
+    record.put(normalized);
+    record.put(stride);
+    record.put((uint64_t)reinterpret_cast<uintptr_t>(pointer));
+}
+
+static void APIENTRY capture_glVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer)
+{
+    real_glVertexAttribIPointer(index, size, type, stride, pointer);
+    GlCaptureRecord record(GLCALL_VERTEX_ATTRIB_I_POINTER);
+    record.put(index);
+    record.put(size);
+    record.put(type);
+    record.put(stride);
+    record.put((uint64_t)reinterpret_cast<uintptr_t>(pointer));
+}
+
+static void APIENTRY capture_glVertexAttribDivisor(GLuint index, GLuint divisor)
+{
+    real_glVertexAttribDivisor(index, divisor);
+    GlCaptureRecord record(GLCALL_VERTEX_ATTRIB_DIVISOR);
+    record.put(index);
+    record.put(divisor);
+}
+
+static void APIENTRY capture_glGenFramebuffers(GLsizei n, GLuint *framebuffers)
+{
+    real_glGenFramebuffers(n, framebuffers);
+    GlCaptureRecord record(GLCALL_GEN_FRAMEBUFFERS);
+    record.putNames(n, framebuffers);
+}
+
+static void APIENTRY capture_glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+    real_glDeleteFramebuffers(n, framebuffers);
+    GlCaptureRecord record(GLCALL_DELETE_FRAMEBUFFERS);
+    record.putNames(n, framebuffers);
+}
+
+static void APIENTRY capture_glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    real_glBindFramebuffer(target, framebuffer);
+    GlCaptureRecord record(GLCALL_BIND_FRAMEBUFFER);
+    record.put(target);
+    record.put(framebuffer);
+}
+
+static void APIENTRY capture_glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    real_glFramebufferTexture2D(target, attachment, textarget, texture, level);
+    GlCaptureRecord record(GLCALL_FRAMEBUFFER_TEXTURE_2D);
+    record.put(target);
+    record.put(attachment);
+    record.put(textarget);
+    record.put(texture);
+    record.put(level);
+}
+
+static void APIENTRY capture_glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget,
+                                                       GLuint renderbuffer)
+{
+    real_glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+    GlCaptureRecord record(GLCALL_FRAMEBUFFER_RENDERBUFFER);
+    record.put(target);
+    record.put(attachment);
+    record.put(renderbuffertarget);
+    record.put(renderbuffer);
+}
+
+static void APIENTRY capture_glGenRenderbuffers(GLsizei n, GLuint *renderbuffers)
+{
+    real_glGenRenderbuffers(n, renderbuffers);
+    GlCaptureRecord record(GLCALL_GEN_RENDERBUFFERS);
+    record.putNames(n, renderbuffers);
+}
+
+static void APIENTRY capture_glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+    real_glDeleteRenderbuffers(n, renderbuffers);
+    GlCaptureRecord record(GLCALL_DELETE_RENDERBUFFERS);
+    record.putNames(n, renderbuffers);
+}
+
+static void APIENTRY capture_glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    real_glBindRenderbuffer(target, renderbuffer);
+    GlCaptureRecord record(GLCALL_BIND_RENDERBUFFER);
+    record.put(target);
+    record.put(renderbuffer);
+}
+
+static void APIENTRY capture_glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    real_glRenderbufferStorage(target, internalformat, width, height);
+    GlCaptureRecord record(GLCALL_RENDERBUFFER_STORAGE);
+    record.put(target);
+    record.put(internalformat);
+    record.put(width);
+    record.put(height);
+}
+
+static GLuint APIENTRY capture_glCreateShader(GLenum type)
+{
+    GLuint shader = real_glCreateShader(type);
+    GlCaptureRecord record(GLCALL_CREATE_SHADER);
+    record.put(type);
+    record.put(shader);
+    return shader;
+}
+
+static void APIENTRY capture_glShaderSource(GLuint shader, GLsizei count, const GLchar *const *string, const GLint *length)
+{
+    real_glShaderSource(shader, count, string, length);
+    GlCaptureRecord record(GLCALL_SHADER_SOURCE);
+    if (!record.Active())
+        return;
+    record.put(shader);
+    record.put(count);
+    for (GLsizei i = 0; i < count; i++)
+        record.putData(string[i], length && length[i] >= 0 ? (size_t)length[i] : std::strlen(string[i]));
+}
+
+static void APIENTRY capture_glCompileShader(GLuint shader)
+{
+    real_glCompileShader(shader);
+    GlCaptureRecord record(GLCALL_COMPILE_SHADER);
+    record.put(shader);
+}
+
+static void APIENTRY capture_glDeleteShader(GLuint shader)
+{
+    real_glDeleteShader(shader);
+    GlCaptureRecord record(GLCALL_DELETE_SHADER);
+    record.put(shader);
+}
+
+static GLuint APIENTRY capture_glCreateProgram()
+{
+    GLuint program = real_glCreateProgram();
+    GlCaptureRecord record(GLCALL_CREATE_PROGRAM);
+    record.put(program);
+    return program;
+}
+
+static void APIENTRY capture_glAttachShader(GLuint program, GLuint shader)
+{
+    real_glAttachShader(program, shader);
+    GlCaptureRecord record(GLCALL_ATTACH_SHADER);
+    record.put(program);
+    record.put(shader);
+}
+
+static void APIENTRY capture_glLinkProgram(GLuint program)
+{
+    real_glLinkProgram(program);
+    GlCaptureRecord record(GLCALL_LINK_PROGRAM);
+    record.put(program);
+}
+
+static void APIENTRY capture_glUseProgram(GLuint program)
+{
+    real_glUseProgram(program);
+    GlCaptureRecord record(GLCALL_USE_PROGRAM);
+    record.put(program);
+}
+
+static void APIENTRY capture_glDeleteProgram(GLuint program)
+{
+    real_glDeleteProgram(program);
+    GlCaptureRecord record(GLCALL_DELETE_PROGRAM);
+    record.put(program);
+}
+
+// recorded with the location it returned, which the uniform calls after it use
+static GLint APIENTRY capture_glGetUniformLocation(GLuint program, const GLchar *name)
+{
+    GLint location = real_glGetUniformLocation(program, name);
+    GlCaptureRecord record(GLCALL_GET_UNIFORM_LOCATION);
+    if (record.Active())
+    {
+        record.put(program);
+        record.put(location);
+        record.putData(name, std::strlen(name));
+    }
+    return location;
+}
+
+static void APIENTRY capture_glUniform1i(GLint location, GLint v0)
+{
+    real_glUniform1i(location, v0);
+    GlCaptureRecord record(GLCALL_UNIFORM_1I);
+    record.put(location);
+    record.put(v0);
+}
+
+static void APIENTRY capture_glUniform1f(GLint location, GLfloat v0)
+{
+    real_glUniform1f(location, v0);
+    GlCaptureRecord record(GLCALL_UNIFORM_1F);
+    record.put(location);
+    record.put(v0);
+}
+
+static void APIENTRY capture_glUniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+    real_glUniform2f(location, v0, v1);
+    GlCaptureRecord record(GLCALL_UNIFORM_2F);
+    record.put(location);
+    record.put(v0);
+    record.put(v1);
+}
+
+static void APIENTRY capture_glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+    real_glUniform3f(location, v0, v1, v2);
+    GlCaptureRecord record(GLCALL_UNIFORM_3F);
+    record.put(location);
+    record.put(v0);
+    record.put(v1);
+    record.put(v2);
+}
+
+static void APIENTRY capture_glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    real_glUniform4f(location, v0, v1, v2, v3);
+    GlCaptureRecord record(GLCALL_UNIFORM_4F);
+    record.put(location);
+    record.put(v0);
+    record.put(v1);
+    record.put(v2);
+    record.put(v3);
+}
+
+static void APIENTRY capture_glUniform3fv(GLint location, GLsizei count, const GLfloat *value)
+{
+    real_glUniform3fv(location, count, value);
+    GlCaptureRecord record(GLCALL_UNIFORM_3FV);
+    if (!record.Active())
+        return;
+    record.put(location);
+    record.put(count);
+    record.putData(value, sizeof(GLfloat) * 3 * (size_t)std::max(0, count));
+}
+
+static void APIENTRY capture_glUniform4fv(GLint location, GLsizei count, const GLfloat *value)
+{
+    real_glUniform4fv(location, count, value);
+    GlCaptureRecord record(GLCALL_UNIFORM_4FV);
+    if (!record.Active())
+        return;
+    record.put(location);
+    record.put(count);
+    record.putData(value, sizeof(GLfloat) * 4 * (size_t)std::max(0, count));
+}
+
+static void APIENTRY capture_glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+    real_glUniformMatrix3fv(location, count, transpose, value);
+    GlCaptureRecord record(GLCALL_UNIFORM_MATRIX_3FV);
+    if (!record.Active())
+        return;
+    record.put(location);
+    record.put(count);
+    record.put(transpose);
+    record.putData(value, sizeof(GLfloat) * 9 * (size_t)std::max(0, count));
+}
+
+static void APIENTRY capture_glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value)
+{
+    real_glUniformMatrix4fv(location, count, transpose, value);
+    GlCaptureRecord record(GLCALL_UNIFORM_MATRIX_4FV);
+    if (!record.Active())
+        return;
+    record.put(location);
+    record.put(count);
+    record.put(transpose);
+    record.putData(value, sizeof(GLfloat) * 16 * (size_t)std::max(0, count));
+}
+
+static void APIENTRY capture_glGenQueries(GLsizei n, GLuint *ids)
+{
+    real_glGenQueries(n, ids);
+    GlCaptureRecord record(GLCALL_GEN_QUERIES);
+    record.putNames(n, ids);
+}
+
+static void APIENTRY capture_glDeleteQueries(GLsizei n, const GLuint *ids)
+{
+    real_glDeleteQueries(n, ids);
+    GlCaptureRecord record(GLCALL_DELETE_QUERIES);
+    record.putNames(n, ids);
+}
+
+static void APIENTRY capture_glBeginQuery(GLenum target, GLuint id)
+{
+    real_glBeginQuery(target, id);
+    GlCaptureRecord record(GLCALL_BEGIN_QUERY);
+    record.put(target);
+    record.put(id);
+}
+
+static void APIENTRY capture_glEndQuery(GLenum target)
+{
+    real_glEndQuery(target);
+    GlCaptureRecord record(GLCALL_END_QUERY);
+    record.put(target);
+}
+
+static void APIENTRY capture_glQueryCounter(GLuint id, GLenum target)
+{
+    real_glQueryCounter(id, target);
+    GlCaptureRecord record(GLCALL_QUERY_COUNTER);
+    record.put(id);
+    record.put(target);
+}
+
+GlCapture &GlCapture::Instance()
+{
+    static GlCapture instance;
+    return instance;
+}
+
+bool GlCapture::Start(const std::string &path, int width, int height, unsigned int firstFrame, unsigned int frames)
+{
+    del();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        std::cout << "GL capture: can't write " << path << std::endl;
+        return false;
+    }
+    this->path = path;
+    this->firstFrame = firstFrame;
+    lastFrame = firstFrame + std::max(1u, frames);
+    frame = 0;
+    written = 0;
+    recordDraws = false;
+    unpack = UnpackState();
+    pending.clear();
+    pending.reserve(GL_CAPTURE_BLOCK + 64 * 1024);
+
+    uint32_t header[4];
+    std::memcpy(&header[0], GL_CAPTURE_MAGIC, sizeof(GL_CAPTURE_MAGIC));
+    header[1] = GL_CAPTURE_VERSION;
+    header[2] = (uint32_t)width;
+    header[3] = (uint32_t)height;
+    write(reinterpret_cast<const uint8_t *>(header), sizeof(header));
+
+#define GL_CAPTURE_HOOK(name, type) real_##name = glad_##name; glad_##name = capture_##name;
+    GL_CAPTURE_FUNCTIONS(GL_CAPTURE_HOOK)
+#undef GL_CAPTURE_HOOK
+    return true;
+}
+
+void GlCapture::BeginFrame()
+{
+    if (!file)
+        return;
+    unsigned int current = frame++;
+    if (current == lastFrame)
+    {
+        finish();
+        return;
+    }
+    if (current >= firstFrame)
+    {
+        recordDraws = true;
+        GlCaptureRecord record(GLCALL_FRAME);
+        record.put((uint32_t)current);
+    }
+}
+
+void GlCapture::del()
+{
+    if (file)
+        finish();
+}
+
+void GlCapture::write(const uint8_t *data, size_t size)
+{
+    std::fwrite(data, 1, size, file);
+    written += size;
+}
+
+void GlCapture::finish()
+{
+#define GL_CAPTURE_UNHOOK(name, type) glad_##name = real_##name;
+    GL_CAPTURE_FUNCTIONS(GL_CAPTURE_UNHOOK)
+#undef GL_CAPTURE_UNHOOK
+
+    write(pending.data(), pending.size());
+    pending.clear();
+    pending.shrink_to_fit();
+    bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    file = nullptr;
+
+    // frames that began before the run ended, the last one of them is complete
+    unsigned int captured = std::min(frame, lastFrame) - std::min(frame, firstFrame);
+    if (failed)
+        std::cout << "GL capture: writing " << path << " failed" << std::endl;
+    else if (captured == 0)
+        std::cout << "GL capture: the run ended before frame " << firstFrame << ", " << path << " has no frames" << std::endl;
+    else
+        std::printf("GL capture: %u frame(s) from frame %u, %.1f MB to %s\n", captured, firstFrame,
+                    (double)written / (1024.0 * 1024.0), path.c_str());
+}
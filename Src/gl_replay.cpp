@@ -0,0 +1,687 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <gl_replay.h>
+#include <gl_capture.h>
+
+#include <glad/glad.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+// reads a record's arguments in the order GlCaptureRecord put them
+struct GlReplayReader {
+    const uint8_t *at;
+
+    template<typename T>
+    T get()
+    {
+        T value;
+        std::memcpy(&value, at, sizeof(T));
+        at += sizeof(T);
+        return value;
+    }
+
+    const void *getData(size_t &size)
+    {
+        size = (size_t)get<uint64_t>();
+        align();
+        const void *data = at;
+        at += size;
+        align();
+        return data;
+    }
+
+    const void *getData()
+    {
+        size_t size;
+        return getData(size);
+    }
+
+    const void *getPixels()
+    {
+        uint8_t storage = get<uint8_t>();
+        if (storage == GL_CAPTURE_PIXELS_OFFSET)
+            return reinterpret_cast<const void *>((uintptr_t)get<uint64_t>());
+        if (storage == GL_CAPTURE_PIXELS_DATA)
+            return getData();
+        return nullptr;
+    }
+
+    void align()
+    {
+        at = reinterpret_cast<const uint8_t *>(((uintptr_t)at + 7) & ~(uintptr_t)7);
+    }
+};
+
+typedef void (APIENTRYP GlGenFunction)(GLsizei n, GLuint *names);
+typedef void (APIENTRYP GlDeleteFunction)(GLsizei n, const GLuint *names);
+
+// a Gen call: new names here for the captured ones
+static void genNames(GlReplayReader &reader, std::unordered_map<unsigned int, unsigned int> &map, GlGenFunction gen)
+{
+    GLsizei n = reader.get<int32_t>();
+    const GLuint *captured = static_cast<const GLuint *>(reader.getData());
+    std::vector<GLuint> names((size_t)n);
+    gen(n, names.data());
+    for (GLsizei i = 0; i < n; i++)
+        map[captured[i]] = names[i];
+}
+
+static void deleteNames(GlReplayReader &reader, std::unordered_map<unsigned int, unsigned int> &map, GlDeleteFunction remove)
+{
+    GLsizei n = reader.get<int32_t>();
+    const GLuint *captured = static_cast<const GLuint *>(reader.getData());
+    std::vector<GLuint> names;
+    for (GLsizei i = 0; i < n; i++)
+    {
+        std::unordered_map<unsigned int, unsigned int>::iterator found = map.find(captured[i]);
+        if (found == map.end())
+            continue;
+        names.push_back(found->second);
+        map.erase(found);
+    }
+    if (!names.empty())
+        remove((GLsizei)names.size(), names.data());
+}
+
+bool GlReplay::Load(const std::string &path)
+{
+    del();
+    FILE *file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        std::cout << "GL replay: can't read " << path << std::endl;
+        return false;
+    }
+    std::fseek(file, 0, SEEK_END);
+    long length = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    size = length > 0 ? (size_t)length : 0;
+    storage.assign((size + 7) / 8, 0);
+    bool read = std::fread(storage.data(), 1, size, file) == size;
+    std::fclose(file);
+
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(storage.data());
+    uint32_t header[4] = {0, 0, 0, 0};
+    if (read && size >= sizeof(header))
+        std::memcpy(header, bytes, sizeof(header));
+    if (std::memcmp(&header[0], GL_CAPTURE_MAGIC, sizeof(GL_CAPTURE_MAGIC)) != 0 || header[1] != GL_CAPTURE_VERSION)
+    {
+        std::cout << "GL replay: " << path << " isn't a GL capture (version " << GL_CAPTURE_VERSION << ")" << std::endl;
+        storage.clear();
+        return false;
+    }
+    width = (int)header[2];
+    height = (int)header[3];
+    setupBegin = sizeof(header);
+
+    frames.clear();
+    size_t offset = setupBegin;
+    while (offset + 2 * sizeof(uint32_t) <= size)
+    {
+        uint32_t record[2];
+        std::memcpy(record, bytes + offset, sizeof(record));
+        size_t next = offset + sizeof(record) + record[1];
+        // a run that crashed leaves a partial record at the end
+        if (next > size)
+            break;
+        if (record[0] == GLCALL_FRAME)
+            frames.push_back(offset);
+        offset = next;
+    }
+    if (offset < size)
+        std::cout << "GL replay: " << path << " ends in a partial record, playing up to it" << std::endl;
+    size = offset;
+    if (frames.empty())
+    {
+        std::cout << "GL replay: " << path << " has no frames" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void GlReplay::PlaySetup()
+{
+    play(setupBegin, frames.empty() ? size : frames.front());
+}
+
+void GlReplay::PlayFrame(unsigned int frame)
+{
+    if (frame >= frames.size())
+        return;
+    play(frames[frame], frame + 1 < frames.size() ? frames[frame + 1] : size);
+}
+
+unsigned int GlReplay::name(const NameMap &map, unsigned int captured) const
+{
+    if (captured == 0)
+        return &map == &framebuffers ? defaultFramebuffer : 0;
+    NameMap::const_iterator found = map.find(captured);
+    return found == map.end() ? captured : found->second;
+}
+
+int GlReplay::location(int captured) const
+{
+    if (captured < 0)
+        return captured;
+    std::unordered_map<uint64_t, int>::const_iterator found = locations.find((uint64_t)program << 32 | (uint32_t)captured);
+    return found == locations.end() ? captured : found->second;
+}
+
+void GlReplay::play(size_t begin, size_t end)
+{
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(storage.data());
+    calls = 0;
+    size_t offset = begin;
+    while (offset < end)
+    {
+        uint32_t record[2];
+        std::memcpy(record, bytes + offset, sizeof(record));
+        GlReplayReader reader = {bytes + offset + sizeof(record)};
+        offset += sizeof(record) + record[1];
+        calls++;
+
+        switch (record[0])
+        {
+        case GLCALL_FRAME:
+            calls--;
+            break;
+        case GLCALL_ENABLE:
+            glEnable(reader.get<GLenum>());
+            break;
+        case GLCALL_DISABLE:
+            glDisable(reader.get<GLenum>());
+            break;
+        case GLCALL_BLEND_FUNC: {
+            GLenum sfactor = reader.get<GLenum>();
+            glBlendFunc(sfactor, reader.get<GLenum>());
+            break;
+        }
+        case GLCALL_DEPTH_FUNC:
+            glDepthFunc(reader.get<GLenum>());
+            break;
+        case GLCALL_DEPTH_MASK:
+            glDepthMask(reader.get<GLboolean>());
+            break;
+        case GLCALL_COLOR_MASK: {
+            GLboolean red = reader.get<GLboolean>();
+            GLboolean green = reader.get<GLboolean>();
+            GLboolean blue = reader.get<GLboolean>();
+            glColorMask(red, green, blue, reader.get<GLboolean>());
+            break;
+        }
+        case GLCALL_CULL_FACE:
+            glCullFace(reader.get<GLenum>());
+            break;
+        case GLCALL_VIEWPORT:
+        case GLCALL_SCISSOR: {
+            GLint x = reader.get<GLint>();
+            GLint y = reader.get<GLint>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            if (record[0] == GLCALL_VIEWPORT)
+                glViewport(x, y, w, h);
+            else
+                glScissor(x, y, w, h);
+            break;
+        }
+        case GLCALL_CLEAR_COLOR: {
+            GLfloat red = reader.get<GLfloat>();
+            GLfloat green = reader.get<GLfloat>();
+            GLfloat blue = reader.get<GLfloat>();
+            glClearColor(red, green, blue, reader.get<GLfloat>());
+            break;
+        }
+        case GLCALL_CLEAR:
+            glClear(reader.get<GLbitfield>());
+            break;
+        case GLCALL_DRAW_ARRAYS: {
+            GLenum mode = reader.get<GLenum>();
+            GLint first = reader.get<GLint>();
+            glDrawArrays(mode, first, reader.get<GLsizei>());
+            break;
+        }
+        case GLCALL_DRAW_ELEMENTS: {
+            GLenum mode = reader.get<GLenum>();
+            GLsizei count = reader.get<GLsizei>();
+            GLenum type = reader.get<GLenum>();
+            glDrawElements(mode, count, type, reinterpret_cast<const void *>((uintptr_t)reader.get<uint64_t>()));
+            break;
+        }
+        case GLCALL_DRAW_ARRAYS_INSTANCED: {
+            GLenum mode = reader.get<GLenum>();
+            GLint first = reader.get<GLint>();
+            GLsizei count = reader.get<GLsizei>();
+            glDrawArraysInstanced(mode, first, count, reader.get<GLsizei>());
+            break;
+        }
+        case GLCALL_DRAW_ELEMENTS_INSTANCED: {
+            GLenum mode = reader.get<GLenum>();
+            GLsizei count = reader.get<GLsizei>();
+            GLenum type = reader.get<GLenum>();
+            const void *indices = reinterpret_cast<const void *>((uintptr_t)reader.get<uint64_t>());
+            glDrawElementsInstanced(mode, count, type, indices, reader.get<GLsizei>());
+            break;
+        }
+        case GLCALL_PIXEL_STORE: {
+            GLenum pname = reader.get<GLenum>();
+            glPixelStorei(pname, reader.get<GLint>());
+            break;
+        }
+        case GLCALL_ACTIVE_TEXTURE:
+            glActiveTexture(reader.get<GLenum>());
+            break;
+        case GLCALL_GEN_TEXTURES:
+            genNames(reader, textures, glGenTextures);
+            break;
+        case GLCALL_DELETE_TEXTURES:
+            deleteNames(reader, textures, glDeleteTextures);
+            break;
+        case GLCALL_BIND_TEXTURE: {
+            GLenum target = reader.get<GLenum>();
+            glBindTexture(target, name(textures, reader.get<GLuint>()));
+            break;
+        }
+        case GLCALL_TEX_PARAMETER_I: {
+            GLenum target = reader.get<GLenum>();
+            GLenum pname = reader.get<GLenum>();
+            glTexParameteri(target, pname, reader.get<GLint>());
+            break;
+        }
+        case GLCALL_TEX_PARAMETER_F: {
+            GLenum target = reader.get<GLenum>();
+            GLenum pname = reader.get<GLenum>();
+            glTexParameterf(target, pname, reader.get<GLfloat>());
+            break;
+        }
+        case GLCALL_TEX_IMAGE_2D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLint internalformat = reader.get<GLint>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLint border = reader.get<GLint>();
+            GLenum format = reader.get<GLenum>();
+            GLenum type = reader.get<GLenum>();
+            glTexImage2D(target, level, internalformat, w, h, border, format, type, reader.getPixels());
+            break;
+        }
+        case GLCALL_TEX_SUB_IMAGE_2D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLint x = reader.get<GLint>();
+            GLint y = reader.get<GLint>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLenum format = reader.get<GLenum>();
+            GLenum type = reader.get<GLenum>();
+            glTexSubImage2D(target, level, x, y, w, h, format, type, reader.getPixels());
+            break;
+        }
+        case GLCALL_TEX_IMAGE_3D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLint internalformat = reader.get<GLint>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLsizei d = reader.get<GLsizei>();
+            GLint border = reader.get<GLint>();
+            GLenum format = reader.get<GLenum>();
+            GLenum type = reader.get<GLenum>();
+            glTexImage3D(target, level, internalformat, w, h, d, border, format, type, reader.getPixels());
+            break;
+        }
+        case GLCALL_TEX_SUB_IMAGE_3D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLint x = reader.get<GLint>();
+            GLint y = reader.get<GLint>();
+            GLint z = reader.get<GLint>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLsizei d = reader.get<GLsizei>();
+            GLenum format = reader.get<GLenum>();
+            GLenum type = reader.get<GLenum>();
+            glTexSubImage3D(target, level, x, y, z, w, h, d, format, type, reader.getPixels());
+            break;
+        }
+        case GLCALL_COMPRESSED_TEX_IMAGE_2D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLenum internalformat = reader.get<GLenum>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLint border = reader.get<GLint>();
+            GLsizei imageSize = reader.get<GLsizei>();
+            glCompressedTexImage2D(target, level, internalformat, w, h, border, imageSize, reader.getPixels());
+            break;
+        }
+        case GLCALL_COMPRESSED_TEX_SUB_IMAGE_2D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLint x = reader.get<GLint>();
+            GLint y = reader.get<GLint>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLenum format = reader.get<GLenum>();
+            GLsizei imageSize = reader.get<GLsizei>();
+            glCompressedTexSubImage2D(target, level, x, y, w, h, format, imageSize, reader.getPixels());
+            break;
+        }
+        case GLCALL_COMPRESSED_TEX_IMAGE_3D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLenum internalformat = reader.get<GLenum>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLsizei d = reader.get<GLsizei>();
+            GLint border = reader.get<GLint>();
+            GLsizei imageSize = reader.get<GLsizei>();
+            glCompressedTexImage3D(target, level, internalformat, w, h, d, border, imageSize, reader.getPixels());
+            break;
+        }
+        case GLCALL_COMPRESSED_TEX_SUB_IMAGE_3D: {
+            GLenum target = reader.get<GLenum>();
+            GLint level = reader.get<GLint>();
+            GLint x = reader.get<GLint>();
+            GLint y = reader.get<GLint>();
+            GLint z = reader.get<GLint>();
+            GLsizei w = reader.get<GLsizei>();
+            GLsizei h = reader.get<GLsizei>();
+            GLsizei d = reader.get<GLsizei>();
+            GLenum format = reader.get<GLenum>();
+            GLsizei imageSize = reader.get<GLsizei>();
+            glCompressedTexSubImage3D(target, level, x, y, z, w, h, d, format, imageSize, reader.getPixels());
+            break;
+        }
+        case GLCALL_GENERATE_MIPMAP:
+            glGenerateMipmap(reader.get<GLenum>());
+            break;
+        case GLCALL_GEN_BUFFERS:
+            genNames(reader, buffers, glGenBuffers);
+            break;
+        case GLCALL_DELETE_BUFFERS:
+            deleteNames(reader, buffers, glDeleteBuffers);
+            break;
+        case GLCALL_BIND_BUFFER: {
+            GLenum target = reader.get<GLenum>();
+            glBindBuffer(target, name(buffers, reader.get<GLuint>()));
+            break;
+        }
+        case GLCALL_BUFFER_DATA: {
+            GLenum target = reader.get<GLenum>();
+            GLenum usage = reader.get<GLenum>();
+            GLsizeiptr length = (GLsizeiptr)reader.get<uint64_t>();
+            const void *data = reader.get<uint8_t>() ? reader.getData() : nullptr;
+            glBufferData(target, length, data, usage);
+            break;
+        }
+        case GLCALL_BUFFER_SUB_DATA: {
+            GLenum target = reader.get<GLenum>();
+            GLintptr at = (GLintptr)reader.get<uint64_t>();
+            size_t length;
+            const void *data = reader.getData(length);
+            glBufferSubData(target, at, (GLsizeiptr)length, data);
+            break;
+        }
+        case GLCALL_GEN_VERTEX_ARRAYS:
+            genNames(reader, vertexArrays, glGenVertexArrays);
+            break;
+        case GLCALL_DELETE_VERTEX_ARRAYS:
+            deleteNames(reader, vertexArrays, glDeleteVertexArrays);
+            break;
+        case GLCALL_BIND_VERTEX_ARRAY:
+            glBindVertexArray(name(vertexArrays, reader.get<GLuint>()));
+            break;
+        case GLCALL_ENABLE_VERTEX_ATTRIB_ARRAY:
+            glEnableVertexAttribArray(reader.get<GLuint>());
+            break;
+        case GLCALL_DISABLE_VERTEX_ATTRIB_ARRAY:
+            glDisableVertexAttribArray(reader.get<GLuint>());
+            break;
+        case GLCALL_VERTEX_ATTRIB_POINTER: {
+            GLuint index = reader.get<GLuint>();
+            GLint components = reader.get<GLint>();
+            GLenum type = reader.get<GLenum>();
+            GLboolean normalized = reader.get<GLboolean>();
+            GLsizei stride = reader.get<GLsizei>();
+            glVertexAttribPointer(index, components, type, normalized, stride,
+                                  reinterpret_cast<const void *>((uintptr_t)reader.get<uint64_t>()));
+            break;
+        }
+        case GLCALL_VERTEX_ATTRIB_I_POINTER: {
+            GLuint index = reader.get<GLuint>();
+            GLint components = reader.get<GLint>();
+            GLenum type = reader.get<GLenum>();
+            GLsizei stride = reader.get<GLsizei>();
+            glVertexAttribIPointer(index, components, type, stride,
+                                   reinterpret_cast<const void *>((uintptr_t)reader.get<uint64_t>()));
+            break;
+        }
+        case GLCALL_VERTEX_ATTRIB_DIVISOR: {
+            GLuint index = reader.get<GLuint>();
+            glVertexAttribDivisor(index, reader.get<GLuint>());
+            break;
+        }
+        case GLCALL_GEN_FRAMEBUFFERS:
+            genNames(reader, framebuffers, glGenFramebuffers);
+            break;
+        case GLCALL_DELETE_FRAMEBUFFERS:
+            deleteNames(reader, framebuffers, glDeleteFramebuffers);
+            break;
+        case GLCALL_BIND_FRAMEBUFFER: {
+            GLenum target = reader.get<GLenum>();
+            glBindFramebuffer(target, name(framebuffers, reader.get<GLuint>()));
+            break;
+        }
+        case GLCALL_FRAMEBUFFER_TEXTURE_2D: {
+            GLenum target = reader.get<GLenum>();
+            GLenum attachment = reader.get<GLenum>();
+            GLenum textarget = reader.get<GLenum>();
+            GLuint texture = name(textures, reader.get<GLuint>());
+            glFramebufferTexture2D(target, attachment, textarget, texture, reader.get<GLint>());
+            break;
+        }
+        case GLCALL_FRAMEBUFFER_RENDERBUFFER: {
+            GLenum target = reader.get<GLenum>();
+            GLenum attachment = reader.get<GLenum>();
+            GLenum renderbuffertarget = reader.get<GLenum>();
+            glFramebufferRenderbuffer(target, attachment, renderbuffertarget, name(renderbuffers, reader.get<GLuint>()));
+            break;
+        }
+        case GLCALL_GEN_RENDERBUFFERS:
+            genNames(reader, renderbuffers, glGenRenderbuffers);
+            break;
+        case GLCALL_DELETE_RENDERBUFFERS:
+            deleteNames(reader, renderbuffers, glDeleteRenderbuffers);
+            break;
+        case GLCALL_BIND_RENDERBUFFER: {
+            GLenum target = reader.get<GLenum>();
+            glBindRenderbuffer(target, name(renderbuffers, reader.get<GLuint>()));
+            break;
+        }
+        case GLCALL_RENDERBUFFER_STORAGE: {
+            GLenum target = reader.get<GLenum>();
+            GLenum internalformat = reader.get<GLenum>();
+            GLsizei w = reader.get<GLsizei>();
+            glRenderbufferStorage(target, internalformat, w, reader.get<GLsizei>());
+            break;
+        }
+        case GLCALL_CREATE_SHADER: {
+            GLenum type = reader.get<GLenum>();
+            shaders[reader.get<GLuint>()] = glCreateShader(type);
+            break;
+        }
+        case GLCALL_SHADER_SOURCE: {
+            GLuint shader = name(shaders, reader.get<GLuint>());
+            GLsizei count = reader.get<GLsizei>();
+            std::vector<const GLchar *> strings;
+            std::vector<GLint> lengths;
+            for (GLsizei i = 0; i < count; i++)
+            {
+                size_t length;
+                strings.push_back(static_cast<const GLchar *>(reader.getData(length)));
+                lengths.push_back((GLint)length);
+            }
+            glShaderSource(shader, count, strings.data(), lengths.data());
+            break;
+        }
+        case GLCALL_COMPILE_SHADER:
+            glCompileShader(name(shaders, reader.get<GLuint>()));
+            break;
+        case GLCALL_DELETE_SHADER: {
+            GLuint captured = reader.get<GLuint>();
+            glDeleteShader(name(shaders, captured));
+            shaders.erase(captured);
+            break;
+        }
+        case GLCALL_CREATE_PROGRAM:
+            programs[reader.get<GLuint>()] = glCreateProgram();
+            break;
+        case GLCALL_ATTACH_SHADER: {
+            GLuint attachTo = name(programs, reader.get<GLuint>());
+            glAttachShader(attachTo, name(shaders, reader.get<GLuint>()));
+            break;
+        }
+        case GLCALL_LINK_PROGRAM:
+            glLinkProgram(name(programs, reader.get<GLuint>()));
+            break;
+        case GLCALL_USE_PROGRAM:
+            program = reader.get<GLuint>();
+            glUseProgram(name(programs, program));
+            break;
+        case GLCALL_DELETE_PROGRAM: {
+            GLuint captured = reader.get<GLuint>();
+            glDeleteProgram(name(programs, captured));
+            programs.erase(captured);
+            break;
+        }
+        case GLCALL_GET_UNIFORM_LOCATION: {
+            GLuint captured = reader.get<GLuint>();
+            GLint capturedLocation = reader.get<GLint>();
+            size_t length;
+            const char *uniform = static_cast<const char *>(reader.getData(length));
+            std::string uniformName(uniform, length);
+            GLint here = glGetUniformLocation(name(programs, captured), uniformName.c_str());
+            if (capturedLocation >= 0)
+                locations[(uint64_t)captured << 32 | (uint32_t)capturedLocation] = here;
+            break;
+        }
+        case GLCALL_UNIFORM_1I: {
+            GLint at = location(reader.get<GLint>());
+            glUniform1i(at, reader.get<GLint>());
+            break;
+        }
+        case GLCALL_UNIFORM_1F: {
+            GLint at = location(reader.get<GLint>());
+            glUniform1f(at, reader.get<GLfloat>());
+            break;
+        }
+        case GLCALL_UNIFORM_2F: {
+            GLint at = location(reader.get<GLint>());
+            GLfloat v0 = reader.get<GLfloat>();
+            glUniform2f(at, v0, reader.get<GLfloat>());
+            break;
+        }
+        case GLCALL_UNIFORM_3F: {
+            GLint at = location(reader.get<GLint>());
+            GLfloat v0 = reader.get<GLfloat>();
+            GLfloat v1 = reader.get<GLfloat>();
+            glUniform3f(at, v0, v1, reader.get<GLfloat>());
+            break;
+        }
+        case GLCALL_UNIFORM_4F: {
+            GLint at = location(reader.get<GLint>());
+            GLfloat v0 = reader.get<GLfloat>();
+            GLfloat v1 = reader.get<GLfloat>();
+            GLfloat v2 = reader.get<GLfloat>();
+            glUniform4f(at, v0, v1, v2, reader.get<GLfloat>());
+            break;
+        }
+        case GLCALL_UNIFORM_3FV:
+        case GLCALL_UNIFORM_4FV: {
+            GLint at = location(reader.get<GLint>());
+            GLsizei count = reader.get<GLsizei>();
+            const GLfloat *value = static_cast<const GLfloat *>(reader.getData());
+            if (record[0] == GLCALL_UNIFORM_3FV)
+                glUniform3fv(at, count, value);
+            else
+                glUniform4fv(at, count, value);
+            break;
+        }
+        case GLCALL_UNIFORM_MATRIX_3FV:
+        case GLCALL_UNIFORM_MATRIX_4FV: {
+            GLint at = location(reader.get<GLint>());
+            GLsizei count = reader.get<GLsizei>();
+            GLboolean transpose = reader.get<GLboolean>();
+            const GLfloat *value = static_cast<const GLfloat *>(reader.getData());
+            if (record[0] == GLCALL_UNIFORM_MATRIX_3FV)
+                glUniformMatrix3fv(at, count, transpose, value);
+            else
+                glUniformMatrix4fv(at, count, transpose, value);
+            break;
+        }
+        case GLCALL_GEN_QUERIES:
+            genNames(reader, queries, glGenQueries);
+            break;
+        case GLCALL_DELETE_QUERIES:
+            deleteNames(reader, queries, glDeleteQueries);
+            break;
+        case GLCALL_BEGIN_QUERY: {
+            GLenum target = reader.get<GLenum>();
+            glBeginQuery(target, name(queries, reader.get<GLuint>()));
+            break;
+        }
+        case GLCALL_END_QUERY:
+            glEndQuery(reader.get<GLenum>());
+            break;
+        case GLCALL_QUERY_COUNTER: {
+            GLuint query = name(queries, reader.get<GLuint>());
+            glQueryCounter(query, reader.get<GLenum>());
+            break;
+        }
+        default:
+            // written by a newer capture, its size lets it be skipped
+            calls--;
+            break;
+        }
+    }
+}
+
+void GlReplay::del()
+{
+    std::vector<GLuint> names;
+    // the names a map holds here, deleted with one call
+    auto release = [&names](NameMap &map, GlDeleteFunction remove) {
+        names.clear();
+        for (const NameMap::value_type &entry : map)
+            names.push_back(entry.second);
+        if (!names.empty())
+            remove((GLsizei)names.size(), names.data());
+        map.clear();
+    };
+    // nothing to delete without a context, which only a loaded capture implies
+    if (!storage.empty())
+    {
+        release(buffers, glDeleteBuffers);
+        release(textures, glDeleteTextures);
+        release(vertexArrays, glDeleteVertexArrays);
+        release(framebuffers, glDeleteFramebuffers);
+        release(renderbuffers, glDeleteRenderbuffers);
+        release(queries, glDeleteQueries);
+        for (const NameMap::value_type &entry : shaders)
+            glDeleteShader(entry.second);
+        for (const NameMap::value_type &entry : programs)
+            glDeleteProgram(entry.second);
+    }
+    shaders.clear();
+    programs.clear();
+    locations.clear();
+    storage.clear();
+    frames.clear();
+    size = 0;
+    program = 0;
+}
@@ -0,0 +1,141 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <gpu_profiler.h>
+
+#include <iostream>
+
+GpuProfiler &GpuProfiler::Instance()
+{
+    static GpuProfiler profiler;
+    return profiler;
+}
+
+bool GpuProfiler::init()
+{
+    if (!GLAD_GL_VERSION_3_3 && !GLAD_GL_ARB_timer_query)
+    {
+        std::cout << "GpuProfiler: no timer queries, GPU zones are off" << std::endl;
+        return false;
+    }
+    // the GPU clock read now (no commands are pending that it would have to wait for) against the CPU's
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    Profiler::Instance().SyncGpuClock((uint64_t)gpuNow, ProfileTimestamp());
+    return true;
+}
+
+bool GpuProfiler::BeginFrame()
+{
+    if (state == 0)
+        state = init() ? 1 : -1;
+    if (state < 0)
+        return false;
+
+    // zones left open are cut off with the frame
+    open.clear();
+    current = (current + 1) % GPU_PROFILE_FRAMES;
+    return collect(frames[current], false);
+}
+
+unsigned int GpuProfiler::nextQuery(Frame &frame)
+{
+    if (frame.used == frame.queries.size())
+    {
+        // grows in steps, a frame's zone count settles after the first few frames
+        size_t grown = frame.queries.empty() ? 16 : frame.queries.size() * 2;
+        size_t old = frame.queries.size();
+        frame.queries.resize(grown);
+        glGenQueries((GLsizei)(grown - old), frame.queries.data() + old);
+    }
+    return frame.queries[frame.used++];
+}
+
+void GpuProfiler::Begin(const char *name)
+{
+    if (state <= 0)
+    {
+        open.push_back(~0u);
+        return;
+    }
+    Frame &frame = frames[current];
+    Zone zone;
+    zone.name = name;
+    zone.beginQuery = nextQuery(frame);
+    zone.endQuery = 0;
+    zone.depth = (unsigned int)open.size();
+    glQueryCounter(zone.beginQuery, GL_TIMESTAMP);
+    open.push_back((unsigned int)frame.zones.size());
+    frame.zones.push_back(zone);
+}
+
+void GpuProfiler::End()
+{
+    if (open.empty())
+        return;
+    unsigned int index = open.back();
+    open.pop_back();
+    if (index == ~0u || state <= 0)
+        return;
+    Frame &frame = frames[current];
+    frame.zones[index].endQuery = nextQuery(frame);
+    glQueryCounter(frame.zones[index].endQuery, GL_TIMESTAMP);
+}
+
+bool GpuProfiler::collect(Frame &frame, bool wait)
+{
+    bool collected = false;
+    if (frame.used > 0)
+    {
+        // timestamps complete in order, so once the frame's last one is there all of them are
+        GLuint available = GL_TRUE;
+        if (!wait)
+            glGetQueryObjectuiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available)
+        {
+            double frameMs = 0.0;
+            for (const Zone &zone : frame.zones)
+            {
+                if (zone.endQuery == 0)
+                    continue;
+                GLuint64 begin = 0, end = 0;
+                glGetQueryObjectui64v(zone.beginQuery, GL_QUERY_RESULT, &begin);
+                glGetQueryObjectui64v(zone.endQuery, GL_QUERY_RESULT, &end);
+                Profiler::Instance().RecordGpu(zone.name, begin, end);
+                if (zone.depth == 0)
+                    frameMs += (double)(end - begin) / 1.0e6;
+            }
+            lastFrameMs = frameMs;
+            collected = true;
+        }
+        else
+            dropped++;
+    }
+    frame.used = 0;
+    frame.zones.clear();
+    return collected;
+}
+
+void GpuProfiler::Flush()
+{
+    if (state <= 0)
+        return;
+    // oldest first, the current frame last
+    for (unsigned int i = 1; i <= GPU_PROFILE_FRAMES; i++)
+        collect(frames[(current + i) % GPU_PROFILE_FRAMES], true);
+}
+
+void GpuProfiler::del()
+{
+    for (Frame &frame : frames)
+    {
+        if (!frame.queries.empty())
+            glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+        frame.queries.clear();
+        frame.used = 0;
+        frame.zones.clear();
+    }
+    open.clear();
+    state = 0;
+}
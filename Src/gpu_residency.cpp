@@ -0,0 +1,224 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <gpu_residency.h>
+
+#include <algorithm>
+#include <iostream>
+
+// no texture in the project has more levels than a 32k one
+static const int MAX_TEXTURE_LEVELS = 16;
+
+void EvictBuffer(unsigned int buffer)
+{
+    // the copy target isn't part of any VAO, so this doesn't disturb element buffer bindings
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, 0, NULL, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+void EvictTexture(unsigned int textureID)
+{
+    GLint maxLevel = 0;
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+    for (int level = 0; level <= std::min(maxLevel, MAX_TEXTURE_LEVELS - 1); level++)
+        glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+}
+
+size_t TextureBytes(unsigned int textureID)
+{
+    GLint baseLevel = 0, maxLevel = 0;
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, &baseLevel);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+
+    size_t bytes = 0;
+    for (int level = baseLevel; level <= std::min(maxLevel, MAX_TEXTURE_LEVELS - 1); level++)
+    {
+        GLint width = 0, height = 0, compressed = GL_FALSE;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_HEIGHT, &height);
+        if (width == 0 || height == 0)
+            break;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED, &compressed);
+        if (compressed)
+        {
+            GLint size = 0;
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &size);
+            bytes += (size_t)size;
+            continue;
+        }
+        GLint red = 0, green = 0, blue = 0, alpha = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_RED_SIZE, &red);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_GREEN_SIZE, &green);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_BLUE_SIZE, &blue);
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, level, GL_TEXTURE_ALPHA_SIZE, &alpha);
+        bytes += (size_t)width * height * (size_t)(red + green + blue + alpha) / 8;
+    }
+    return bytes;
+}
+
+GpuResidency &GpuResidency::Instance()
+{
+    static GpuResidency residency;
+    return residency;
+}
+
+void GpuResidency::list(const Resource &resource)
+{
+    if (resource.resident && resource.evict)
+        evictionOrder.insert(recency(resource));
+}
+
+void GpuResidency::unlist(const Resource &resource)
+{
+    if (resource.resident && resource.evict)
+        evictionOrder.erase(recency(resource));
+}
+
+void GpuResidency::addUsage(GpuResourceKind kind, size_t bytes)
+{
+    usedBytes[kind] += bytes;
+    highWaterBytes = std::max(highWaterBytes, UsedBytes());
+}
+
+void GpuResidency::Track(GpuResourceKind kind, unsigned int name, size_t bytes,
+                         std::function<void()> evict, std::function<bool()> reload)
+{
+    // tracking an object twice (e.g. a texture loaded into again) replaces the old entry
+    Untrack(kind, name);
+
+    Resource resource;
+    resource.kind = kind;
+    resource.name = name;
+    resource.bytes = bytes;
+    resource.resident = true;
+    resource.lastUsed = frame;
+    resource.evict = evict;
+    resource.reload = reload;
+    resources.emplace(key(kind, name), resource);
+    list(resource);
+    addUsage(kind, bytes);
+
+    // the new resource is part of the working set, so this only pushes out older ones
+    Reserve(0);
+}
+
+void GpuResidency::Resize(GpuResourceKind kind, unsigned int name, size_t bytes)
+{
+    auto it = resources.find(key(kind, name));
+    if (it == resources.end())
+        return;
+    Resource &resource = it->second;
+    if (resource.resident)
+    {
+        usedBytes[kind] -= resource.bytes;
+        addUsage(kind, bytes);
+    }
+    else
+    {
+        evictedBytes -= resource.bytes;
+        evictedBytes += bytes;
+    }
+    unlist(resource);
+    resource.bytes = bytes;
+    list(resource);
+}
+
+void GpuResidency::Untrack(GpuResourceKind kind, unsigned int name)
+{
+    auto it = resources.find(key(kind, name));
+    if (it == resources.end())
+        return;
+    if (it->second.resident)
+        usedBytes[kind] -= it->second.bytes;
+    else
+        evictedBytes -= it->second.bytes;
+    unlist(it->second);
+    resources.erase(it);
+}
+
+bool GpuResidency::Touch(GpuResourceKind kind, unsigned int name)
+{
+    auto it = resources.find(key(kind, name));
+    if (it == resources.end())
+        return true;
+    Resource &resource = it->second;
+    if (resource.resident)
+    {
+        // already last in the eviction order when touched earlier this frame
+        if (resource.lastUsed != frame)
+        {
+            unlist(resource);
+            resource.lastUsed = frame;
+            list(resource);
+        }
+        return true;
+    }
+
+    // it's drawn now either way, so it comes back even if nothing else can make room. Being in the working set, it
+    // can't be picked by Reserve before it's resident
+    resource.lastUsed = frame;
+    Reserve(resource.bytes);
+    resource.resident = true;
+    list(resource);
+    evictedBytes -= resource.bytes;
+    addUsage(kind, resource.bytes);
+    reloads++;
+    if (!resource.reload)
+        return false;
+    if (!resource.reload())
+        std::cout << "GpuResidency: failed to reload " << (kind == GPU_TEXTURE ? "texture " : "buffer ") << name << std::endl;
+    return true;
+}
+
+GpuResidency::Resource *GpuResidency::pickVictim()
+{
+    // the first in the order is the coldest; if even it was drawn recently, everything else was too
+    if (evictionOrder.empty())
+        return nullptr;
+    const Recency &coldest = *evictionOrder.begin();
+    if (frame - coldest.lastUsed <= RESIDENCY_WORKING_SET_FRAMES)
+        return nullptr;
+    return &resources.at(coldest.key);
+}
+
+void GpuResidency::evictResource(Resource &resource)
+{
+    unlist(resource);
+    resource.evict();
+    resource.resident = false;
+    usedBytes[resource.kind] -= resource.bytes;
+    evictedBytes += resource.bytes;
+    evictions++;
+}
+
+bool GpuResidency::Reserve(size_t bytes)
+{
+    if (budget == 0)
+        return true;
+    while (UsedBytes() + bytes > budget)
+    {
+        Resource *victim = pickVictim();
+        if (victim == nullptr)
+        {
+            // only said once, a scene that doesn't fit would otherwise print this every frame
+            if (!warnedWorkingSet)
+                std::cout << "GpuResidency: " << (UsedBytes() + bytes) / (1024 * 1024) << " MB in use by the working set, over the budget of "
+                          << budget / (1024 * 1024) << " MB" << std::endl;
+            warnedWorkingSet = true;
+            return false;
+        }
+        evictResource(*victim);
+    }
+    return true;
+}
+
+void GpuResidency::EndFrame()
+{
+    Reserve(0);
+    // resources touched from now on belong to the next frame
+    frame++;
+}
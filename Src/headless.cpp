@@ -0,0 +1,206 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <headless.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifdef BLOB_SEA_HEADLESS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+// surfaceless first: it needs no X server, no DRM device and no GBM, only Mesa
+static EGLDisplay openDisplay()
+{
+    const char *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless") && getPlatformDisplay)
+    {
+        EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL))
+            return display;
+    }
+    EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (display != EGL_NO_DISPLAY && eglInitialize(display, NULL, NULL))
+        return display;
+    return EGL_NO_DISPLAY;
+}
+#endif
+
+bool HeadlessContext::Create()
+{
+#ifdef BLOB_SEA_HEADLESS
+    EGLDisplay eglDisplay = openDisplay();
+    if (eglDisplay == EGL_NO_DISPLAY)
+    {
+        std::cout << "Headless: no EGL display" << std::endl;
+        return false;
+    }
+    display = eglDisplay;
+
+    const char *extensions = eglQueryString(eglDisplay, EGL_EXTENSIONS);
+    if (!extensions || !std::strstr(extensions, "EGL_KHR_surfaceless_context"))
+    {
+        std::cout << "Headless: the EGL display can't make a context current without a surface" << std::endl;
+        del();
+        return false;
+    }
+    if (!eglBindAPI(EGL_OPENGL_API))
+    {
+        std::cout << "Headless: EGL has no desktop OpenGL" << std::endl;
+        del();
+        return false;
+    }
+
+    // no surface is ever created, the config only has to be able to render desktop GL
+    const EGLint configAttributes[] = {
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_SURFACE_TYPE, 0,
+            EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configs = 0;
+    if (!eglChooseConfig(eglDisplay, configAttributes, &config, 1, &configs) || configs == 0)
+    {
+        std::cout << "Headless: no EGL config for desktop OpenGL" << std::endl;
+        del();
+        return false;
+    }
+
+    // the same 3.3 core profile the windowed mode asks GLFW for
+    const EGLint contextAttributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+    };
+    EGLContext eglContext = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttributes);
+    if (eglContext == EGL_NO_CONTEXT)
+    {
+        std::cout << "Headless: failed to create an OpenGL 3.3 core context (EGL error 0x" << std::hex << eglGetError() << std::dec << ")" << std::endl;
+        del();
+        return false;
+    }
+    context = eglContext;
+
+    if (!eglMakeCurrent(eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, eglContext))
+    {
+        std::cout << "Headless: failed to make the context current" << std::endl;
+        del();
+        return false;
+    }
+    return true;
+#else
+    std::cout << "Headless: built without EGL, configure with -DBLOB_SEA_HEADLESS=ON" << std::endl;
+    return false;
+#endif
+}
+
+void *HeadlessContext::GetProcAddress(const char *name)
+{
+#ifdef BLOB_SEA_HEADLESS
+    // EGL 1.5 (and Mesa before it) hands out core functions as well, not just extensions
+    return (void *)eglGetProcAddress(name);
+#else
+    (void)name;
+    return nullptr;
+#endif
+}
+
+std::string HeadlessContext::Renderer() const
+{
+    const GLubyte *renderer = glGetString(GL_RENDERER);
+    return renderer ? std::string((const char *)renderer) : std::string();
+}
+
+void HeadlessContext::del()
+{
+#ifdef BLOB_SEA_HEADLESS
+    if (display)
+    {
+        eglMakeCurrent((EGLDisplay)display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context)
+            eglDestroyContext((EGLDisplay)display, (EGLContext)context);
+        eglTerminate((EGLDisplay)display);
+    }
+#endif
+    display = nullptr;
+    context = nullptr;
+}
+
+bool OffscreenTarget::Create(int width, int height)
+{
+    this->width = width;
+    this->height = height;
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    glGenRenderbuffers(1, &colour);
+    glBindRenderbuffer(GL_RENDERBUFFER, colour);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colour);
+
+    glGenRenderbuffers(1, &depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cout << "Headless: offscreen framebuffer incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+        return false;
+    }
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+void OffscreenTarget::Bind() const
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+}
+
+bool OffscreenTarget::WritePpm(const std::string &path) const
+{
+    std::vector<unsigned char> pixels((size_t)width * height * 3);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        std::cout << "Headless: can't write " << path << std::endl;
+        return false;
+    }
+    std::fprintf(file, "P6\n%d %d\n255\n", width, height);
+    // GL's rows start at the bottom
+    for (int y = height - 1; y >= 0; y--)
+        std::fwrite(pixels.data() + (size_t)y * width * 3, 1, (size_t)width * 3, file);
+    bool written = std::ferror(file) == 0;
+    std::fclose(file);
+    return written;
+}
+
+void OffscreenTarget::del()
+{
+    if (framebuffer)
+        glDeleteFramebuffers(1, &framebuffer);
+    if (colour)
+        glDeleteRenderbuffers(1, &colour);
+    if (depth)
+        glDeleteRenderbuffers(1, &depth);
+    framebuffer = colour = depth = 0;
+}
@@ -0,0 +1,89 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <hitch_recorder.h>
+#include <profiler.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+void HitchRecorder::Configure(float thresholdMs, float windowSeconds, const std::string &prefix)
+{
+    this->thresholdMs = thresholdMs;
+    this->windowSeconds = windowSeconds;
+    this->prefix = prefix;
+#ifdef BLOB_SEA_PROFILE
+    if (thresholdMs > 0.0f && !writer.joinable())
+        writer = std::thread([this]() { writeDumps(); });
+#else
+    if (thresholdMs > 0.0f)
+        std::cout << "Hitch: built without profiler zones, hitches are only logged (configure with -DBLOB_SEA_PROFILE=ON)" << std::endl;
+#endif
+}
+
+void HitchRecorder::writeDumps()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this]() { return dumpPending || stopping; });
+        if (!dumpPending)
+            return;
+        std::string file = dumpPath;
+        uint64_t since = dumpSince;
+        lock.unlock();
+        // the rings hold a fixed number of zones, which busy threads go through in less than the window
+        double lost = 0.0;
+        if (Profiler::Instance().WriteChromeTrace(file, since, &lost) && lost > 0.0)
+            std::cout << "Hitch: " << file << " only covers the last " << std::max(0.0, (double)windowSeconds - lost) << " of "
+                      << windowSeconds << " s, some thread recorded more than PROFILE_RING_EVENTS zones since" << std::endl;
+        lock.lock();
+        dumpPending = false;
+    }
+}
+
+void HitchRecorder::FrameEnded(float ms)
+{
+    frames++;
+    if (thresholdMs <= 0.0f || ms <= thresholdMs)
+        return;
+    hitches++;
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    bool inLastDump = dumps > 0 && now - lastDump < std::chrono::duration<float>(windowSeconds);
+#ifdef BLOB_SEA_PROFILE
+    if (!inLastDump)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        // the previous dump has long finished by now, a window has passed; if not, this hitch is only logged
+        if (!dumpPending)
+        {
+            std::snprintf(dumpPath, sizeof(dumpPath), "%s_%04u.json", prefix.c_str(), dumps + 1);
+            std::cout << "Hitch: frame " << frames << " took " << ms << " ms, writing the last " << windowSeconds
+                      << " s of zones to " << dumpPath << std::endl;
+            dumpSince = Profiler::Instance().TicksAgo(windowSeconds);
+            dumpPending = true;
+            wake.notify_one();
+            dumps++;
+            lastDump = now;
+            return;
+        }
+    }
+#endif
+    std::cout << "Hitch: frame " << frames << " took " << ms << " ms" << (inLastDump ? " (too soon after the last dump to write another)" : "") << std::endl;
+}
+
+void HitchRecorder::del()
+{
+    if (!writer.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    // a pending dump is written first
+    writer.join();
+}
@@ -0,0 +1,98 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <image_decode.h>
+#include <stb_image.h>
+#include <profiler.h>
+#include <alloc_tracker.h>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+static int decodeThreads = 1;
+
+// stb_image's parallel_for hook: the calling thread and decodeThreads - 1 workers pull task indices until
+// they run out, so uneven segments still balance
+static void parallelFor(stbi_parallel_task *task, void *context, int count)
+{
+    int threads = decodeThreads;
+    if (threads <= 0)
+        threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, count);
+
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        ALLOC_SCOPE(ALLOC_TEXTURES);
+        for (int i = next++; i < count; i = next++)
+        {
+            PROFILE_ZONE("decode jpeg segment");
+            task(context, i);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(work);
+    work();
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void SetImageDecodeThreads(int threads)
+{
+    decodeThreads = threads;
+    stbi_set_jpeg_parallel_for(threads == 1 ? nullptr : parallelFor);
+}
+
+static bool readFile(const std::string &path, std::vector<unsigned char> &bytes)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+    bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    return !bytes.empty();
+}
+
+unsigned char *DecodeImageFile(const std::string &path, int *width, int *height, int *components, int channels)
+{
+    PROFILE_ZONE("DecodeImageFile");
+    ALLOC_SCOPE(ALLOC_TEXTURES);
+    std::vector<unsigned char> bytes;
+    if (!readFile(path, bytes))
+        return nullptr;
+    return stbi_load_from_memory(bytes.data(), (int)bytes.size(), width, height, components, channels);
+}
+
+int JpegRestartInterval(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    unsigned char soi[2];
+    if (!in.read((char *)soi, 2) || soi[0] != 0xFF || soi[1] != 0xD8)
+        return -1;
+
+    // walk the marker segments up to the first scan, DRI has to come before it to apply to it
+    unsigned char marker[4];
+    while (in.read((char *)marker, 4))
+    {
+        if (marker[0] != 0xFF)
+            return -1;
+        int length = (marker[2] << 8) | marker[3];
+        if (marker[1] == 0xDA || marker[1] == 0xD9)
+            return 0;
+        if (marker[1] == 0xDD)
+        {
+            unsigned char interval[2];
+            if (!in.read((char *)interval, 2))
+                return -1;
+            return (interval[0] << 8) | interval[1];
+        }
+        if (length < 2)
+            return -1;
+        in.seekg(length - 2, std::ios::cur);
+    }
+    return -1;
+}
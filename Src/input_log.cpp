@@ -0,0 +1,133 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <input_log.h>
+
+#include <cstring>
+#include <iostream>
+
+static const char INPUT_LOG_MAGIC[4] = {'B', 'S', 'I', 'N'};
+static const uint32_t INPUT_LOG_VERSION = 1;
+
+// what follows the time step of a frame
+enum InputLogFlags {
+    INPUT_LOG_MOUSE = 1 << 0,
+    INPUT_LOG_SCROLL = 1 << 1
+};
+
+template<typename T>
+static void write(FILE *file, const T &value)
+{
+    std::fwrite(&value, sizeof(T), 1, file);
+}
+
+template<typename T>
+static bool read(FILE *file, T &value)
+{
+    return std::fread(&value, sizeof(T), 1, file) == 1;
+}
+
+bool InputRecorder::Open(const std::string &path, const InputStart &start)
+{
+    Close();
+    file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        std::cout << "Input: can't write " << path << std::endl;
+        return false;
+    }
+    std::fwrite(INPUT_LOG_MAGIC, 1, sizeof(INPUT_LOG_MAGIC), file);
+    write(file, INPUT_LOG_VERSION);
+    write(file, start.position.x);
+    write(file, start.position.y);
+    write(file, start.position.z);
+    write(file, start.yaw);
+    write(file, start.pitch);
+    write(file, start.zoom);
+    write(file, start.blobX);
+    write(file, start.blobZ);
+    frames = 0;
+    return true;
+}
+
+void InputRecorder::Add(const FrameInput &input)
+{
+    if (!file)
+        return;
+    uint8_t flags = 0;
+    if (input.mouseX != 0.0f || input.mouseY != 0.0f)
+        flags |= INPUT_LOG_MOUSE;
+    if (input.scroll != 0.0f)
+        flags |= INPUT_LOG_SCROLL;
+    write(file, input.keys);
+    write(file, flags);
+    write(file, input.deltaTime);
+    if (flags & INPUT_LOG_MOUSE)
+    {
+        write(file, input.mouseX);
+        write(file, input.mouseY);
+    }
+    if (flags & INPUT_LOG_SCROLL)
+        write(file, input.scroll);
+    frames++;
+}
+
+void InputRecorder::Close()
+{
+    if (!file)
+        return;
+    std::fclose(file);
+    file = nullptr;
+}
+
+bool InputPlayback::Open(const std::string &path)
+{
+    Close();
+    file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        std::cout << "Input: can't read " << path << std::endl;
+        return false;
+    }
+    char magic[4];
+    uint32_t version = 0;
+    bool valid = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                 std::memcmp(magic, INPUT_LOG_MAGIC, sizeof(magic)) == 0 && read(file, version) &&
+                 version == INPUT_LOG_VERSION &&
+                 read(file, start.position.x) && read(file, start.position.y) && read(file, start.position.z) &&
+                 read(file, start.yaw) && read(file, start.pitch) && read(file, start.zoom) &&
+                 read(file, start.blobX) && read(file, start.blobZ);
+    if (!valid)
+    {
+        std::cout << "Input: " << path << " isn't an input log (version " << INPUT_LOG_VERSION << ")" << std::endl;
+        Close();
+        return false;
+    }
+    frames = 0;
+    return true;
+}
+
+bool InputPlayback::Next(FrameInput &input)
+{
+    if (!file)
+        return false;
+    uint8_t flags = 0;
+    input = FrameInput();
+    if (!read(file, input.keys) || !read(file, flags) || !read(file, input.deltaTime))
+        return false;
+    if ((flags & INPUT_LOG_MOUSE) && !(read(file, input.mouseX) && read(file, input.mouseY)))
+        return false;
+    if ((flags & INPUT_LOG_SCROLL) && !read(file, input.scroll))
+        return false;
+    frames++;
+    return true;
+}
+
+void InputPlayback::Close()
+{
+    if (!file)
+        return;
+    std::fclose(file);
+    file = nullptr;
+}
@@ -0,0 +1,412 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <jpeg_writer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+// zigzag position -> natural (row major) index inside an 8x8 block
+static const unsigned char ZIGZAG[64] = {
+    0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+// quantization tables of the JPEG standard (annex K.1), natural order, for quality 50
+static const unsigned char LUMA_QUANT[64] = {
+    16, 11, 10, 16, 24, 40, 51, 61,
+    12, 12, 14, 19, 26, 58, 60, 55,
+    14, 13, 16, 24, 40, 57, 69, 56,
+    14, 17, 22, 29, 51, 87, 80, 62,
+    18, 22, 37, 56, 68, 109, 103, 77,
+    24, 35, 55, 64, 81, 104, 113, 92,
+    49, 64, 78, 87, 103, 121, 120, 101,
+    72, 92, 95, 98, 112, 100, 103, 99
+};
+static const unsigned char CHROMA_QUANT[64] = {
+    17, 18, 24, 47, 99, 99, 99, 99,
+    18, 21, 26, 66, 99, 99, 99, 99,
+    24, 26, 56, 99, 99, 99, 99, 99,
+    47, 66, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 99, 99, 99
+};
+
+// huffman tables of the JPEG standard (annex K.3): code counts per length, then the symbols
+static const unsigned char DC_LUMA_BITS[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+static const unsigned char DC_CHROMA_BITS[16] = {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+static const unsigned char DC_VALUES[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+
+static const unsigned char AC_LUMA_BITS[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7d};
+static const unsigned char AC_LUMA_VALUES[162] = {
+    0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+    0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0,
+    0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+    0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+    0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+    0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+    0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5,
+    0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+    0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+static const unsigned char AC_CHROMA_BITS[16] = {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+static const unsigned char AC_CHROMA_VALUES[162] = {
+    0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+    0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0,
+    0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26,
+    0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+    0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+    0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+    0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5,
+    0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+    0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+    0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8,
+    0xf9, 0xfa
+};
+
+struct HuffmanTable {
+    const unsigned char *bits;
+    const unsigned char *values;
+    int count;
+    unsigned short code[256];
+    unsigned char length[256];
+
+    HuffmanTable(const unsigned char *bits, const unsigned char *values, int count)
+        : bits(bits), values(values), count(count), code(), length()
+    {
+        // canonical codes: consecutive within a length, shifted left when moving to the next one
+        int next = 0, k = 0;
+        for (int len = 1; len <= 16; len++)
+        {
+            for (int i = 0; i < bits[len - 1]; i++, k++)
+            {
+                code[values[k]] = (unsigned short)next++;
+                length[values[k]] = (unsigned char)len;
+            }
+            next <<= 1;
+        }
+    }
+};
+
+// entropy coded data with 0xFF byte stuffing
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<unsigned char> &out) : out(out) {}
+
+    void Put(unsigned int bits, int count)
+    {
+        buffer = (buffer << count) | (bits & ((1u << count) - 1));
+        pending += count;
+        while (pending >= 8)
+        {
+            unsigned char byte = (unsigned char)(buffer >> (pending - 8));
+            out.push_back(byte);
+            if (byte == 0xFF)
+                out.push_back(0);
+            pending -= 8;
+        }
+    }
+
+    // pads the last byte with 1 bits, needed before a marker
+    void Flush()
+    {
+        int pad = (8 - pending % 8) % 8;
+        Put((1u << pad) - 1, pad);
+    }
+
+private:
+    std::vector<unsigned char> &out;
+    unsigned int buffer = 0;
+    int pending = 0;
+};
+
+static void putMarker(std::vector<unsigned char> &out, unsigned char marker, int length)
+{
+    out.push_back(0xFF);
+    out.push_back(marker);
+    if (length > 0)
+    {
+        out.push_back((unsigned char)(length >> 8));
+        out.push_back((unsigned char)length);
+    }
+}
+
+static void scaleQuant(const unsigned char *base, int quality, unsigned char *table)
+{
+    quality = std::min(100, std::max(1, quality));
+    int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+    for (int i = 0; i < 64; i++)
+        table[i] = (unsigned char)std::min(255, std::max(1, (base[i] * scale + 50) / 100));
+}
+
+// source pixels with the edges clamped, converted to the JFIF YCbCr components on the fly
+struct SourceImage {
+    const unsigned char *pixels;
+    int width, height, channels;
+
+    float Sample(int component, int x, int y) const
+    {
+        x = std::min(x, width - 1);
+        y = std::min(y, height - 1);
+        const unsigned char *p = pixels + ((size_t)y * width + x) * channels;
+        if (channels < 3)
+            return p[0];
+        float r = p[0], g = p[1], b = p[2];
+        if (component == 0)
+            return 0.299f * r + 0.587f * g + 0.114f * b;
+        if (component == 1)
+            return -0.168736f * r - 0.331264f * g + 0.5f * b + 128.0f;
+        return 0.5f * r - 0.418688f * g - 0.081312f * b + 128.0f;
+    }
+};
+
+// loads one level shifted 8x8 block; a scale of 2 averages 2x2 pixels for subsampled chroma
+static void loadBlock(const SourceImage &image, int component, int x0, int y0, int scale, float block[64])
+{
+    for (int y = 0; y < 8; y++)
+        for (int x = 0; x < 8; x++)
+        {
+            float sum = 0.0f;
+            for (int sy = 0; sy < scale; sy++)
+                for (int sx = 0; sx < scale; sx++)
+                    sum += image.Sample(component, (x0 + x) * scale + sx, (y0 + y) * scale + sy);
+            block[y * 8 + x] = sum / (float)(scale * scale) - 128.0f;
+        }
+}
+
+// DCT basis c[u][x] = C(u) / 2 * cos((2x + 1) u pi / 16), so F = c * f * c^T is the DCT the standard quantizes
+struct DctBasis {
+    float c[8][8];
+
+    DctBasis()
+    {
+        for (int u = 0; u < 8; u++)
+            for (int x = 0; x < 8; x++)
+                c[u][x] = (u == 0 ? std::sqrt(0.125f) : 0.5f) * std::cos((2 * x + 1) * u * 3.14159265358979f / 16.0f);
+    }
+};
+
+static void forwardDct(const DctBasis &basis, const float in[64], float out[64])
+{
+    float rows[64];
+    for (int y = 0; y < 8; y++)
+        for (int u = 0; u < 8; u++)
+        {
+            float sum = 0.0f;
+            for (int x = 0; x < 8; x++)
+                sum += basis.c[u][x] * in[y * 8 + x];
+            rows[y * 8 + u] = sum;
+        }
+    for (int v = 0; v < 8; v++)
+        for (int u = 0; u < 8; u++)
+        {
+            float sum = 0.0f;
+            for (int y = 0; y < 8; y++)
+                sum += basis.c[v][y] * rows[y * 8 + u];
+            out[v * 8 + u] = sum;
+        }
+}
+
+// magnitude category and the extra bits of a coefficient
+static int category(int value, unsigned int &bits)
+{
+    int magnitude = value < 0 ? -value : value;
+    int size = 0;
+    while (magnitude >> size)
+        size++;
+    bits = (unsigned int)(value < 0 ? value - 1 : value);
+    return size;
+}
+
+static void encodeBlock(const float coefficients[64], const unsigned char *quant, int &dcPrediction,
+                        const HuffmanTable &dc, const HuffmanTable &ac, BitWriter &writer)
+{
+    int quantized[64];
+    for (int i = 0; i < 64; i++)
+    {
+        int n = ZIGZAG[i];
+        quantized[i] = (int)std::lround(coefficients[n] / (float)quant[n]);
+    }
+
+    unsigned int bits;
+    int size = category(quantized[0] - dcPrediction, bits);
+    dcPrediction = quantized[0];
+    writer.Put(dc.code[size], dc.length[size]);
+    writer.Put(bits, size);
+
+    int run = 0;
+    for (int i = 1; i < 64; i++)
+    {
+        if (quantized[i] == 0)
+        {
+            run++;
+            continue;
+        }
+        while (run > 15)
+        {
+            writer.Put(ac.code[0xF0], ac.length[0xF0]);
+            run -= 16;
+        }
+        size = category(quantized[i], bits);
+        int symbol = (run << 4) | size;
+        writer.Put(ac.code[symbol], ac.length[symbol]);
+        writer.Put(bits, size);
+        run = 0;
+    }
+    if (run > 0)
+        writer.Put(ac.code[0x00], ac.length[0x00]);
+}
+
+std::vector<unsigned char> EncodeJpeg(const unsigned char *pixels, int width, int height, int channels,
+                                      const JpegEncodeOptions &options)
+{
+    std::vector<unsigned char> out;
+    if (!pixels || width <= 0 || height <= 0 || width > 65535 || height > 65535 || channels < 1 || channels > 4)
+        return out;
+
+    SourceImage image = {pixels, width, height, channels};
+    int components = channels >= 3 ? 3 : 1;
+    bool subsample = components == 3 && options.subsample;
+    int mcuSize = subsample ? 16 : 8;
+    int mcusX = (width + mcuSize - 1) / mcuSize;
+    int mcusY = (height + mcuSize - 1) / mcuSize;
+    int restartInterval = options.restartInterval < 0 ? mcusX : options.restartInterval;
+    restartInterval = std::min(restartInterval, 65535);
+
+    unsigned char quant[2][64];
+    scaleQuant(LUMA_QUANT, options.quality, quant[0]);
+    scaleQuant(CHROMA_QUANT, options.quality, quant[1]);
+
+    static const HuffmanTable dcLuma(DC_LUMA_BITS, DC_VALUES, 12);
+    static const HuffmanTable dcChroma(DC_CHROMA_BITS, DC_VALUES, 12);
+    static const HuffmanTable acLuma(AC_LUMA_BITS, AC_LUMA_VALUES, 162);
+    static const HuffmanTable acChroma(AC_CHROMA_BITS, AC_CHROMA_VALUES, 162);
+    const HuffmanTable *dcTables[2] = {&dcLuma, &dcChroma};
+    const HuffmanTable *acTables[2] = {&acLuma, &acChroma};
+
+    // SOI and JFIF APP0, 1:1 pixel aspect
+    putMarker(out, 0xD8, 0);
+    static const unsigned char jfif[14] = {'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0};
+    putMarker(out, 0xE0, 16);
+    out.insert(out.end(), jfif, jfif + 14);
+
+    int tables = components == 3 ? 2 : 1;
+    putMarker(out, 0xDB, 2 + 65 * tables);
+    for (int t = 0; t < tables; t++)
+    {
+        out.push_back((unsigned char)t);
+        for (int i = 0; i < 64; i++)
+            out.push_back(quant[t][ZIGZAG[i]]);
+    }
+
+    putMarker(out, 0xC0, 8 + 3 * components);
+    out.push_back(8);
+    out.push_back((unsigned char)(height >> 8));
+    out.push_back((unsigned char)height);
+    out.push_back((unsigned char)(width >> 8));
+    out.push_back((unsigned char)width);
+    out.push_back((unsigned char)components);
+    for (int c = 0; c < components; c++)
+    {
+        out.push_back((unsigned char)(c + 1));
+        out.push_back(c == 0 && subsample ? 0x22 : 0x11);
+        out.push_back(c == 0 ? 0 : 1);
+    }
+
+    int dhtLength = 2;
+    for (int t = 0; t < tables; t++)
+        dhtLength += 17 + dcTables[t]->count + 17 + acTables[t]->count;
+    putMarker(out, 0xC4, dhtLength);
+    for (int t = 0; t < tables; t++)
+    {
+        out.push_back((unsigned char)t);
+        out.insert(out.end(), dcTables[t]->bits, dcTables[t]->bits + 16);
+        out.insert(out.end(), dcTables[t]->values, dcTables[t]->values + dcTables[t]->count);
+        out.push_back((unsigned char)(0x10 | t));
+        out.insert(out.end(), acTables[t]->bits, acTables[t]->bits + 16);
+        out.insert(out.end(), acTables[t]->values, acTables[t]->values + acTables[t]->count);
+    }
+
+    if (restartInterval > 0)
+    {
+        putMarker(out, 0xDD, 4);
+        out.push_back((unsigned char)(restartInterval >> 8));
+        out.push_back((unsigned char)restartInterval);
+    }
+
+    putMarker(out, 0xDA, 6 + 2 * components);
+    out.push_back((unsigned char)components);
+    for (int c = 0; c < components; c++)
+    {
+        out.push_back((unsigned char)(c + 1));
+        out.push_back(c == 0 ? 0x00 : 0x11);
+    }
+    out.push_back(0);
+    out.push_back(63);
+    out.push_back(0);
+
+    static const DctBasis basis;
+    BitWriter writer(out);
+    int dcPrediction[3] = {0, 0, 0};
+    int restarts = 0;
+    float block[64], coefficients[64];
+    for (int my = 0; my < mcusY; my++)
+    {
+        for (int mx = 0; mx < mcusX; mx++)
+        {
+            int mcu = my * mcusX + mx;
+            if (restartInterval > 0 && mcu > 0 && mcu % restartInterval == 0)
+            {
+                writer.Flush();
+                putMarker(out, (unsigned char)(0xD0 + (restarts++ & 7)), 0);
+                dcPrediction[0] = dcPrediction[1] = dcPrediction[2] = 0;
+            }
+
+            // luma blocks of the MCU in raster order, then one block per chroma component
+            int lumaBlocks = subsample ? 2 : 1;
+            for (int by = 0; by < lumaBlocks; by++)
+                for (int bx = 0; bx < lumaBlocks; bx++)
+                {
+                    loadBlock(image, 0, mx * mcuSize + bx * 8, my * mcuSize + by * 8, 1, block);
+                    forwardDct(basis, block, coefficients);
+                    encodeBlock(coefficients, quant[0], dcPrediction[0], dcLuma, acLuma, writer);
+                }
+            for (int c = 1; c < components; c++)
+            {
+                loadBlock(image, c, mx * 8, my * 8, subsample ? 2 : 1, block);
+                forwardDct(basis, block, coefficients);
+                encodeBlock(coefficients, quant[1], dcPrediction[c], dcChroma, acChroma, writer);
+            }
+        }
+    }
+    writer.Flush();
+    putMarker(out, 0xD9, 0);
+    return out;
+}
+
+bool WriteJpeg(const std::string &path, const unsigned char *pixels, int width, int height, int channels,
+               const JpegEncodeOptions &options)
+{
+    std::vector<unsigned char> data = EncodeJpeg(pixels, width, height, channels, options);
+    if (data.empty())
+    {
+        std::cout << "JPEG: couldn't encode " << path << std::endl;
+        return false;
+    }
+    std::ofstream out(path, std::ios::binary);
+    if (!out || !out.write((const char *)data.data(), (std::streamsize)data.size()))
+    {
+        std::cout << "JPEG: couldn't open " << path << " for writing" << std::endl;
+        return false;
+    }
+    return true;
+}
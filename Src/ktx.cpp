@@ -0,0 +1,399 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <ktx.h>
+#include <texture_compress.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+
+static const unsigned char KTX_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+static const unsigned int KTX_ENDIANNESS = 0x04030201;
+
+// the fixed part of the file following the identifier, all fields are 32 bit in the writer's byte order
+struct KtxHeader {
+    unsigned int endianness;
+    unsigned int glType;
+    unsigned int glTypeSize;
+    unsigned int glFormat;
+    unsigned int glInternalFormat;
+    unsigned int glBaseInternalFormat;
+    unsigned int pixelWidth;
+    unsigned int pixelHeight;
+    unsigned int pixelDepth;
+    unsigned int numberOfArrayElements;
+    unsigned int numberOfFaces;
+    unsigned int numberOfMipmapLevels;
+    unsigned int bytesOfKeyValueData;
+};
+
+static unsigned int swapBytes(unsigned int v)
+{
+    return (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+}
+
+std::string CookedTexturePath(const std::string &sourcePath)
+{
+    return sourcePath + ".ktx";
+}
+
+bool IsCookedTextureFresh(const std::string &cookedPath, const std::string &sourcePath)
+{
+    struct stat cooked, source;
+    if (stat(cookedPath.c_str(), &cooked) != 0)
+        return false;
+    // without the source around (shipped builds may only carry cooked files) the cooked file is all we have
+    if (stat(sourcePath.c_str(), &source) != 0)
+        return true;
+    return cooked.st_mtime >= source.st_mtime;
+}
+
+// bytes of one 4x4 block of a compressed format, 0 for formats this doesn't know
+static unsigned int blockBytes(GLenum internalFormat)
+{
+    switch (internalFormat)
+    {
+    case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_SRGB_S3TC_DXT1_EXT:
+    case GL_COMPRESSED_RED_RGTC1:
+        return 8;
+    case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT:
+    case GL_COMPRESSED_RG_RGTC2:
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+    case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+// bytes of one pixel of an uncompressed format, 0 for formats this doesn't know
+static unsigned int pixelBytes(GLenum format, GLenum type)
+{
+    unsigned int components = format == GL_RED ? 1 : format == GL_RG ? 2 : format == GL_RGB ? 3 : format == GL_RGBA ? 4 : 0;
+    unsigned int size = type == GL_UNSIGNED_BYTE ? 1 : type == GL_UNSIGNED_SHORT || type == GL_HALF_FLOAT ? 2 : type == GL_FLOAT ? 4 : 0;
+    return components * size;
+}
+
+// rejects a level whose imageSize isn't what its size and format take: 4x4 blocks when compressed, rows padded to
+// 4 bytes otherwise. Uploading it would fail with GL_INVALID_VALUE (or read past the level) and leave a blank mip
+static bool checkLevelSize(const KtxImage &image, int level, unsigned int imageSize, const std::string &filename)
+{
+    size_t width = (size_t)KtxLevelWidth(image, level), height = (size_t)KtxLevelHeight(image, level);
+    size_t expected = 0;
+    if (image.compressed())
+    {
+        unsigned int bytes = blockBytes(image.glInternalFormat);
+        // a format we can't size is left to the upload (UploadKtx rejects what the context can't sample)
+        if (bytes == 0)
+            return true;
+        expected = ((width + 3) / 4) * ((height + 3) / 4) * bytes;
+    }
+    else
+    {
+        unsigned int bytes = pixelBytes(image.glFormat, image.glType);
+        if (bytes == 0)
+            return true;
+        expected = ((width * bytes + 3) & ~(size_t)3) * height;
+    }
+    if (imageSize == expected)
+        return true;
+    std::cout << "KTX: level " << level << " is " << imageSize << " bytes, " << width << "x" << height << " takes "
+              << expected << ": " << filename << std::endl;
+    return false;
+}
+
+bool MatchKtxColorSpace(KtxImage &image, bool srgb)
+{
+    // linear and sRGB variants of every format that has both
+    static const GLenum VARIANTS[][2] = {
+        {GL_COMPRESSED_RGB_S3TC_DXT1_EXT, GL_COMPRESSED_SRGB_S3TC_DXT1_EXT},
+        {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT, GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT},
+        {GL_COMPRESSED_RGBA_BPTC_UNORM, GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM},
+        {GL_RGB8, GL_SRGB8},
+        {GL_RGBA8, GL_SRGB8_ALPHA8},
+    };
+    for (const GLenum *variant : VARIANTS)
+    {
+        if (image.glInternalFormat == variant[0] || image.glInternalFormat == variant[1])
+        {
+            image.glInternalFormat = variant[srgb ? 1 : 0];
+            return true;
+        }
+    }
+    // one and two channel images are decoded to linear R8/RG8 for gamma corrected textures as well (see
+    // BuildMipChain), so those match either way. The compressed ones would come out differently decoded
+    if (image.glInternalFormat == GL_R8 || image.glInternalFormat == GL_RG8)
+        return true;
+    return !srgb;
+}
+
+// checks the identifier and header (swapping the latter to our byte order) and fills in the image description,
+// shared by the file and memory readers
+static bool parseHeader(const unsigned char *identifier, KtxHeader &header, const std::string &filename, KtxImage &image,
+                        bool &swap, unsigned int &levels)
+{
+    if (std::memcmp(identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0)
+    {
+        std::cout << "KTX: not a KTX 1.1 file: " << filename << std::endl;
+        return false;
+    }
+
+    swap = header.endianness != KTX_ENDIANNESS;
+    if (swap)
+    {
+        unsigned int *fields = &header.endianness;
+        for (size_t i = 0; i < sizeof(header) / sizeof(unsigned int); i++)
+            fields[i] = swapBytes(fields[i]);
+    }
+    if (header.pixelDepth > 1 || header.numberOfArrayElements > 0 || header.numberOfFaces != 1)
+    {
+        std::cout << "KTX: only plain 2D textures are supported: " << filename << std::endl;
+        return false;
+    }
+
+    // a corrupt header must not size anything: the level count and the size are checked before they're used
+    if (header.pixelWidth == 0 || header.pixelHeight == 0 || header.pixelWidth > (unsigned int)INT_MAX ||
+        header.pixelHeight > (unsigned int)INT_MAX)
+    {
+        std::cout << "KTX: bad size " << header.pixelWidth << "x" << header.pixelHeight << ": " << filename << std::endl;
+        return false;
+    }
+    // a full chain of a width x height texture is floor(log2(max(width, height))) + 1 levels long
+    unsigned int maxLevels = 1;
+    for (unsigned int size = std::max(header.pixelWidth, header.pixelHeight); size > 1; size >>= 1)
+        maxLevels++;
+    if (header.numberOfMipmapLevels > maxLevels)
+    {
+        std::cout << "KTX: " << header.numberOfMipmapLevels << " levels, a " << header.pixelWidth << "x"
+                  << header.pixelHeight << " texture has at most " << maxLevels << ": " << filename << std::endl;
+        return false;
+    }
+
+    image.glInternalFormat = header.glInternalFormat;
+    image.glBaseInternalFormat = header.glBaseInternalFormat;
+    image.glFormat = header.glFormat;
+    image.glType = header.glType;
+    image.width = (int)header.pixelWidth;
+    image.height = (int)header.pixelHeight;
+    image.levels.clear();
+    levels = header.numberOfMipmapLevels > 0 ? header.numberOfMipmapLevels : 1;
+    return true;
+}
+
+// parses the header of an open file and leaves the stream at the first level's imageSize field
+static bool readHeader(std::ifstream &in, const std::string &filename, KtxImage &image, bool &swap, unsigned int &levels)
+{
+    unsigned char identifier[12];
+    KtxHeader header;
+    in.read((char *)identifier, sizeof(identifier));
+    in.read((char *)&header, sizeof(header));
+    if (!in)
+    {
+        std::cout << "KTX: not a KTX 1.1 file: " << filename << std::endl;
+        return false;
+    }
+    if (!parseHeader(identifier, header, filename, image, swap, levels))
+        return false;
+    in.seekg(header.bytesOfKeyValueData, std::ios::cur);
+    return true;
+}
+
+bool ReadKtxLayout(const std::string &filename, KtxImage &image, std::vector<KtxLevelRange> &ranges)
+{
+    std::ifstream in(filename, std::ios::binary);
+    bool swap;
+    unsigned int levels;
+    if (!in || !readHeader(in, filename, image, swap, levels))
+        return false;
+
+    ranges.assign(levels, KtxLevelRange());
+    for (unsigned int level = 0; level < levels; level++)
+    {
+        unsigned int imageSize = 0;
+        in.read((char *)&imageSize, sizeof(imageSize));
+        if (swap)
+            imageSize = swapBytes(imageSize);
+        if (in && !checkLevelSize(image, (int)level, imageSize, filename))
+            return false;
+        ranges[level].offset = (size_t)in.tellg();
+        ranges[level].size = imageSize;
+        // every level is padded to a multiple of 4 bytes
+        in.seekg(imageSize + (4 - imageSize % 4) % 4, std::ios::cur);
+        if (!in)
+        {
+            std::cout << "KTX: truncated file: " << filename << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ParseKtxLayout(const unsigned char *data, size_t size, const std::string &filename, KtxImage &image,
+                    std::vector<KtxLevelRange> &ranges)
+{
+    KtxHeader header;
+    size_t offset = sizeof(KTX_IDENTIFIER) + sizeof(header);
+    if (size < offset)
+    {
+        std::cout << "KTX: not a KTX 1.1 file: " << filename << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data + sizeof(KTX_IDENTIFIER), sizeof(header));
+    bool swap;
+    unsigned int levels;
+    if (!parseHeader(data, header, filename, image, swap, levels))
+        return false;
+
+    offset += header.bytesOfKeyValueData;
+    ranges.assign(levels, KtxLevelRange());
+    for (unsigned int level = 0; level < levels; level++)
+    {
+        unsigned int imageSize = 0;
+        if (offset + sizeof(imageSize) <= size)
+            std::memcpy(&imageSize, data + offset, sizeof(imageSize));
+        if (swap)
+            imageSize = swapBytes(imageSize);
+        ranges[level].offset = offset + sizeof(imageSize);
+        ranges[level].size = imageSize;
+        offset = ranges[level].offset + imageSize + (4 - imageSize % 4) % 4;
+        if (ranges[level].offset + imageSize > size)
+        {
+            std::cout << "KTX: truncated file: " << filename << std::endl;
+            return false;
+        }
+        if (!checkLevelSize(image, (int)level, imageSize, filename))
+            return false;
+    }
+    return true;
+}
+
+bool ReadKtxLevel(const std::string &filename, const KtxLevelRange &range, std::vector<unsigned char> &data)
+{
+    std::ifstream in(filename, std::ios::binary);
+    in.seekg((std::streamoff)range.offset);
+    data.resize(range.size);
+    in.read((char *)data.data(), range.size);
+    return (bool)in;
+}
+
+bool ReadKtx(const std::string &filename, KtxImage &image)
+{
+    std::ifstream in(filename, std::ios::binary);
+    bool swap;
+    unsigned int levels;
+    if (!in || !readHeader(in, filename, image, swap, levels))
+        return false;
+
+    image.levels.assign(levels, std::vector<unsigned char>());
+    for (unsigned int level = 0; level < levels; level++)
+    {
+        unsigned int imageSize = 0;
+        in.read((char *)&imageSize, sizeof(imageSize));
+        if (swap)
+            imageSize = swapBytes(imageSize);
+        if (in && !checkLevelSize(image, (int)level, imageSize, filename))
+            return false;
+        image.levels[level].resize(imageSize);
+        in.read((char *)image.levels[level].data(), imageSize);
+        in.seekg((4 - imageSize % 4) % 4, std::ios::cur);
+        if (!in)
+        {
+            std::cout << "KTX: truncated file: " << filename << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WriteKtx(const std::string &filename, const KtxImage &image)
+{
+    std::ofstream out(filename, std::ios::binary);
+    if (!out)
+    {
+        std::cout << "KTX: couldn't open " << filename << " for writing" << std::endl;
+        return false;
+    }
+
+    KtxHeader header;
+    header.endianness = KTX_ENDIANNESS;
+    header.glType = image.glType;
+    header.glTypeSize = 1;  // compressed data and GL_UNSIGNED_BYTE texels both count as single bytes
+    header.glFormat = image.glFormat;
+    header.glInternalFormat = image.glInternalFormat;
+    header.glBaseInternalFormat = image.glBaseInternalFormat;
+    header.pixelWidth = (unsigned int)image.width;
+    header.pixelHeight = (unsigned int)image.height;
+    header.pixelDepth = 0;
+    header.numberOfArrayElements = 0;
+    header.numberOfFaces = 1;
+    header.numberOfMipmapLevels = (unsigned int)image.levels.size();
+    header.bytesOfKeyValueData = 0;
+
+    out.write((const char *)KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER));
+    out.write((const char *)&header, sizeof(header));
+    static const char padding[4] = {0, 0, 0, 0};
+    for (const auto &level : image.levels)
+    {
+        unsigned int imageSize = (unsigned int)level.size();
+        out.write((const char *)&imageSize, sizeof(imageSize));
+        out.write((const char *)level.data(), imageSize);
+        out.write(padding, (4 - imageSize % 4) % 4);
+    }
+    return (bool)out;
+}
+
+void UploadKtxLevel(const KtxImage &image, int level, const unsigned char *data, unsigned int size)
+{
+    int width = KtxLevelWidth(image, level), height = KtxLevelHeight(image, level);
+    if (image.compressed())
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, image.glInternalFormat, width, height, 0, (GLsizei)size, data);
+    else
+        glTexImage2D(GL_TEXTURE_2D, level, (GLint)image.glInternalFormat, width, height, 0, image.glFormat, image.glType, data);
+}
+
+// the file carries its own mip chain, so tell GL not to expect levels past it (nor before the first one uploaded)
+static void setMipmappedSampling(size_t levels, int firstLevel)
+{
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, firstLevel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+bool UploadKtx(const KtxImage &image, unsigned int textureID, int firstLevel)
+{
+    if (image.compressed() && !IsCompressedFormatSupported(image.glInternalFormat))
+        return false;
+
+    firstLevel = std::max(0, std::min(firstLevel, (int)image.levels.size() - 1));
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for (size_t level = (size_t)firstLevel; level < image.levels.size(); level++)
+        UploadKtxLevel(image, (int)level, image.levels[level].data(), (unsigned int)image.levels[level].size());
+    setMipmappedSampling(image.levels.size(), firstLevel);
+    return true;
+}
+
+bool UploadKtx(const KtxImage &layout, const unsigned char *data, const std::vector<KtxLevelRange> &ranges, unsigned int textureID,
+               int firstLevel)
+{
+    if (layout.compressed() && !IsCompressedFormatSupported(layout.glInternalFormat))
+        return false;
+
+    firstLevel = std::max(0, std::min(firstLevel, (int)ranges.size() - 1));
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for (size_t level = (size_t)firstLevel; level < ranges.size(); level++)
+        UploadKtxLevel(layout, (int)level, data + ranges[level].offset, ranges[level].size);
+    setMipmappedSampling(ranges.size(), firstLevel);
+    return true;
+}
@@ -0,0 +1,102 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <mapped_file.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(handle, &length) || length.QuadPart == 0)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+    HANDLE view = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!view)
+    {
+        CloseHandle(handle);
+        return false;
+    }
+    data = (const unsigned char *)MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(view);
+        CloseHandle(handle);
+        return false;
+    }
+    file = handle;
+    mapping = view;
+    size = (size_t)length.QuadPart;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data)
+        UnmapViewOfFile(data);
+    if (mapping)
+        CloseHandle((HANDLE)mapping);
+    if (file)
+        CloseHandle((HANDLE)file);
+    data = nullptr;
+    mapping = nullptr;
+    file = nullptr;
+    size = 0;
+}
+
+#else
+
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        return false;
+    }
+    // the mapping keeps its own reference to the file, the descriptor isn't needed past this point
+    void *view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED)
+        return false;
+    data = (const unsigned char *)view;
+    size = (size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data)
+        munmap((void *)data, size);
+    data = nullptr;
+    size = 0;
+}
+
+#endif
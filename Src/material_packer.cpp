@@ -0,0 +1,193 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <material_packer.h>
+#include <gpu_residency.h>
+#include <render_stats.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <tuple>
+
+// what a texture has to share with the others to become a layer of the same array
+struct ArrayFormat {
+    int width;
+    int height;
+    int levels;
+    GLint internalFormat;
+    bool compressed;
+
+    bool operator<(const ArrayFormat &other) const
+    {
+        return std::tie(width, height, levels, internalFormat) < std::tie(other.width, other.height, other.levels, other.internalFormat);
+    }
+};
+
+// reads size, format and resident mip range of a 2D texture (streamed textures may not start at level 0)
+static ArrayFormat queryFormat(unsigned int textureID, int &baseLevel)
+{
+    ArrayFormat format;
+    GLint maxLevel = 1000;
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, &baseLevel);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, &maxLevel);
+
+    GLint compressed = 0;
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, baseLevel, GL_TEXTURE_WIDTH, &format.width);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, baseLevel, GL_TEXTURE_HEIGHT, &format.height);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, baseLevel, GL_TEXTURE_INTERNAL_FORMAT, &format.internalFormat);
+    glGetTexLevelParameteriv(GL_TEXTURE_2D, baseLevel, GL_TEXTURE_COMPRESSED, &compressed);
+    format.compressed = compressed != 0;
+
+    format.levels = 0;
+    GLint width = format.width;
+    while (baseLevel + format.levels <= maxLevel && width > 0)
+    {
+        format.levels++;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, baseLevel + format.levels, GL_TEXTURE_WIDTH, &width);
+    }
+    return format;
+}
+
+void MaterialPacker::Add(unsigned int textureID)
+{
+    if (layers.count(textureID) == 0 && std::find(pending.begin(), pending.end(), textureID) == pending.end())
+        pending.push_back(textureID);
+}
+
+void MaterialPacker::Pack()
+{
+    GLint maxLayers = 256;
+    glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxLayers);
+
+    // group the textures by format
+    std::map<ArrayFormat, std::vector<std::pair<unsigned int, int>>> groups;
+    for (unsigned int textureID : pending)
+    {
+        // the originals are read back below, so evicted ones have to come back first
+        GpuResidency::Instance().Touch(GPU_TEXTURE, textureID);
+        int baseLevel = 0;
+        ArrayFormat format = queryFormat(textureID, baseLevel);
+        if (format.width == 0 || format.levels == 0)
+        {
+            std::cout << "MaterialPacker: texture " << textureID << " has no image, not packing it" << std::endl;
+            continue;
+        }
+        groups[format].push_back(std::make_pair(textureID, baseLevel));
+    }
+    pending.clear();
+
+    std::vector<unsigned char> pixels;
+    for (const auto &group : groups)
+    {
+        const ArrayFormat &format = group.first;
+        // groups larger than the layer limit are split into several arrays
+        for (size_t first = 0; first < group.second.size(); first += (size_t)maxLayers)
+        {
+            GLsizei count = (GLsizei)std::min(group.second.size() - first, (size_t)maxLayers);
+            unsigned int array;
+            glGenTextures(1, &array);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, array);
+
+            // allocate every level of the array up front ...
+            std::vector<GLint> levelBytes(format.levels, 0);
+            size_t arrayBytes = 0;
+            glBindTexture(GL_TEXTURE_2D, group.second[first].first);
+            for (int level = 0; level < format.levels; level++)
+            {
+                int width = std::max(1, format.width >> level), height = std::max(1, format.height >> level);
+                if (format.compressed)
+                {
+                    glGetTexLevelParameteriv(GL_TEXTURE_2D, group.second[first].second + level, GL_TEXTURE_COMPRESSED_IMAGE_SIZE, &levelBytes[level]);
+                    glCompressedTexImage3D(GL_TEXTURE_2D_ARRAY, level, format.internalFormat, width, height, count, 0, levelBytes[level] * count, NULL);
+                    arrayBytes += (size_t)levelBytes[level] * count;
+                }
+                else
+                {
+                    glTexImage3D(GL_TEXTURE_2D_ARRAY, level, format.internalFormat, width, height, count, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+                    arrayBytes += (size_t)width * height * 4 * count;
+                }
+            }
+
+            // ... then copy each texture into its layer. GL 3.3 has no image copies, so this goes through the CPU once.
+            glPixelStorei(GL_PACK_ALIGNMENT, 4);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            for (GLsizei layer = 0; layer < count; layer++)
+            {
+                unsigned int textureID = group.second[first + layer].first;
+                int baseLevel = group.second[first + layer].second;
+                glBindTexture(GL_TEXTURE_2D, textureID);
+                for (int level = 0; level < format.levels; level++)
+                {
+                    int width = std::max(1, format.width >> level), height = std::max(1, format.height >> level);
+                    if (format.compressed)
+                    {
+                        pixels.resize(levelBytes[level]);
+                        glGetCompressedTexImage(GL_TEXTURE_2D, baseLevel + level, pixels.data());
+                        glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, format.internalFormat, levelBytes[level], pixels.data());
+                    }
+                    else
+                    {
+                        pixels.resize((size_t)width * height * 4);
+                        glGetTexImage(GL_TEXTURE_2D, baseLevel + level, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+                        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, level, 0, 0, layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+                    }
+                }
+                PackedLayer packed;
+                packed.array = (unsigned int)arrays.size();
+                packed.layer = layer;
+                layers[textureID] = packed;
+            }
+
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, format.levels - 1);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            arrays.push_back(array);
+            // every packed mesh draws from every array, so they're pinned
+            GpuResidency::Instance().Track(GPU_TEXTURE, array, arrayBytes);
+        }
+    }
+
+    GLint maxUnits = 16;
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+    if ((GLint)arrays.size() > maxUnits)
+        std::cout << "MaterialPacker: " << arrays.size() << " arrays but only " << maxUnits << " texture units" << std::endl;
+}
+
+PackedLayer MaterialPacker::Find(unsigned int textureID) const
+{
+    auto it = layers.find(textureID);
+    if (it == layers.end())
+    {
+        PackedLayer none;
+        none.array = 0;
+        none.layer = -1;
+        return none;
+    }
+    return it->second;
+}
+
+void MaterialPacker::Bind() const
+{
+    for (size_t i = 0; i < arrays.size(); i++)
+    {
+        glActiveTexture(GL_TEXTURE0 + (GLenum)i);
+        CountedBindTexture(GL_TEXTURE_2D_ARRAY, arrays[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void MaterialPacker::del()
+{
+    for (unsigned int array : arrays)
+        GpuResidency::Instance().Untrack(GPU_TEXTURE, array);
+    if (!arrays.empty())
+        glDeleteTextures((GLsizei)arrays.size(), arrays.data());
+    arrays.clear();
+    layers.clear();
+    pending.clear();
+}
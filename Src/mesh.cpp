@@ -3,6 +3,9 @@
 //
 
 #include <mesh.h>
+#include <gpu_residency.h>
+#include <profiler.h>
+#include <render_stats.h>
 
 #define MAX_BONE_INFLUENCE 4
 
@@ -10,27 +13,36 @@
 // constructor
 Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures)
 {
-    this->vertices = vertices;
-    this->indices = indices;
-    this->textures = textures;
+    this->vertices = std::move(vertices);
+    this->indices = std::move(indices);
+    this->textures = std::move(textures);
 
+    boundsMin = boundsMax = this->vertices.empty() ? glm::vec3(0.0f) : this->vertices[0].Position;
+    for (unsigned int i = 1; i < this->vertices.size(); i++)
+    {
+        boundsMin = glm::min(boundsMin, this->vertices[i].Position);
+        boundsMax = glm::max(boundsMax, this->vertices[i].Position);
+    }
+
+    setupSamplerNames();
     // now that we have all the required data, set the vertex buffers and its attribute pointers.
     setupMesh();
 }
 
-// render the mesh
-void Mesh::Draw(Shader &shader) {
-    // bind appropriate textures
+// names the samplers the way the shaders declare them: texture_diffuseN, texture_specularN ... counting from 1 per type
+void Mesh::setupSamplerNames()
+{
     unsigned int diffuseNr  = 1;
     unsigned int specularNr = 1;
     unsigned int normalNr   = 1;
     unsigned int heightNr   = 1;
+    samplerNames.clear();
+    layerNames.clear();
     for(unsigned int i = 0; i < textures.size(); i++)
     {
-        glActiveTexture(GL_TEXTURE0 + i); // active proper texture unit before binding
         // retrieve texture number (the N in diffuse_textureN)
         std::string number;
-        std::string name = textures[i].type;
+        const std::string &name = textures[i].type;
         if(name == "texture_diffuse")
             number = std::to_string(diffuseNr++);
         else if(name == "texture_specular")
@@ -39,25 +51,73 @@ void Mesh::Draw(Shader &shader) {
             number = std::to_string(normalNr++); // transfer unsigned int to string
         else if(name == "texture_height")
             number = std::to_string(heightNr++); // transfer unsigned int to string
+        samplerNames.push_back(name + number);
+        layerNames.push_back(name + number + "_layer");
+    }
+}
+
+// render the mesh
+void Mesh::Draw(Shader &shader) {
+    PROFILE_ZONE("Mesh::Draw");
+    // bind appropriate textures
+    for(unsigned int i = 0; i < textures.size(); i++)
+    {
+        glActiveTexture(GL_TEXTURE0 + i); // active proper texture unit before binding
+        // brings the texture back if it was evicted (which binds it to this unit), and keeps it warm otherwise
+        GpuResidency::Instance().Touch(GPU_TEXTURE, textures[i].id);
 
         // now set the sampler to the correct texture unit
-        glUniform1i(glGetUniformLocation(shader.ID, (name + number).c_str()), i);
+        CountedUniform1i(glGetUniformLocation(shader.ID, samplerNames[i].c_str()), i);
         // and finally bind the texture
-        glBindTexture(GL_TEXTURE_2D, textures[i].id);
+        CountedBindTexture(GL_TEXTURE_2D, textures[i].id);
     }
 
     // draw mesh
+    if (!GpuResidency::Instance().Touch(GPU_BUFFER, VBO))
+        uploadBuffers();
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+    CountedDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
 
     // always good practice to set everything back to defaults once configured.
     glActiveTexture(GL_TEXTURE0);
 }
 
+// render the mesh with its textures read from texture arrays that are already bound (MaterialPacker::Bind),
+// so only sampler and layer uniforms change between meshes
+void Mesh::DrawPacked(Shader &shader) {
+    PROFILE_ZONE("Mesh::DrawPacked");
+    for(unsigned int i = 0; i < textures.size() && i < layers.size(); i++)
+    {
+        // the samplers are named like Draw's, declared as sampler2DArray: point each at the unit holding its array,
+        // and pick the layer
+        CountedUniform1i(glGetUniformLocation(shader.ID, samplerNames[i].c_str()), (int)layers[i].array);
+        CountedUniform1i(glGetUniformLocation(shader.ID, layerNames[i].c_str()), layers[i].layer);
+    }
+
+    if (!GpuResidency::Instance().Touch(GPU_BUFFER, VBO))
+        uploadBuffers();
+    glBindVertexArray(VAO);
+    CountedDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+// deletes the GL objects; copies of the mesh share them, so only one of them may call this
+void Mesh::del()
+{
+    GpuResidency::Instance().Untrack(GPU_BUFFER, VBO);
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+}
+
 // initializes all the buffer objects/arrays
 void Mesh::setupMesh()
 {
+    // both buffers are accounted (and evicted) together under the VBO's name
+    size_t bytes = vertices.size() * sizeof(Vertex) + indices.size() * sizeof(unsigned int);
+    GpuResidency::Instance().Reserve(bytes);
+
     // create buffers/arrays
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -69,10 +129,10 @@ void Mesh::setupMesh()
     // A great thing about structs is that their memory layout is sequential for all its items.
     // The effect is that we can simply pass a pointer to the struct and it translates perfectly to a glm::vec3/2 array which
     // again translates to 3/2 floats which translates to a byte array.
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+    CountedBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    CountedBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
 
     // set the vertex attribute pointers
     // vertex Positions
@@ -98,4 +158,22 @@ void Mesh::setupMesh()
     glEnableVertexAttribArray(6);
     glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, m_Weights));
     glBindVertexArray(0);
+
+    // the vertices stay in memory, so there is no reload function: Draw re-uploads them when Touch says so
+    unsigned int vbo = VBO, ebo = EBO;
+    GpuResidency::Instance().Track(GPU_BUFFER, VBO, bytes, [vbo, ebo]() {
+        EvictBuffer(vbo);
+        EvictBuffer(ebo);
+    });
+}
+
+// refills the buffers from vertices and indices after GpuResidency evicted them
+void Mesh::uploadBuffers()
+{
+    // through the copy target, so the element buffer is refilled without binding a VAO
+    glBindBuffer(GL_COPY_WRITE_BUFFER, VBO);
+    CountedBufferData(GL_COPY_WRITE_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, EBO);
+    CountedBufferData(GL_COPY_WRITE_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
 }
@@ -0,0 +1,345 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <mipmap.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIPMAP_SSE2
+#include <emmintrin.h>
+#endif
+
+// AVX kernels are compiled in with a target attribute (gcc/clang) or unconditionally (msvc) and only picked at run
+// time, so the rest of the project doesn't have to be built with -mavx
+#if defined(MIPMAP_SSE2) && (defined(__GNUC__) || defined(_MSC_VER))
+#define MIPMAP_AVX
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MIPMAP_AVX_TARGET
+#else
+#define MIPMAP_AVX_TARGET __attribute__((target("avx")))
+#endif
+#endif
+
+// images smaller than this many texels aren't worth waking up worker threads for
+static const int MIPMAP_PARALLEL_TEXELS = 256 * 256;
+
+// float texels, `channels` floats per pixel
+struct FloatImage {
+    int width = 0;
+    int height = 0;
+    int channels = 4;
+    std::vector<float> texels;
+};
+
+// a downsampling filter: output texel x reads source texels 2x + first .. 2x + first + weights.size() - 1
+struct MipKernel {
+    int first;
+    std::vector<float> weights;
+};
+
+static bool cpuHasAvx()
+{
+#if defined(MIPMAP_AVX) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0, avx = (info[2] & (1 << 28)) != 0;
+    return osxsave && avx && (_xgetbv(0) & 6) == 6;
+#elif defined(MIPMAP_AVX)
+    return __builtin_cpu_supports("avx");
+#else
+    return false;
+#endif
+}
+
+// linear -> sRGB is sampled finely enough that the darkest sRGB steps still round correctly
+static const int LINEAR_TO_SRGB_SIZE = 16384;
+
+// conversion tables, built once on first use (function local statics are initialized thread safely)
+struct SrgbTables {
+    float toLinear[256];
+    unsigned char toSrgb[LINEAR_TO_SRGB_SIZE];
+
+    SrgbTables()
+    {
+        for (int i = 0; i < 256; i++)
+        {
+            float c = (float)i / 255.0f;
+            toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < LINEAR_TO_SRGB_SIZE; i++)
+        {
+            float c = (float)i / (float)(LINEAR_TO_SRGB_SIZE - 1);
+            float s = c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+            toSrgb[i] = (unsigned char)std::min(std::max(s * 255.0f + 0.5f, 0.0f), 255.0f);
+        }
+    }
+};
+
+static const SrgbTables &srgbTables()
+{
+    static const SrgbTables tables;
+    return tables;
+}
+
+static MipKernel makeKernel(MipFilter filter)
+{
+    MipKernel kernel;
+    if (filter == MIP_FILTER_BOX)
+    {
+        kernel.first = 0;
+        kernel.weights.assign(2, 0.5f);
+        return kernel;
+    }
+
+    // Kaiser windowed sinc with a radius of 3 destination texels (6 source texels), alpha = 4
+    const float alpha = 4.0f, radius = 6.0f;
+    auto bessel0 = [](float x) {
+        float sum = 1.0f, term = 1.0f;
+        for (int k = 1; k < 20; k++)
+        {
+            term *= (x / (2.0f * k)) * (x / (2.0f * k));
+            sum += term;
+        }
+        return sum;
+    };
+    kernel.first = -5;
+    float total = 0.0f;
+    for (int k = 0; k < 12; k++)
+    {
+        // distance from the destination texel's centre, in source texels
+        float d = (float)(k + kernel.first) - 0.5f;
+        float x = d * 0.5f * 3.14159265f;
+        float sinc = std::fabs(x) < 1e-6f ? 1.0f : std::sin(x) / x;
+        float t = d / radius;
+        float window = bessel0(alpha * std::sqrt(std::max(0.0f, 1.0f - t * t))) / bessel0(alpha);
+        kernel.weights.push_back(sinc * window);
+        total += sinc * window;
+    }
+    for (float &w : kernel.weights)
+        w /= total;
+    return kernel;
+}
+
+// runs fn(first, last) over [0, count) on up to `threads` threads
+template<typename Fn>
+static void parallelRows(int count, int threads, int texels, Fn fn)
+{
+    if (threads <= 0)
+        threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    if (texels < MIPMAP_PARALLEL_TEXELS)
+        threads = 1;
+    threads = std::min(threads, count);
+    if (threads <= 1)
+    {
+        fn(0, count);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    int rowsPerThread = (count + threads - 1) / threads;
+    for (int t = 1; t < threads; t++)
+        workers.emplace_back(fn, std::min(t * rowsPerThread, count), std::min((t + 1) * rowsPerThread, count));
+    fn(0, std::min(rowsPerThread, count));
+    for (auto &worker : workers)
+        worker.join();
+}
+
+// dst[i] += weight * src[i]
+static void accumulateRowSse(float *dst, const float *src, float weight, int count)
+{
+    int i = 0;
+#ifdef MIPMAP_SSE2
+    __m128 w = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4)
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_mul_ps(_mm_loadu_ps(src + i), w)));
+#endif
+    for (; i < count; i++)
+        dst[i] += weight * src[i];
+}
+
+#ifdef MIPMAP_AVX
+MIPMAP_AVX_TARGET static void accumulateRowAvx(float *dst, const float *src, float weight, int count)
+{
+    int i = 0;
+    __m256 w = _mm256_set1_ps(weight);
+    for (; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_add_ps(_mm256_loadu_ps(dst + i), _mm256_mul_ps(_mm256_loadu_ps(src + i), w)));
+    for (; i < count; i++)
+        dst[i] += weight * src[i];
+}
+#endif
+
+typedef void (*AccumulateRowFn)(float *dst, const float *src, float weight, int count);
+
+static AccumulateRowFn accumulateRow()
+{
+#ifdef MIPMAP_AVX
+    static const AccumulateRowFn fn = cpuHasAvx() ? accumulateRowAvx : accumulateRowSse;
+    return fn;
+#else
+    return accumulateRowSse;
+#endif
+}
+
+// filters one row horizontally: every output texel is a weighted sum of source texels
+static void filterRow(const float *src, int width, int channels, float *dst, int outWidth, const MipKernel &kernel)
+{
+    int taps = (int)kernel.weights.size();
+    for (int x = 0; x < outWidth; x++)
+    {
+        int base = 2 * x + kernel.first;
+#ifdef MIPMAP_SSE2
+        if (channels == 4)
+        {
+            // a whole RGBA texel per register
+            __m128 acc = _mm_setzero_ps();
+            for (int k = 0; k < taps; k++)
+            {
+                int sx = std::min(std::max(base + k, 0), width - 1);
+                acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(src + sx * 4), _mm_set1_ps(kernel.weights[k])));
+            }
+            _mm_storeu_ps(dst + x * 4, acc);
+            continue;
+        }
+#endif
+        float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (int k = 0; k < taps; k++)
+        {
+            int sx = std::min(std::max(base + k, 0), width - 1);
+            for (int c = 0; c < channels; c++)
+                acc[c] += src[sx * channels + c] * kernel.weights[k];
+        }
+        std::memcpy(dst + x * channels, acc, channels * sizeof(float));
+    }
+}
+
+// halves the image (dimensions of 1 stay 1) with a separable filter: rows first, then columns
+static void downsample(const FloatImage &src, FloatImage &dst, const MipKernel &kernel, int threads)
+{
+    dst.width = std::max(1, src.width / 2);
+    dst.height = std::max(1, src.height / 2);
+    dst.channels = src.channels;
+    int channels = src.channels;
+
+    // horizontal pass into a half width, full height image
+    std::vector<float> rows;
+    const std::vector<float> *horizontal = &src.texels;
+    if (src.width > 1)
+    {
+        rows.resize((size_t)dst.width * src.height * channels);
+        parallelRows(src.height, threads, src.width * src.height, [&](int first, int last) {
+            for (int y = first; y < last; y++)
+                filterRow(&src.texels[(size_t)y * src.width * channels], src.width, channels,
+                          &rows[(size_t)y * dst.width * channels], dst.width, kernel);
+        });
+        horizontal = &rows;
+    }
+
+    // vertical pass, one whole output row at a time so the inner loop runs over contiguous floats
+    dst.texels.assign((size_t)dst.width * dst.height * channels, 0.0f);
+    if (src.height == 1)
+    {
+        dst.texels = *horizontal;
+        return;
+    }
+    AccumulateRowFn accumulate = accumulateRow();
+    int rowFloats = dst.width * channels;
+    parallelRows(dst.height, threads, dst.width * src.height, [&](int first, int last) {
+        for (int y = first; y < last; y++)
+        {
+            float *out = &dst.texels[(size_t)y * rowFloats];
+            for (size_t k = 0; k < kernel.weights.size(); k++)
+            {
+                int sy = std::min(std::max(2 * y + kernel.first + (int)k, 0), src.height - 1);
+                accumulate(out, &(*horizontal)[(size_t)sy * rowFloats], kernel.weights[k], rowFloats);
+            }
+        }
+    });
+}
+
+static void toFloat(const unsigned char *pixels, int width, int height, int channels, size_t stride, bool srgb, FloatImage &image)
+{
+    const float *toLinear = srgbTables().toLinear;
+    image.width = width;
+    image.height = height;
+    image.channels = channels;
+    image.texels.resize((size_t)width * height * channels);
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *row = pixels + y * stride;
+        float *out = &image.texels[(size_t)y * width * channels];
+        for (int i = 0; i < width * channels; i++)
+            out[i] = srgb && i % channels < 3 ? toLinear[row[i]] : (float)row[i] / 255.0f;
+    }
+}
+
+static void toBytes(const FloatImage &image, bool srgb, unsigned char *pixels, size_t stride)
+{
+    const unsigned char *toSrgb = srgbTables().toSrgb;
+    int channels = image.channels;
+    for (int y = 0; y < image.height; y++)
+    {
+        unsigned char *row = pixels + y * stride;
+        const float *in = &image.texels[(size_t)y * image.width * channels];
+        for (int i = 0; i < image.width * channels; i++)
+        {
+            // the sinc's negative lobes can overshoot, so clamp before quantizing
+            float v = std::min(std::max(in[i], 0.0f), 1.0f);
+            row[i] = srgb && i % channels < 3 ? toSrgb[(int)(v * (LINEAR_TO_SRGB_SIZE - 1) + 0.5f)] : (unsigned char)(v * 255.0f + 0.5f);
+        }
+    }
+}
+
+// the chain with rows of every level padded to `alignment` bytes; the source rows are tightly packed
+static std::vector<std::vector<unsigned char>> buildChain(const unsigned char *pixels, int width, int height, int channels,
+                                                          bool srgb, MipFilter filter, int alignment, int threads)
+{
+    srgb = srgb && channels >= 3;
+    MipKernel kernel = makeKernel(filter);
+    auto strideOf = [&](int w) { return ((size_t)w * channels + alignment - 1) / alignment * alignment; };
+
+    std::vector<std::vector<unsigned char>> levels;
+    levels.emplace_back(strideOf(width) * height);
+    for (int y = 0; y < height; y++)
+        std::memcpy(&levels[0][y * strideOf(width)], pixels + (size_t)y * width * channels, (size_t)width * channels);
+
+    FloatImage current, next;
+    toFloat(pixels, width, height, channels, (size_t)width * channels, srgb, current);
+    while (current.width > 1 || current.height > 1)
+    {
+        downsample(current, next, kernel, threads);
+        levels.emplace_back(strideOf(next.width) * next.height);
+        toBytes(next, srgb, levels.back().data(), strideOf(next.width));
+        std::swap(current, next);
+    }
+    return levels;
+}
+
+void BuildMipChain(const unsigned char *pixels, int width, int height, int channels, bool srgb, MipFilter filter,
+                   KtxImage &image, int threads)
+{
+    static const GLenum formats[4] = {GL_RED, GL_RG, GL_RGB, GL_RGBA};
+    static const GLenum linearFormats[4] = {GL_R8, GL_RG8, GL_RGB8, GL_RGBA8};
+    srgb = srgb && channels >= 3;
+
+    image.glFormat = formats[channels - 1];
+    image.glBaseInternalFormat = image.glFormat;
+    image.glType = GL_UNSIGNED_BYTE;
+    image.glInternalFormat = srgb ? (channels == 3 ? GL_SRGB8 : GL_SRGB8_ALPHA8) : linearFormats[channels - 1];
+    image.width = width;
+    image.height = height;
+    image.levels = buildChain(pixels, width, height, channels, srgb, filter, 4, threads);
+}
+
+std::vector<std::vector<unsigned char>> BuildMipChainRgba(const unsigned char *rgba, int width, int height, bool srgb,
+                                                          MipFilter filter, int threads)
+{
+    return buildChain(rgba, width, height, 4, srgb, filter, 1, threads);
+}
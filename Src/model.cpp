@@ -3,63 +3,238 @@
 //
 
 #include <model.h>
+#include <texture_cache.h>
+#include <decoded_texture_cache.h>
+#include <mapped_file.h>
+#include <ktx.h>
+#include <texture_streamer.h>
+#include <mipmap.h>
+#include <gpu_residency.h>
+#include <texture_quality.h>
+#include <gpu_profiler.h>
+#include <pipeline_statistics.h>
+#include <perf_counters.h>
+#include <alloc_tracker.h>
 
 
-unsigned int TextureFromFile(const char *path, const std::string &directory, bool gamma) {
-    std::string filename = std::string(path);
-    filename = directory + '/' + filename;
+// maps a KTX file and uploads its levels from the one the quality asks for on, the skipped ones are never even read.
+// A file whose format can't be sampled in the gamma asked for isn't uploaded
+static bool uploadMappedKtx(unsigned int textureID, const std::string &ktxPath, const TextureQuality &quality, bool gamma) {
+    MappedFile file;
+    KtxImage layout;
+    std::vector<KtxLevelRange> ranges;
+    if (!file.Open(ktxPath) || !ParseKtxLayout(file.Data(), file.Size(), ktxPath, layout, ranges))
+        return false;
+    if (!MatchKtxColorSpace(layout, gamma))
+        return false;
+    return UploadKtx(layout, file.Data(), ranges, textureID, quality.FirstLevel(layout.width, layout.height, (int)ranges.size()));
+}
 
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
+// loads directory/path into textureID, which is how GpuResidency brings an evicted texture back as well (without streaming:
+// streamed textures are never evicted)
+static bool loadTexture(unsigned int textureID, const std::string &path, const std::string &directory, bool gamma, int channels,
+                        const TextureQuality &quality, bool stream) {
+    PROFILE_ZONE("loadTexture");
+    ALLOC_SCOPE(ALLOC_TEXTURES);
+    std::string filename = directory + '/' + path;
+
+    // a cooked version (block compressed with a precomputed mip chain, see blob_sea_cook) is uploaded as is,
+    // or streamed in level by level when a texture budget is set. It's sampled as sRGB or linear to match gamma
+    // whatever it was cooked as, and skipped when its format has no sRGB variant
+    std::string cookedPath = CookedTexturePath(filename);
+    if (IsCookedTextureFresh(cookedPath, filename))
+    {
+        if (stream && TextureStreamer::Instance().Enabled() && TextureStreamer::Instance().Register(textureID, cookedPath, quality, gamma))
+            return true;
+        if (uploadMappedKtx(textureID, cookedPath, quality, gamma))
+            return true;
+    }
+
+    // next best is the decoded mip chain cached by an earlier load: the entry is found by hashing the source bytes,
+    // mapped, and uploaded straight from the mapping
+    MappedFile source;
+    if (!source.Open(filename))
+    {
+        std::cout << "Texture failed to load at path: " << path << std::endl;
+        return false;
+    }
+    std::string entryPath = DecodedTextureCache::Instance().EntryPath(source.Data(), source.Size(), gamma, channels);
+    if (!entryPath.empty())
+    {
+        if (stream && TextureStreamer::Instance().Enabled() && TextureStreamer::Instance().Register(textureID, entryPath, quality, gamma))
+            return true;
+        if (uploadMappedKtx(textureID, entryPath, quality, gamma))
+            return true;
+    }
 
+    // decoding from the mapped source (rather than stbi_load) also lets JPEGs with restart markers decode in parallel
     int width, height, nrComponents;
-    unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
+    unsigned char *data;
+    {
+        PROFILE_ZONE("decode texture");
+        data = stbi_load_from_memory(source.Data(), (int)source.Size(), &width, &height, &nrComponents, channels);
+    }
     if (data)
     {
-        GLenum format;
-        if (nrComponents == 1)
-            format = GL_RED;
-        else if (nrComponents == 3)
-            format = GL_RGB;
-        else if (nrComponents == 4)
-            format = GL_RGBA;
-
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        // stbi_load reports the file's component count, but returns the forced one
+        if (channels != 0)
+            nrComponents = channels;
+
+        // the mips are filtered on the CPU (in linear space for gamma corrected textures) instead of by glGenerateMipmap,
+        // and cached so the next load skips decoding and filtering altogether. The whole chain is cached whatever the
+        // quality, a lower one only uploads the smaller levels.
+        KtxImage mips;
+        {
+            PROFILE_ZONE("build mip chain");
+            BuildMipChain(data, width, height, nrComponents, gamma, MIP_FILTER_KAISER, mips);
+        }
+        UploadKtx(mips, textureID, quality.FirstLevel(width, height, (int)mips.levels.size()));
+        if (!entryPath.empty())
+            DecodedTextureCache::Instance().Store(entryPath, mips);
 
         stbi_image_free(data);
+        return true;
     }
-    else
+
+    std::cout << "Texture failed to load at path: " << path << std::endl;
+    stbi_image_free(data);
+    return false;
+}
+
+unsigned int TextureFromFile(const char *path, const std::string &directory, bool gamma, int channels, const std::string &type) {
+    unsigned int textureID;
+    glGenTextures(1, &textureID);
+    std::string file = std::string(path);
+    TextureQuality quality = TextureQualitySettings::Instance().For(directory + '/' + file, type);
+    if (!loadTexture(textureID, file, directory, gamma, channels, quality, true))
+        return textureID;
+
+    // streamed textures are accounted by the TextureStreamer, everything else can be evicted when it goes cold and
+    // reloaded (usually straight from the decoded cache) the next time it's drawn
+    if (TextureStreamer::Instance().ResidentLevel(textureID) < 0)
     {
-        std::cout << "Texture failed to load at path: " << path << std::endl;
-        stbi_image_free(data);
+        GpuResidency::Instance().Track(GPU_TEXTURE, textureID, TextureBytes(textureID),
+                                       [textureID]() { EvictTexture(textureID); },
+                                       [textureID, file, directory, gamma, channels, quality]() {
+                                           return loadTexture(textureID, file, directory, gamma, channels, quality, false);
+                                       });
     }
-
     return textureID;
 }
 
 
 Model::Model(std::string const &path, bool gamma) : gammaCorrection(gamma) {
     loadModel(path);
+    for(unsigned int i = 0; i < meshes.size(); i++)
+        meshBounds.Add(meshes[i].boundsMin, meshes[i].boundsMax);
 }
 
 // draws the model, and thus all its meshes
 void Model::Draw(Shader &shader) {
+    PROFILE_GPU_ZONE("model");
+    PipelineStatisticsPass statisticsPass("model");
     for(unsigned int i = 0; i < meshes.size(); i++)
         meshes[i].Draw(shader);
 }
 
+// fills visibleMeshes with the meshes inside the frustum
+void Model::cullMeshes(const Frustum &frustum, const glm::mat4 &model) {
+    // moving the planes into object space once is cheaper than transforming every mesh's box into world space
+    CullBoxes(TransformFrustum(frustum, model), meshBounds, visibleMeshes);
+}
+
+// draws only the meshes whose bounds intersect the frustum (world space, e.g. Camera::GetFrustum) when placed with model
+void Model::Draw(Shader &shader, const Frustum &frustum, const glm::mat4 &model) {
+    cullMeshes(frustum, model);
+    PROFILE_GPU_ZONE("model");
+    PipelineStatisticsPass statisticsPass("model");
+    for(unsigned int i = 0; i < visibleMeshes.size(); i++)
+        meshes[visibleMeshes[i]].Draw(shader);
+}
+
+// hands every texture of the model to the packer; call MaterialPacker::Pack and then UsePacker afterwards
+void Model::AddTextures(MaterialPacker &packer) {
+    for(unsigned int i = 0; i < textures_loaded.size(); i++)
+        packer.Add(textures_loaded[i].id);
+}
+
+// looks up which array layer each mesh's textures were packed into
+bool Model::UsePacker(const MaterialPacker &packer) {
+    GLint maxUnits = 16;
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &maxUnits);
+    bool complete = true;
+    for(unsigned int i = 0; i < meshes.size(); i++)
+    {
+        meshes[i].layers.clear();
+        for(unsigned int j = 0; j < meshes[i].textures.size(); j++)
+        {
+            PackedLayer layer = packer.Find(meshes[i].textures[j].id);
+            if (layer.layer < 0 || (GLint)layer.array >= maxUnits)
+                complete = false;
+            meshes[i].layers.push_back(layer);
+        }
+    }
+    return complete;
+}
+
+// draws the model with its textures read from the packer's arrays: they're bound once instead of per mesh
+void Model::Draw(Shader &shader, const MaterialPacker &packer) {
+    PROFILE_GPU_ZONE("model");
+    PipelineStatisticsPass statisticsPass("model");
+    packer.Bind();
+    for(unsigned int i = 0; i < meshes.size(); i++)
+        meshes[i].DrawPacked(shader);
+}
+
+// the packed draw, culled like Draw(shader, frustum, model)
+void Model::Draw(Shader &shader, const MaterialPacker &packer, const Frustum &frustum, const glm::mat4 &model) {
+    cullMeshes(frustum, model);
+    if (visibleMeshes.empty())
+        return;
+    PROFILE_GPU_ZONE("model");
+    PipelineStatisticsPass statisticsPass("model");
+    packer.Bind();
+    for(unsigned int i = 0; i < visibleMeshes.size(); i++)
+        meshes[visibleMeshes[i]].DrawPacked(shader);
+}
+
+// tells the TextureStreamer how large each mesh's textures appear from the camera, so it can stream their mips
+void Model::StreamTextures(const glm::mat4 &model, const glm::vec3 &cameraPosition, float fovY, int viewportHeight) {
+    // the largest axis scale of the model matrix grows the bounding spheres along with the meshes
+    float scale = glm::max(glm::length(glm::vec3(model[0])), glm::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+    for(unsigned int i = 0; i < meshes.size(); i++)
+    {
+        glm::vec3 center = glm::vec3(model * glm::vec4((meshes[i].boundsMin + meshes[i].boundsMax) * 0.5f, 1.0f));
+        float radius = glm::length(meshes[i].boundsMax - meshes[i].boundsMin) * 0.5f * scale;
+        float pixels = ProjectedSize(center, radius, cameraPosition, fovY, viewportHeight);
+        for(unsigned int j = 0; j < meshes[i].textures.size(); j++)
+            TextureStreamer::Instance().RequestScreenSize(meshes[i].textures[j].id, pixels);
+    }
+}
+
+// gives this model's references to its textures back to the TextureCache and deletes the meshes' buffers
+void Model::del() {
+    for(unsigned int i = 0; i < meshes.size(); i++)
+        meshes[i].del();
+    meshes.clear();
+    meshBounds.Clear();
+    for(unsigned int i = 0; i < textures_loaded.size(); i++)
+        TextureCache::Instance().Release(textures_loaded[i].id);
+    textures_loaded.clear();
+    textures_index.clear();
+}
+
 // loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
 void Model::loadModel(std::string const &path) {
+    PROFILE_ZONE("Model::loadModel");
+    ALLOC_SCOPE(ALLOC_MODELS);
     // read file via ASSIMP
     Assimp::Importer importer;
-    const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+    const aiScene* scene;
+    {
+        PROFILE_ZONE("assimp import");
+        scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_CalcTangentSpace);
+    }
     // check for errors
     if(!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) // if is Not Zero
     {
@@ -92,12 +267,8 @@ void Model::processNode(aiNode *node, const aiScene *scene)
 
 }
 
-Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene) {
-    // data to fill
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
-
+void ConvertMeshVertices(const aiMesh *mesh, std::vector<Vertex> &vertices) {
+    PROFILE_COUNTERS("convert vertices", mesh->mNumVertices);
     // walk through each of the mesh's vertices
     for(unsigned int i = 0; i < mesh->mNumVertices; i++)
     {
@@ -141,6 +312,16 @@ Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene) {
 
         vertices.push_back(vertex);
     }
+}
+
+Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene) {
+    PROFILE_ZONE("Model::processMesh");
+    // data to fill
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    std::vector<Texture> textures;
+
+    ConvertMeshVertices(mesh, vertices);
     // now wak through each of the mesh's faces (a face is a mesh its triangle) and retrieve the corresponding vertex indices.
     for(unsigned int i = 0; i < mesh->mNumFaces; i++)
     {
@@ -172,7 +353,7 @@ Mesh Model::processMesh(aiMesh *mesh, const aiScene *scene) {
     textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
 
     // return a mesh object created from the extracted mesh data
-    return Mesh(vertices, indices, textures);
+    return Mesh(std::move(vertices), std::move(indices), std::move(textures));
 }
 
 // checks all material textures of a given type and loads the textures if they're not loaded yet.
@@ -184,26 +365,25 @@ std::vector<Texture> Model::loadMaterialTextures(aiMaterial *mat, aiTextureType
     {
         aiString str;
         mat->GetTexture(type, i, &str);
-        // check if texture was loaded before and if so, continue to next iteration: skip loading a new texture
-        bool skip = false;
-        for(unsigned int j = 0; j < textures_loaded.size(); j++)
+        // only colour (diffuse) maps hold sRGB data, the others are linear
+        bool gamma = gammaCorrection && typeName == "texture_diffuse";
+        // check if this model loaded the texture before and if so, reuse it: skip acquiring it again. A file used as
+        // both a diffuse and a specular map is two textures, one sRGB and one linear (and bound under its own type)
+        std::string key = std::string(str.C_Str()) + (gamma ? "|srgb|" : "|linear|") + typeName;
+        auto loaded = textures_index.find(key);
+        if(loaded != textures_index.end())
         {
-            if(std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
-            {
-                textures.push_back(textures_loaded[j]);
-                skip = true; // a texture with the same filepath has already been loaded, continue to next one. (optimization)
-                break;
-            }
-        }
-        if(!skip)
-        {   // if texture hasn't been loaded already, load it
-            Texture texture;
-            texture.id = TextureFromFile(str.C_Str(), this->directory);
-            texture.type = typeName;
-            texture.path = str.C_Str();
-            textures.push_back(texture);
-            textures_loaded.push_back(texture);  // store it as texture loaded for entire model, to ensure we won't unnecesery load duplicate textures.
+            textures.push_back(textures_loaded[loaded->second]);
+            continue;
         }
+        // otherwise ask the process-wide cache, which only decodes the file if no other model has it yet
+        Texture texture;
+        texture.id = TextureCache::Instance().Acquire(str.C_Str(), this->directory, gamma, 0, typeName);
+        texture.type = typeName;
+        texture.path = str.C_Str();
+        textures.push_back(texture);
+        textures_index[key] = textures_loaded.size();
+        textures_loaded.push_back(texture);  // store it as texture loaded for entire model, to ensure we won't unnecesery load duplicate textures.
     }
     return textures;
 }
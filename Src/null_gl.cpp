@@ -0,0 +1,698 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <null_gl.h>
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+
+// texture units the bindings are kept for
+static const int NULL_GL_UNITS = 32;
+static const int NULL_GL_LEVELS = 16;
+
+struct NullTexture {
+    GLint internalFormat = GL_RGBA8;
+    bool compressed = false;
+    GLint baseLevel = 0;
+    GLint maxLevel = 1000;
+    GLint width[NULL_GL_LEVELS] = {};
+    GLint height[NULL_GL_LEVELS] = {};
+    GLint compressedSize[NULL_GL_LEVELS] = {};
+};
+
+// everything the backend remembers
+struct NullGlState {
+    NullGlCounters counters;
+    GLuint nextName = 1;
+    GLint viewport[4] = {0, 0, 0, 0};
+    GLuint program = 0;
+    GLuint vertexArray = 0;
+    GLuint drawFramebuffer = 0;
+    GLuint readFramebuffer = 0;
+    GLuint renderbuffer = 0;
+    GLenum unit = 0;
+    // per unit, GL_TEXTURE_2D's and GL_TEXTURE_2D_ARRAY's
+    GLuint textures[NULL_GL_UNITS][2] = {};
+    std::unordered_map<GLuint, NullTexture> textureObjects;
+    std::unordered_map<GLenum, bool> enabled;
+};
+static NullGlState state;
+
+static GLuint *binding(GLenum target)
+{
+    return &state.textures[state.unit][target == GL_TEXTURE_2D_ARRAY ? 1 : 0];
+}
+
+// the texture bound to target on the active unit, nullptr if none
+static NullTexture *boundTexture(GLenum target)
+{
+    GLuint texture = *binding(target);
+    if (texture == 0)
+        return nullptr;
+    return &state.textureObjects[texture];
+}
+
+static void setLevel(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, bool compressed, GLsizei size)
+{
+    NullTexture *texture = boundTexture(target);
+    if (!texture || level < 0 || level >= NULL_GL_LEVELS)
+        return;
+    texture->internalFormat = internalFormat;
+    texture->compressed = compressed;
+    texture->width[level] = width;
+    texture->height[level] = height;
+    texture->compressedSize[level] = compressed ? size : 0;
+}
+
+// bits per channel (red, green, blue, alpha) of the uncompressed formats the renderer uses
+static GLint channelBits(GLint internalFormat, int channel)
+{
+    int channels, bits = 8;
+    switch (internalFormat)
+    {
+    case GL_R8: case GL_RED: channels = 1; break;
+    case GL_R16F: channels = 1; bits = 16; break;
+    case GL_R32F: channels = 1; bits = 32; break;
+    case GL_RG8: case GL_RG: channels = 2; break;
+    case GL_RGB8: case GL_SRGB8: case GL_RGB: channels = 3; break;
+    case GL_RGBA16F: channels = 4; bits = 16; break;
+    case GL_RGBA32F: channels = 4; bits = 32; break;
+    default: channels = 4;
+    }
+    return channel < channels ? bits : 0;
+}
+
+// bytes a client image of this size holds, tightly packed
+static uint64_t imageBytes(GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type)
+{
+    uint64_t components = format == GL_RED || format == GL_DEPTH_COMPONENT ? 1 : format == GL_RG ? 2 :
+                          format == GL_RGB || format == GL_BGR ? 3 : 4;
+    uint64_t bytes = type == GL_FLOAT || type == GL_UNSIGNED_INT || type == GL_INT ? 4 :
+                     type == GL_HALF_FLOAT || type == GL_UNSIGNED_SHORT || type == GL_SHORT ? 2 : 1;
+    return (uint64_t)std::max(0, width) * (uint64_t)std::max(0, height) * (uint64_t)std::max(0, depth) * components * bytes;
+}
+
+static void countUpload(const void *data, uint64_t bytes)
+{
+    state.counters.uploads++;
+    if (data)
+        state.counters.uploadBytes += bytes;
+}
+
+static void gen(GLsizei n, GLuint *names)
+{
+    state.counters.calls++;
+    for (GLsizei i = 0; i < n; i++)
+        names[i] = state.nextName++;
+    state.counters.objectsCreated += (uint64_t)std::max(0, n);
+}
+
+static void remove(GLsizei n)
+{
+    state.counters.calls++;
+    state.counters.objectsDeleted += (uint64_t)std::max(0, n);
+}
+
+static void draw(GLsizei count, GLsizei instances)
+{
+    state.counters.calls++;
+    state.counters.draws++;
+    state.counters.vertices += (uint64_t)std::max(0, count) * (uint64_t)std::max(0, instances);
+}
+
+static void stateChange()
+{
+    state.counters.calls++;
+    state.counters.stateChanges++;
+}
+
+static void uniform()
+{
+    state.counters.calls++;
+    state.counters.uniforms++;
+}
+
+// the entry points
+
+static const GLubyte *APIENTRY null_glGetString(GLenum name)
+{
+    state.counters.calls++;
+    switch (name)
+    {
+    case GL_VENDOR: return reinterpret_cast<const GLubyte *>("blob_sea");
+    case GL_RENDERER: return reinterpret_cast<const GLubyte *>("null GL (counts calls, draws nothing)");
+    case GL_VERSION: return reinterpret_cast<const GLubyte *>("3.3 (Core Profile) null");
+    case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte *>("3.30");
+    default: return reinterpret_cast<const GLubyte *>("");
+    }
+}
+
+// glad gives up on a context without any extension, and timer queries are in 3.3 anyway
+static const GLubyte *APIENTRY null_glGetStringi(GLenum name, GLuint index)
+{
+    state.counters.calls++;
+    return reinterpret_cast<const GLubyte *>(name == GL_EXTENSIONS && index == 0 ? "GL_ARB_timer_query" : "");
+}
+
+static void APIENTRY null_glGetIntegerv(GLenum pname, GLint *data)
+{
+    state.counters.calls++;
+    switch (pname)
+    {
+    case GL_NUM_EXTENSIONS: *data = 1; break;
+    case GL_MAX_TEXTURE_SIZE: *data = 16384; break;
+    case GL_MAX_TEXTURE_IMAGE_UNITS: *data = 16; break;
+    case GL_MAX_ARRAY_TEXTURE_LAYERS: *data = 2048; break;
+    case GL_VIEWPORT: std::memcpy(data, state.viewport, sizeof(state.viewport)); break;
+    case GL_CURRENT_PROGRAM: *data = (GLint)state.program; break;
+    case GL_VERTEX_ARRAY_BINDING: *data = (GLint)state.vertexArray; break;
+    case GL_DRAW_FRAMEBUFFER_BINDING: *data = (GLint)state.drawFramebuffer; break;
+    case GL_READ_FRAMEBUFFER_BINDING: *data = (GLint)state.readFramebuffer; break;
+    case GL_ACTIVE_TEXTURE: *data = (GLint)(GL_TEXTURE0 + state.unit); break;
+    case GL_TEXTURE_BINDING_2D: *data = (GLint)*binding(GL_TEXTURE_2D); break;
+    case GL_TEXTURE_BINDING_2D_ARRAY: *data = (GLint)*binding(GL_TEXTURE_2D_ARRAY); break;
+    // no compressed formats: the texture paths take their uncompressed fallbacks
+    default: *data = 0;
+    }
+}
+
+static void APIENTRY null_glGetInteger64v(GLenum pname, GLint64 *data)
+{
+    state.counters.calls++;
+    *data = pname == GL_TIMESTAMP ? (GLint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count() : 0;
+}
+
+static GLenum APIENTRY null_glGetError()
+{
+    state.counters.calls++;
+    return GL_NO_ERROR;
+}
+
+static GLboolean APIENTRY null_glIsEnabled(GLenum cap)
+{
+    state.counters.calls++;
+    std::unordered_map<GLenum, bool>::const_iterator found = state.enabled.find(cap);
+    return found != state.enabled.end() && found->second ? GL_TRUE : GL_FALSE;
+}
+
+static void APIENTRY null_glEnable(GLenum cap)
+{
+    stateChange();
+    state.enabled[cap] = true;
+}
+
+static void APIENTRY null_glDisable(GLenum cap)
+{
+    stateChange();
+    state.enabled[cap] = false;
+}
+
+static void APIENTRY null_glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    stateChange();
+    state.viewport[0] = x;
+    state.viewport[1] = y;
+    state.viewport[2] = width;
+    state.viewport[3] = height;
+}
+
+static void APIENTRY null_glScissor(GLint, GLint, GLsizei, GLsizei) { stateChange(); }
+static void APIENTRY null_glBlendFunc(GLenum, GLenum) { stateChange(); }
+static void APIENTRY null_glDepthFunc(GLenum) { stateChange(); }
+static void APIENTRY null_glDepthMask(GLboolean) { stateChange(); }
+static void APIENTRY null_glColorMask(GLboolean, GLboolean, GLboolean, GLboolean) { stateChange(); }
+static void APIENTRY null_glCullFace(GLenum) { stateChange(); }
+static void APIENTRY null_glClearColor(GLfloat, GLfloat, GLfloat, GLfloat) { stateChange(); }
+static void APIENTRY null_glPixelStorei(GLenum, GLint) { stateChange(); }
+static void APIENTRY null_glClear(GLbitfield) { state.counters.calls++; }
+static void APIENTRY null_glFlush() { state.counters.calls++; }
+static void APIENTRY null_glFinish() { state.counters.calls++; }
+
+static void APIENTRY null_glDrawArrays(GLenum, GLint, GLsizei count) { draw(count, 1); }
+static void APIENTRY null_glDrawElements(GLenum, GLsizei count, GLenum, const void *) { draw(count, 1); }
+static void APIENTRY null_glDrawArraysInstanced(GLenum, GLint, GLsizei count, GLsizei instances) { draw(count, instances); }
+static void APIENTRY null_glDrawElementsInstanced(GLenum, GLsizei count, GLenum, const void *, GLsizei instances) { draw(count, instances); }
+
+static void APIENTRY null_glGenBuffers(GLsizei n, GLuint *buffers) { gen(n, buffers); }
+static void APIENTRY null_glDeleteBuffers(GLsizei n, const GLuint *) { remove(n); }
+static void APIENTRY null_glBindBuffer(GLenum, GLuint) { stateChange(); }
+
+static void APIENTRY null_glBufferData(GLenum, GLsizeiptr size, const void *data, GLenum)
+{
+    state.counters.calls++;
+    countUpload(data, (uint64_t)size);
+}
+
+static void APIENTRY null_glBufferSubData(GLenum, GLintptr, GLsizeiptr size, const void *data)
+{
+    state.counters.calls++;
+    countUpload(data, (uint64_t)size);
+}
+
+static void APIENTRY null_glGenVertexArrays(GLsizei n, GLuint *arrays) { gen(n, arrays); }
+static void APIENTRY null_glDeleteVertexArrays(GLsizei n, const GLuint *) { remove(n); }
+
+static void APIENTRY null_glBindVertexArray(GLuint array)
+{
+    stateChange();
+    state.vertexArray = array;
+}
+
+static void APIENTRY null_glEnableVertexAttribArray(GLuint) { stateChange(); }
+static void APIENTRY null_glDisableVertexAttribArray(GLuint) { stateChange(); }
+static void APIENTRY null_glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void *) { stateChange(); }
+static void APIENTRY null_glVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void *) { stateChange(); }
+static void APIENTRY null_glVertexAttribDivisor(GLuint, GLuint) { stateChange(); }
+
+static void APIENTRY null_glGenTextures(GLsizei n, GLuint *textures)
+{
+    gen(n, textures);
+    for (GLsizei i = 0; i < n; i++)
+        state.textureObjects[textures[i]] = NullTexture();
+}
+
+static void APIENTRY null_glDeleteTextures(GLsizei n, const GLuint *textures)
+{
+    remove(n);
+    for (GLsizei i = 0; i < n; i++)
+    {
+        state.textureObjects.erase(textures[i]);
+        for (int unit = 0; unit < NULL_GL_UNITS; unit++)
+            for (GLuint &bound : state.textures[unit])
+                if (bound == textures[i])
+                    bound = 0;
+    }
+}
+
+static void APIENTRY null_glActiveTexture(GLenum texture)
+{
+    stateChange();
+    state.unit = std::min<GLenum>(texture - GL_TEXTURE0, NULL_GL_UNITS - 1);
+}
+
+static void APIENTRY null_glBindTexture(GLenum target, GLuint texture)
+{
+    stateChange();
+    *binding(target) = texture;
+}
+
+static void APIENTRY null_glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    stateChange();
+    NullTexture *texture = boundTexture(target);
+    if (!texture)
+        return;
+    if (pname == GL_TEXTURE_BASE_LEVEL)
+        texture->baseLevel = param;
+    else if (pname == GL_TEXTURE_MAX_LEVEL)
+        texture->maxLevel = param;
+}
+
+static void APIENTRY null_glTexParameterf(GLenum, GLenum, GLfloat) { stateChange(); }
+
+static void APIENTRY null_glGetTexParameteriv(GLenum target, GLenum pname, GLint *params)
+{
+    state.counters.calls++;
+    NullTexture *texture = boundTexture(target);
+    *params = !texture ? 0 : pname == GL_TEXTURE_BASE_LEVEL ? texture->baseLevel : pname == GL_TEXTURE_MAX_LEVEL ? texture->maxLevel : 0;
+}
+
+static void APIENTRY null_glGetTexLevelParameteriv(GLenum target, GLint level, GLenum pname, GLint *params)
+{
+    state.counters.calls++;
+    NullTexture *texture = boundTexture(target);
+    *params = 0;
+    if (!texture || level < 0 || level >= NULL_GL_LEVELS)
+        return;
+    switch (pname)
+    {
+    case GL_TEXTURE_WIDTH: *params = texture->width[level]; break;
+    case GL_TEXTURE_HEIGHT: *params = texture->height[level]; break;
+    case GL_TEXTURE_INTERNAL_FORMAT: *params = texture->internalFormat; break;
+    case GL_TEXTURE_COMPRESSED: *params = texture->compressed ? GL_TRUE : GL_FALSE; break;
+    case GL_TEXTURE_COMPRESSED_IMAGE_SIZE: *params = texture->compressedSize[level]; break;
+    case GL_TEXTURE_RED_SIZE: *params = channelBits(texture->internalFormat, 0); break;
+    case GL_TEXTURE_GREEN_SIZE: *params = channelBits(texture->internalFormat, 1); break;
+    case GL_TEXTURE_BLUE_SIZE: *params = channelBits(texture->internalFormat, 2); break;
+    case GL_TEXTURE_ALPHA_SIZE: *params = channelBits(texture->internalFormat, 3); break;
+    default: break;
+    }
+}
+
+static void APIENTRY null_glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                       GLint, GLenum format, GLenum type, const void *pixels)
+{
+    state.counters.calls++;
+    setLevel(target, level, internalformat, width, height, false, 0);
+    countUpload(pixels, imageBytes(width, height, 1, format, type));
+}
+
+static void APIENTRY null_glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei width, GLsizei height, GLenum format,
+                                          GLenum type, const void *pixels)
+{
+    state.counters.calls++;
+    countUpload(pixels, imageBytes(width, height, 1, format, type));
+}
+
+static void APIENTRY null_glTexImage3D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                                       GLsizei depth, GLint, GLenum format, GLenum type, const void *pixels)
+{
+    state.counters.calls++;
+    setLevel(target, level, internalformat, width, height, false, 0);
+    countUpload(pixels, imageBytes(width, height, depth, format, type));
+}
+
+static void APIENTRY null_glTexSubImage3D(GLenum, GLint, GLint, GLint, GLint, GLsizei width, GLsizei height, GLsizei depth,
+                                          GLenum format, GLenum type, const void *pixels)
+{
+    state.counters.calls++;
+    countUpload(pixels, imageBytes(width, height, depth, format, type));
+}
+
+static void APIENTRY null_glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                                 GLsizei height, GLint, GLsizei imageSize, const void *data)
+{
+    state.counters.calls++;
+    setLevel(target, level, (GLint)internalformat, width, height, true, imageSize);
+    countUpload(data, (uint64_t)imageSize);
+}
+
+static void APIENTRY null_glCompressedTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum,
+                                                    GLsizei imageSize, const void *data)
+{
+    state.counters.calls++;
+    countUpload(data, (uint64_t)imageSize);
+}
+
+static void APIENTRY null_glCompressedTexImage3D(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                                 GLsizei height, GLsizei, GLint, GLsizei imageSize, const void *data)
+{
+    state.counters.calls++;
+    setLevel(target, level, (GLint)internalformat, width, height, true, imageSize);
+    countUpload(data, (uint64_t)imageSize);
+}
+
+static void APIENTRY null_glCompressedTexSubImage3D(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei,
+                                                    GLenum, GLsizei imageSize, const void *data)
+{
+    state.counters.calls++;
+    countUpload(data, (uint64_t)imageSize);
+}
+
+// the chain below the base level, halving down to 1x1
+static void APIENTRY null_glGenerateMipmap(GLenum target)
+{
+    state.counters.calls++;
+    NullTexture *texture = boundTexture(target);
+    if (!texture || texture->baseLevel < 0 || texture->baseLevel >= NULL_GL_LEVELS)
+        return;
+    for (GLint level = texture->baseLevel + 1; level < NULL_GL_LEVELS && level <= texture->maxLevel; level++)
+    {
+        if (texture->width[level - 1] <= 1 && texture->height[level - 1] <= 1)
+            break;
+        texture->width[level] = std::max(1, texture->width[level - 1] / 2);
+        texture->height[level] = std::max(1, texture->height[level - 1] / 2);
+    }
+}
+
+static void APIENTRY null_glGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void *pixels)
+{
+    state.counters.calls++;
+    NullTexture *texture = boundTexture(target);
+    if (texture && level >= 0 && level < NULL_GL_LEVELS)
+        std::memset(pixels, 0, (size_t)imageBytes(texture->width[level], texture->height[level], 1, format, type));
+}
+
+static void APIENTRY null_glGetCompressedTexImage(GLenum target, GLint level, void *img)
+{
+    state.counters.calls++;
+    NullTexture *texture = boundTexture(target);
+    if (texture && level >= 0 && level < NULL_GL_LEVELS)
+        std::memset(img, 0, (size_t)texture->compressedSize[level]);
+}
+
+static void APIENTRY null_glReadPixels(GLint, GLint, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels)
+{
+    state.counters.calls++;
+    std::memset(pixels, 0, (size_t)imageBytes(width, height, 1, format, type));
+}
+
+static void APIENTRY null_glGenFramebuffers(GLsizei n, GLuint *framebuffers) { gen(n, framebuffers); }
+static void APIENTRY null_glDeleteFramebuffers(GLsizei n, const GLuint *) { remove(n); }
+
+static void APIENTRY null_glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    stateChange();
+    if (target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER)
+        state.drawFramebuffer = framebuffer;
+    if (target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER)
+        state.readFramebuffer = framebuffer;
+}
+
+static GLenum APIENTRY null_glCheckFramebufferStatus(GLenum)
+{
+    state.counters.calls++;
+    return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static void APIENTRY null_glFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) { stateChange(); }
+static void APIENTRY null_glFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) { stateChange(); }
+static void APIENTRY null_glGenRenderbuffers(GLsizei n, GLuint *renderbuffers) { gen(n, renderbuffers); }
+static void APIENTRY null_glDeleteRenderbuffers(GLsizei n, const GLuint *) { remove(n); }
+
+static void APIENTRY null_glBindRenderbuffer(GLenum, GLuint renderbuffer)
+{
+    stateChange();
+    state.renderbuffer = renderbuffer;
+}
+
+static void APIENTRY null_glRenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) { state.counters.calls++; }
+
+static GLuint APIENTRY null_glCreateShader(GLenum)
+{
+    GLuint shader;
+    gen(1, &shader);
+    return shader;
+}
+
+static GLuint APIENTRY null_glCreateProgram()
+{
+    GLuint program;
+    gen(1, &program);
+    return program;
+}
+
+static void APIENTRY null_glShaderSource(GLuint, GLsizei, const GLchar *const *, const GLint *) { state.counters.calls++; }
+static void APIENTRY null_glCompileShader(GLuint) { state.counters.calls++; }
+static void APIENTRY null_glAttachShader(GLuint, GLuint) { state.counters.calls++; }
+static void APIENTRY null_glLinkProgram(GLuint) { state.counters.calls++; }
+static void APIENTRY null_glDeleteShader(GLuint) { remove(1); }
+static void APIENTRY null_glDeleteProgram(GLuint) { remove(1); }
+
+// every compile and link succeeds, without a log
+static void APIENTRY null_glGetShaderiv(GLuint, GLenum pname, GLint *params)
+{
+    state.counters.calls++;
+    *params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY null_glGetProgramiv(GLuint, GLenum pname, GLint *params)
+{
+    state.counters.calls++;
+    *params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+}
+
+static void APIENTRY null_glGetShaderInfoLog(GLuint, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    state.counters.calls++;
+    if (length)
+        *length = 0;
+    if (bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+static void APIENTRY null_glGetProgramInfoLog(GLuint, GLsizei bufSize, GLsizei *length, GLchar *infoLog)
+{
+    state.counters.calls++;
+    if (length)
+        *length = 0;
+    if (bufSize > 0)
+        infoLog[0] = '\0';
+}
+
+static void APIENTRY null_glUseProgram(GLuint program)
+{
+    stateChange();
+    state.program = program;
+}
+
+// a location from the name alone: the same name always gets the same location, at the cost of hashing it, about
+// what a driver's lookup costs
+static GLint APIENTRY null_glGetUniformLocation(GLuint, const GLchar *name)
+{
+    state.counters.calls++;
+    uint32_t hash = 2166136261u;
+    for (const GLchar *c = name; *c; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619u;
+    return (GLint)(hash & 0x3ff);
+}
+
+static void APIENTRY null_glUniform1i(GLint, GLint) { uniform(); }
+static void APIENTRY null_glUniform1f(GLint, GLfloat) { uniform(); }
+static void APIENTRY null_glUniform2f(GLint, GLfloat, GLfloat) { uniform(); }
+static void APIENTRY null_glUniform3f(GLint, GLfloat, GLfloat, GLfloat) { uniform(); }
+static void APIENTRY null_glUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) { uniform(); }
+static void APIENTRY null_glUniform3fv(GLint, GLsizei, const GLfloat *) { uniform(); }
+static void APIENTRY null_glUniform4fv(GLint, GLsizei, const GLfloat *) { uniform(); }
+static void APIENTRY null_glUniformMatrix3fv(GLint, GLsizei, GLboolean, const GLfloat *) { uniform(); }
+static void APIENTRY null_glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat *) { uniform(); }
+
+static void APIENTRY null_glGenQueries(GLsizei n, GLuint *ids) { gen(n, ids); }
+static void APIENTRY null_glDeleteQueries(GLsizei n, const GLuint *) { remove(n); }
+static void APIENTRY null_glBeginQuery(GLenum, GLuint) { state.counters.calls++; }
+static void APIENTRY null_glEndQuery(GLenum) { state.counters.calls++; }
+static void APIENTRY null_glQueryCounter(GLuint, GLenum) { state.counters.calls++; }
+
+// results are always there, and always zero
+static void APIENTRY null_glGetQueryObjectuiv(GLuint, GLenum pname, GLuint *params)
+{
+    state.counters.calls++;
+    *params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+static void APIENTRY null_glGetQueryObjectui64v(GLuint, GLenum pname, GLuint64 *params)
+{
+    state.counters.calls++;
+    *params = pname == GL_QUERY_RESULT_AVAILABLE ? GL_TRUE : 0;
+}
+
+struct NullGlFunction {
+    const char *name;
+    void *function;
+};
+
+#define NULL_GL_FUNCTION(name) {#name, reinterpret_cast<void *>(null_##name)}
+static const NullGlFunction NULL_GL_FUNCTIONS[] = {
+        NULL_GL_FUNCTION(glGetString),
+        NULL_GL_FUNCTION(glGetStringi),
+        NULL_GL_FUNCTION(glGetIntegerv),
+        NULL_GL_FUNCTION(glGetInteger64v),
+        NULL_GL_FUNCTION(glGetError),
+        NULL_GL_FUNCTION(glIsEnabled),
+        NULL_GL_FUNCTION(glEnable),
+        NULL_GL_FUNCTION(glDisable),
+        NULL_GL_FUNCTION(glViewport),
+        NULL_GL_FUNCTION(glScissor),
+        NULL_GL_FUNCTION(glBlendFunc),
+        NULL_GL_FUNCTION(glDepthFunc),
+        NULL_GL_FUNCTION(glDepthMask),
+        NULL_GL_FUNCTION(glColorMask),
+        NULL_GL_FUNCTION(glCullFace),
+        NULL_GL_FUNCTION(glClearColor),
+        NULL_GL_FUNCTION(glPixelStorei),
+        NULL_GL_FUNCTION(glClear),
+        NULL_GL_FUNCTION(glFlush),
+        NULL_GL_FUNCTION(glFinish),
+        NULL_GL_FUNCTION(glDrawArrays),
+        NULL_GL_FUNCTION(glDrawElements),
+        NULL_GL_FUNCTION(glDrawArraysInstanced),
+        NULL_GL_FUNCTION(glDrawElementsInstanced),
+        NULL_GL_FUNCTION(glGenBuffers),
+        NULL_GL_FUNCTION(glDeleteBuffers),
+        NULL_GL_FUNCTION(glBindBuffer),
+        NULL_GL_FUNCTION(glBufferData),
+        NULL_GL_FUNCTION(glBufferSubData),
+        NULL_GL_FUNCTION(glGenVertexArrays),
+        NULL_GL_FUNCTION(glDeleteVertexArrays),
+        NULL_GL_FUNCTION(glBindVertexArray),
+        NULL_GL_FUNCTION(glEnableVertexAttribArray),
+        NULL_GL_FUNCTION(glDisableVertexAttribArray),
+        NULL_GL_FUNCTION(glVertexAttribPointer),
+        NULL_GL_FUNCTION(glVertexAttribIPointer),
+        NULL_GL_FUNCTION(glVertexAttribDivisor),
+        NULL_GL_FUNCTION(glGenTextures),
+        NULL_GL_FUNCTION(glDeleteTextures),
+        NULL_GL_FUNCTION(glActiveTexture),
+        NULL_GL_FUNCTION(glBindTexture),
+        NULL_GL_FUNCTION(glTexParameteri),
+        NULL_GL_FUNCTION(glTexParameterf),
+        NULL_GL_FUNCTION(glGetTexParameteriv),
+        NULL_GL_FUNCTION(glGetTexLevelParameteriv),
+        NULL_GL_FUNCTION(glTexImage2D),
+        NULL_GL_FUNCTION(glTexSubImage2D),
+        NULL_GL_FUNCTION(glTexImage3D),
+        NULL_GL_FUNCTION(glTexSubImage3D),
+        NULL_GL_FUNCTION(glCompressedTexImage2D),
+        NULL_GL_FUNCTION(glCompressedTexSubImage2D),
+        NULL_GL_FUNCTION(glCompressedTexImage3D),
+        NULL_GL_FUNCTION(glCompressedTexSubImage3D),
+        NULL_GL_FUNCTION(glGenerateMipmap),
+        NULL_GL_FUNCTION(glGetTexImage),
+        NULL_GL_FUNCTION(glGetCompressedTexImage),
+        NULL_GL_FUNCTION(glReadPixels),
+        NULL_GL_FUNCTION(glGenFramebuffers),
+        NULL_GL_FUNCTION(glDeleteFramebuffers),
+        NULL_GL_FUNCTION(glBindFramebuffer),
+        NULL_GL_FUNCTION(glCheckFramebufferStatus),
+        NULL_GL_FUNCTION(glFramebufferTexture2D),
+        NULL_GL_FUNCTION(glFramebufferRenderbuffer),
+        NULL_GL_FUNCTION(glGenRenderbuffers),
+        NULL_GL_FUNCTION(glDeleteRenderbuffers),
+        NULL_GL_FUNCTION(glBindRenderbuffer),
+        NULL_GL_FUNCTION(glRenderbufferStorage),
+        NULL_GL_FUNCTION(glCreateShader),
+        NULL_GL_FUNCTION(glCreateProgram),
+        NULL_GL_FUNCTION(glShaderSource),
+        NULL_GL_FUNCTION(glCompileShader),
+        NULL_GL_FUNCTION(glAttachShader),
+        NULL_GL_FUNCTION(glLinkProgram),
+        NULL_GL_FUNCTION(glDeleteShader),
+        NULL_GL_FUNCTION(glDeleteProgram),
+        NULL_GL_FUNCTION(glGetShaderiv),
+        NULL_GL_FUNCTION(glGetProgramiv),
+        NULL_GL_FUNCTION(glGetShaderInfoLog),
+        NULL_GL_FUNCTION(glGetProgramInfoLog),
+        NULL_GL_FUNCTION(glUseProgram),
+        NULL_GL_FUNCTION(glGetUniformLocation),
+        NULL_GL_FUNCTION(glUniform1i),
+        NULL_GL_FUNCTION(glUniform1f),
+        NULL_GL_FUNCTION(glUniform2f),
+        NULL_GL_FUNCTION(glUniform3f),
+        NULL_GL_FUNCTION(glUniform4f),
+        NULL_GL_FUNCTION(glUniform3fv),
+        NULL_GL_FUNCTION(glUniform4fv),
+        NULL_GL_FUNCTION(glUniformMatrix3fv),
+        NULL_GL_FUNCTION(glUniformMatrix4fv),
+        NULL_GL_FUNCTION(glGenQueries),
+        NULL_GL_FUNCTION(glDeleteQueries),
+        NULL_GL_FUNCTION(glBeginQuery),
+        NULL_GL_FUNCTION(glEndQuery),
+        NULL_GL_FUNCTION(glQueryCounter),
+        NULL_GL_FUNCTION(glGetQueryObjectuiv),
+        NULL_GL_FUNCTION(glGetQueryObjectui64v),
+};
+#undef NULL_GL_FUNCTION
+
+void *NullGl::GetProcAddress(const char *name)
+{
+    for (const NullGlFunction &function : NULL_GL_FUNCTIONS)
+        if (std::strcmp(function.name, name) == 0)
+            return function.function;
+    return nullptr;
+}
+
+const NullGlCounters &NullGl::Counters()
+{
+    return state.counters;
+}
+
+void NullGl::Reset()
+{
+    state.counters = NullGlCounters();
+}
@@ -0,0 +1,135 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <overdraw.h>
+
+#include <algorithm>
+#include <iostream>
+
+void OverdrawView::Create()
+{
+    viewShader.reset(new Shader("../Resources/shader_overdraw_view.vert", "../Resources/shader_overdraw_view.frag"));
+    // core profile draws need a vertex array bound, even one without attributes
+    glGenVertexArrays(1, &emptyVAO);
+}
+
+void OverdrawView::createTarget(int width, int height)
+{
+    this->width = width;
+    this->height = height;
+
+    glGenTextures(1, &counts);
+    glBindTexture(GL_TEXTURE_2D, counts);
+    // float, so counts don't saturate and additive blending stays exact
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    glGenRenderbuffers(1, &depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, counts, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "Overdraw: counter framebuffer incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+}
+
+void OverdrawView::deleteTarget()
+{
+    if (framebuffer)
+        glDeleteFramebuffers(1, &framebuffer);
+    if (counts)
+        glDeleteTextures(1, &counts);
+    if (depth)
+        glDeleteRenderbuffers(1, &depth);
+    framebuffer = counts = depth = 0;
+    width = height = 0;
+}
+
+void OverdrawView::Begin(int width, int height, bool depthTest)
+{
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+    previousDepthTest = glIsEnabled(GL_DEPTH_TEST) == GL_TRUE;
+
+    if (width != this->width || height != this->height)
+    {
+        deleteTarget();
+        createTarget(width, height);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (depthTest)
+        glEnable(GL_DEPTH_TEST);
+    else
+        glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+}
+
+void OverdrawView::End()
+{
+    glDisable(GL_BLEND);
+    if (previousDepthTest)
+        glEnable(GL_DEPTH_TEST);
+    else
+        glDisable(GL_DEPTH_TEST);
+
+    readback.resize((size_t)width * height);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RED, GL_FLOAT, readback.data());
+
+    double total = 0.0;
+    size_t covered = 0;
+    maximum = 0.0f;
+    for (float count : readback)
+    {
+        total += count;
+        if (count > 0.0f)
+            covered++;
+        maximum = std::max(maximum, count);
+    }
+    mean = readback.empty() ? 0.0f : (float)(total / readback.size());
+    coveredMean = covered == 0 ? 0.0f : (float)(total / covered);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFramebuffer);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+}
+
+void OverdrawView::Show()
+{
+    if (!viewShader || !counts)
+        return;
+    glDisable(GL_DEPTH_TEST);
+    glUseProgram(viewShader->ID);
+    glUniform1i(glGetUniformLocation(viewShader->ID, "counts"), 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, counts);
+    glBindVertexArray(emptyVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    glBindVertexArray(0);
+    if (previousDepthTest)
+        glEnable(GL_DEPTH_TEST);
+}
+
+void OverdrawView::del()
+{
+    deleteTarget();
+    if (viewShader)
+        viewShader->del();
+    viewShader.reset();
+    if (emptyVAO)
+        glDeleteVertexArrays(1, &emptyVAO);
+    emptyVAO = 0;
+}
@@ -0,0 +1,211 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <perf_counters.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const char *const PERF_COUNTER_NAMES[PERF_COUNTER_COUNT] = {"cycles", "instructions", "LLC misses", "branch misses"};
+
+// the calling thread's counter group, opened on its first zone and closed when the thread exits
+struct PerfThreadCounters {
+    bool opened = false;
+    int fds[PERF_COUNTER_COUNT] = {-1, -1, -1, -1};
+    // the group leader, every read goes through it
+    int leader = -1;
+    // where each counter is in the group's read, -1 for the missing ones
+    int slots[PERF_COUNTER_COUNT] = {-1, -1, -1, -1};
+    int members = 0;
+
+    ~PerfThreadCounters()
+    {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0)
+                close(fd);
+#endif
+    }
+
+    void open();
+};
+
+static thread_local PerfThreadCounters threadCounters;
+
+#ifdef __linux__
+// the counter's perf event, user space only so it's allowed at the default perf_event_paranoid of 2
+static int openCounter(PerfCounter counter, int groupFd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    switch (counter)
+    {
+    case PERF_CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+    case PERF_INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+    // the generic cache miss event is the last level cache's on x86 and most ARM cores
+    case PERF_LLC_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+    default: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+    }
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // this thread, on any CPU
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+#endif
+
+void PerfThreadCounters::open()
+{
+    opened = true;
+#ifdef __linux__
+    int error = 0;
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; counter++)
+    {
+        // the first counter that opens leads the group, the others are read with it
+        int fd = openCounter((PerfCounter)counter, leader);
+        if (fd < 0)
+        {
+            error = errno;
+            continue;
+        }
+        fds[counter] = fd;
+        if (leader < 0)
+            leader = fd;
+        slots[counter] = members++;
+    }
+    if (leader < 0)
+    {
+        // once per process, not per thread
+        static std::atomic<bool> reported{false};
+        if (!reported.exchange(true))
+            std::cout << "Perf: no hardware counters (" << std::strerror(error) << "): the CPU or VM has none, or "
+                      << "/proc/sys/kernel/perf_event_paranoid forbids them" << std::endl;
+    }
+#endif
+}
+
+PerfCounters &PerfCounters::Instance()
+{
+    static PerfCounters counters;
+    return counters;
+}
+
+bool PerfCounters::Available()
+{
+    if (!threadCounters.opened)
+        threadCounters.open();
+    return threadCounters.leader >= 0;
+}
+
+bool PerfCounters::Read(PerfCounterValues &values)
+{
+    if (!Available())
+        return false;
+#ifdef __linux__
+    // nr, time enabled, time running, then a value per member
+    uint64_t group[3 + PERF_COUNTER_COUNT];
+    if (read(threadCounters.leader, group, sizeof(group)) < (ssize_t)(3 + threadCounters.members) * (ssize_t)sizeof(uint64_t))
+        return false;
+    values.timeEnabled = group[1];
+    values.timeRunning = group[2];
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; counter++)
+    {
+        int slot = threadCounters.slots[counter];
+        values.present[counter] = slot >= 0;
+        values.counts[counter] = slot >= 0 ? group[3 + slot] : 0;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void PerfCounters::Record(const char *name, uint64_t elements, const PerfCounterValues &begin, const PerfCounterValues &end)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    PerfZoneTotals *zone = nullptr;
+    for (PerfZoneTotals &candidate : zones)
+    {
+        if (candidate.name == name || std::strcmp(candidate.name, name) == 0)
+        {
+            zone = &candidate;
+            break;
+        }
+    }
+    if (!zone)
+    {
+        zones.push_back(PerfZoneTotals());
+        zone = &zones.back();
+        zone->name = name;
+    }
+    zone->runs++;
+    zone->elements += elements;
+    // the group counted only while it was on the PMU, which is less than the whole zone when more groups than
+    // counters are open: the zone's counts are scaled up by its own share, not the thread's whole history's
+    uint64_t enabled = end.timeEnabled - begin.timeEnabled;
+    uint64_t running = end.timeRunning - begin.timeRunning;
+    double scale = running > 0 ? (double)enabled / (double)running : 0.0;
+    for (int counter = 0; counter < PERF_COUNTER_COUNT; counter++)
+    {
+        // raw counts never go down
+        zone->counts[counter] += (uint64_t)((double)(end.counts[counter] - begin.counts[counter]) * scale);
+        zone->present[counter] = zone->present[counter] || end.present[counter];
+    }
+}
+
+std::vector<PerfZoneTotals> PerfCounters::Totals()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return zones;
+}
+
+void PerfCounters::Print()
+{
+    std::vector<PerfZoneTotals> totals = Totals();
+    if (totals.empty())
+        return;
+    std::printf("%-24s %8s %12s %8s %8s", "hardware counters", "runs", "elements", "IPC", "cycles");
+    for (int counter = PERF_LLC_MISSES; counter < PERF_COUNTER_COUNT; counter++)
+        std::printf(" %14s", PERF_COUNTER_NAMES[counter]);
+    std::printf("   (per element)\n");
+    for (const PerfZoneTotals &zone : totals)
+    {
+        // a zone that didn't say how many elements is per run
+        double per = (double)(zone.elements > 0 ? zone.elements : zone.runs);
+        std::printf("%-24s %8llu %12llu", zone.name, (unsigned long long)zone.runs, (unsigned long long)zone.elements);
+        if (zone.present[PERF_CYCLES] && zone.present[PERF_INSTRUCTIONS] && zone.counts[PERF_CYCLES] > 0)
+            std::printf(" %8.2f", (double)zone.counts[PERF_INSTRUCTIONS] / (double)zone.counts[PERF_CYCLES]);
+        else
+            std::printf(" %8s", "-");
+        if (zone.present[PERF_CYCLES])
+            std::printf(" %8.1f", (double)zone.counts[PERF_CYCLES] / per);
+        else
+            std::printf(" %8s", "-");
+        for (int counter = PERF_LLC_MISSES; counter < PERF_COUNTER_COUNT; counter++)
+        {
+            if (zone.present[counter])
+                std::printf(" %14.4f", (double)zone.counts[counter] / per);
+            else
+                std::printf(" %14s", "-");
+        }
+        std::printf("\n");
+    }
+}
+
+void PerfCounters::Reset()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    zones.clear();
+}
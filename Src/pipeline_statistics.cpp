@@ -0,0 +1,108 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <pipeline_statistics.h>
+
+#include <iostream>
+
+static const GLenum STATISTICS_TARGETS[] = {
+        GL_VERTICES_SUBMITTED_ARB,
+        GL_VERTEX_SHADER_INVOCATIONS_ARB,
+        GL_CLIPPING_INPUT_PRIMITIVES_ARB,
+        GL_CLIPPING_OUTPUT_PRIMITIVES_ARB,
+        GL_FRAGMENT_SHADER_INVOCATIONS_ARB
+};
+
+PipelineStatistics &PipelineStatistics::Instance()
+{
+    static PipelineStatistics statistics;
+    return statistics;
+}
+
+bool PipelineStatistics::SetEnabled(bool enabled)
+{
+    if (enabled && !GLAD_GL_ARB_pipeline_statistics_query)
+    {
+        std::cout << "PipelineStatistics: GL_ARB_pipeline_statistics_query isn't supported" << std::endl;
+        this->enabled = false;
+        return false;
+    }
+    this->enabled = enabled;
+    return true;
+}
+
+void PipelineStatistics::BeginFrame()
+{
+    current = (current + 1) % GPU_PROFILE_FRAMES;
+    collect(frames[current]);
+}
+
+void PipelineStatistics::Begin(const char *name)
+{
+    if (depth++ > 0 || !enabled)
+        return;
+    Frame &frame = frames[current];
+    size_t first = frame.passes.size() * TARGETS;
+    if (frame.queries.size() < first + TARGETS)
+    {
+        frame.queries.resize(first + TARGETS);
+        glGenQueries(TARGETS, frame.queries.data() + first);
+    }
+    for (int t = 0; t < TARGETS; t++)
+        glBeginQuery(STATISTICS_TARGETS[t], frame.queries[first + t]);
+    frame.passes.push_back(name);
+    measuring = true;
+}
+
+void PipelineStatistics::End()
+{
+    if (depth == 0 || --depth > 0 || !measuring)
+        return;
+    for (int t = 0; t < TARGETS; t++)
+        glEndQuery(STATISTICS_TARGETS[t]);
+    measuring = false;
+}
+
+void PipelineStatistics::collect(Frame &frame)
+{
+    if (!frame.passes.empty())
+    {
+        // a frame the GPU is still working on is skipped rather than waited for
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(frame.queries[frame.passes.size() * TARGETS - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available)
+        {
+            lastFrame.clear();
+            for (size_t i = 0; i < frame.passes.size(); i++)
+            {
+                GLuint64 results[TARGETS];
+                for (int t = 0; t < TARGETS; t++)
+                    glGetQueryObjectui64v(frame.queries[i * TARGETS + t], GL_QUERY_RESULT, &results[t]);
+                PassStatistics pass;
+                pass.name = frame.passes[i];
+                pass.verticesSubmitted = results[0];
+                pass.vertexShaderInvocations = results[1];
+                pass.clippingInputPrimitives = results[2];
+                pass.clippingOutputPrimitives = results[3];
+                pass.fragmentShaderInvocations = results[4];
+                lastFrame.push_back(pass);
+            }
+        }
+    }
+    frame.passes.clear();
+}
+
+void PipelineStatistics::del()
+{
+    for (Frame &frame : frames)
+    {
+        if (!frame.queries.empty())
+            glDeleteQueries((GLsizei)frame.queries.size(), frame.queries.data());
+        frame.queries.clear();
+        frame.passes.clear();
+    }
+    lastFrame.clear();
+    enabled = measuring = false;
+    depth = 0;
+}
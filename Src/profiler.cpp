@@ -0,0 +1,230 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <profiler.h>
+#include <alloc_tracker.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+// hands the calling thread's ring back when the thread exits, so short lived workers (the JPEG decode threads)
+// don't leave one ring each behind
+struct ProfileThreadRing {
+    ProfileRing *ring = nullptr;
+
+    ~ProfileThreadRing()
+    {
+        if (ring)
+            Profiler::Instance().releaseRing(ring);
+    }
+};
+
+static thread_local ProfileThreadRing currentRing;
+
+Profiler &Profiler::Instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : startTicks(ProfileTimestamp()), startTime(std::chrono::steady_clock::now())
+{
+}
+
+ProfileRing *Profiler::threadRing()
+{
+    if (currentRing.ring)
+        return currentRing.ring;
+
+    ALLOC_SCOPE(ALLOC_PROFILER);
+    std::lock_guard<std::mutex> lock(mutex);
+    ProfileRing *ring = nullptr;
+    for (auto &candidate : rings)
+    {
+        if (!candidate->owned)
+        {
+            ring = candidate.get();
+            break;
+        }
+    }
+    if (!ring)
+    {
+        rings.emplace_back(new ProfileRing());
+        ring = rings.back().get();
+        ring->id = (unsigned int)rings.size();
+        ring->name = "thread " + std::to_string(ring->id);
+    }
+    ring->owned = true;
+    currentRing.ring = ring;
+    return ring;
+}
+
+void Profiler::releaseRing(ProfileRing *ring)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ring->owned = false;
+}
+
+void Profiler::Record(const char *name, uint64_t begin, uint64_t end)
+{
+    ProfileRing *ring = threadRing();
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    ProfileEvent &event = ring->events[head & (PROFILE_RING_EVENTS - 1)];
+    event.name = name;
+    event.begin = begin;
+    event.end = end;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char *name)
+{
+    ProfileRing *ring = threadRing();
+    std::lock_guard<std::mutex> lock(mutex);
+    ring->name = name;
+}
+
+void Profiler::SyncGpuClock(uint64_t gpuNs, uint64_t ticks)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!gpuRing)
+    {
+        // owned from the start, so no thread is ever handed it
+        rings.emplace_back(new ProfileRing());
+        gpuRing = rings.back().get();
+        gpuRing->id = (unsigned int)rings.size();
+        gpuRing->name = "GPU";
+        gpuRing->owned = true;
+        gpuRing->gpu = true;
+    }
+    gpuSyncNs = gpuNs;
+    gpuSyncTicks = ticks;
+}
+
+void Profiler::RecordGpu(const char *name, uint64_t beginNs, uint64_t endNs)
+{
+    if (!gpuRing)
+        return;
+    uint64_t head = gpuRing->head.load(std::memory_order_relaxed);
+    ProfileEvent &event = gpuRing->events[head & (PROFILE_RING_EVENTS - 1)];
+    event.name = name;
+    event.begin = beginNs;
+    event.end = endNs;
+    gpuRing->head.store(head + 1, std::memory_order_release);
+}
+
+// zone names are string literals, but __func__ style names can still hold characters JSON has to escape
+static void writeJsonString(FILE *file, const char *text)
+{
+    std::fputc('"', file);
+    for (const char *c = text; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            std::fprintf(file, "\\%c", *c);
+        else if ((unsigned char)*c < 0x20)
+            std::fprintf(file, "\\u%04x", *c);
+        else
+            std::fputc(*c, file);
+    }
+    std::fputc('"', file);
+}
+
+double Profiler::ticksPerMicrosecond()
+{
+    // measured over the whole run (a short run waits a little to get a usable ratio). The TSC runs at a constant
+    // rate on every CPU this renders on
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    while (now - startTime < std::chrono::milliseconds(10))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        now = std::chrono::steady_clock::now();
+    }
+    uint64_t nowTicks = ProfileTimestamp();
+    double elapsedUs = std::chrono::duration<double, std::micro>(now - startTime).count();
+    return (double)(nowTicks - startTicks) / elapsedUs;
+}
+
+uint64_t Profiler::TicksAgo(double seconds)
+{
+    double ticks = seconds * 1e6 * ticksPerMicrosecond();
+    uint64_t now = ProfileTimestamp();
+    return ticks >= (double)(now - startTicks) ? startTicks : now - (uint64_t)ticks;
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path, uint64_t sinceTicks, double *lostSeconds)
+{
+    ALLOC_SCOPE(ALLOC_PROFILER);
+    double ticksPerUs = ticksPerMicrosecond();
+
+    FILE *file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        std::cout << "Profiler: can't write " << path << std::endl;
+        return false;
+    }
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    std::lock_guard<std::mutex> lock(mutex);
+    bool first = true;
+    // the latest a wrapped ring's zones start at, everything since sinceTicks is in the trace before that
+    uint64_t coveredFrom = sinceTicks;
+    std::vector<ProfileEvent> events;
+    for (auto &ring : rings)
+    {
+        // copy out what the ring holds, then drop whatever its thread overwrote while we were copying
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t oldest = head > PROFILE_RING_EVENTS ? head - PROFILE_RING_EVENTS : 0;
+        events.clear();
+        for (uint64_t i = oldest; i < head; i++)
+            events.push_back(ring->events[i & (PROFILE_RING_EVENTS - 1)]);
+        uint64_t headAfter = ring->head.load(std::memory_order_acquire);
+        if (headAfter >= PROFILE_RING_EVENTS && headAfter - PROFILE_RING_EVENTS + 1 > oldest)
+            events.erase(events.begin(), events.begin() + (ptrdiff_t)std::min<uint64_t>(events.size(), headAfter - PROFILE_RING_EVENTS + 1 - oldest));
+        if (events.empty())
+            continue;
+        // zones are added as they end, so the first left is where the thread's surviving history starts
+        bool wrapped = headAfter > PROFILE_RING_EVENTS;
+
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", ring->id);
+        writeJsonString(file, ring->name.c_str());
+        std::fprintf(file, "}}");
+        first = false;
+
+        for (size_t i = 0; i < events.size(); i++)
+        {
+            ProfileEvent &event = events[i];
+            // both clocks run at a constant rate, so one pair of readings lines GPU time up with CPU time
+            if (ring->gpu)
+            {
+                event.begin = gpuSyncTicks + (uint64_t)((double)(int64_t)(event.begin - gpuSyncNs) * ticksPerUs / 1000.0);
+                event.end = gpuSyncTicks + (uint64_t)((double)(int64_t)(event.end - gpuSyncNs) * ticksPerUs / 1000.0);
+            }
+            if (i == 0 && wrapped && event.end > sinceTicks)
+            {
+                // the ring is too small for the time asked for: say where this thread's zones start
+                coveredFrom = std::max(coveredFrom, event.end);
+                double at = event.end > startTicks ? (double)(event.end - startTicks) / ticksPerUs : 0.0;
+                std::fprintf(file, ",\n{\"name\":\"earlier zones overwritten\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}",
+                             ring->id, at);
+            }
+            if (event.end < sinceTicks)
+                continue;
+            // zones that began before the profiler did (its first use) are clamped to its start
+            double begin = event.begin > startTicks ? (double)(event.begin - startTicks) / ticksPerUs : 0.0;
+            double duration = event.end > event.begin ? (double)(event.end - event.begin) / ticksPerUs : 0.0;
+            std::fprintf(file, ",\n{\"name\":");
+            writeJsonString(file, event.name);
+            std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", ring->id, begin, duration);
+        }
+    }
+
+    std::fprintf(file, "\n]}\n");
+    if (lostSeconds)
+        *lostSeconds = (double)(coveredFrom - sinceTicks) / ticksPerUs / 1e6;
+    bool written = std::ferror(file) == 0;
+    std::fclose(file);
+    return written;
+}
@@ -0,0 +1,54 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <render_stats.h>
+
+RenderStats &RenderStats::Instance()
+{
+    static RenderStats stats;
+    return stats;
+}
+
+void RenderStats::BeginFrame()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (started)
+    {
+        last = current;
+        frameMs[nextFrame] = std::chrono::duration<float, std::milli>(now - frameStart).count();
+        histogram.Add(frameMs[nextFrame]);
+        nextFrame = (nextFrame + 1) % RENDER_STATS_HISTORY;
+        if (frameCount < RENDER_STATS_HISTORY)
+            frameCount++;
+    }
+    current = RenderCounters();
+    frameStart = now;
+    started = true;
+}
+
+float RenderStats::FrameMs(unsigned int index) const
+{
+    if (index >= frameCount)
+        return 0.0f;
+    // nextFrame is where the oldest one is once the history is full
+    unsigned int oldest = frameCount < RENDER_STATS_HISTORY ? 0 : nextFrame;
+    return frameMs[(oldest + index) % RENDER_STATS_HISTORY];
+}
+
+void RenderStats::CountDraw(GLenum mode, size_t vertices)
+{
+    current.drawCalls++;
+    current.vertices += vertices;
+    if (mode == GL_TRIANGLES)
+        current.triangles += vertices / 3;
+    else if ((mode == GL_TRIANGLE_STRIP || mode == GL_TRIANGLE_FAN) && vertices >= 3)
+        current.triangles += vertices - 2;
+}
+
+void RenderStats::CountProgram(unsigned int program)
+{
+    if (program != boundProgram)
+        current.programSwitches++;
+    boundProgram = program;
+}
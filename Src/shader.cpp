@@ -3,6 +3,7 @@
 //
 
 #include"shader.h"
+#include "render_stats.h"
 
 std::string get_file_contents(const char* filename)
 {
@@ -49,27 +50,32 @@ Shader::Shader (const char* vertexFile, const char* fragmentFile) {
 }
 
 void Shader::use() {
-    glUseProgram(ID);
+    CountedUseProgram(ID);
 }
 void Shader::del() {
     glDeleteProgram(ID);
 }
-void Shader::setBool(const std::string &name, bool value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+void Shader::setBool(const char *name, bool value) const {
+    RenderStats::Instance().Current().uniformUpdates++;
+    glUniform1i(glGetUniformLocation(ID, name), (int)value);
 }
 
-void Shader::setInt(const std::string &name, int value) const {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::setInt(const char *name, int value) const {
+    RenderStats::Instance().Current().uniformUpdates++;
+    glUniform1i(glGetUniformLocation(ID, name), value);
 }
 
-void Shader::setFloat(const std::string &name, float value) const {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+void Shader::setFloat(const char *name, float value) const {
+    RenderStats::Instance().Current().uniformUpdates++;
+    glUniform1f(glGetUniformLocation(ID, name), value);
 }
 
-void Shader::setMat4(const std::string &name, glm::mat4 value) const {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+void Shader::setMat4(const char *name, const glm::mat4 &value) const {
+    RenderStats::Instance().Current().uniformUpdates++;
+    glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, glm::value_ptr(value));
 }
 
-void Shader::setVec4(const std::string &name, float v1, float v2, float v3, float v4) const {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), v1, v2, v3, v4);
+void Shader::setVec4(const char *name, float v1, float v2, float v3, float v4) const {
+    RenderStats::Instance().Current().uniformUpdates++;
+    glUniform4f(glGetUniformLocation(ID, name), v1, v2, v3, v4);
 }
\ No newline at end of file
@@ -0,0 +1,283 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <stats_overlay.h>
+#include <render_stats.h>
+#include <gpu_profiler.h>
+#include <pipeline_statistics.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+// ASCII 32 (space) to 95 (underscore), 7 rows of 5 pixels each, the high bit is the leftmost pixel.
+// Lower case letters are drawn with the upper case glyphs
+static const unsigned char FONT_5X7[64][7] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // space
+        {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}, // !
+        {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00}, // "
+        {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}, // #
+        {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04}, // $
+        {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // %
+        {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D}, // &
+        {0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00}, // quote
+        {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // (
+        {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // )
+        {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}, // *
+        {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // +
+        {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}, // ,
+        {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // -
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // .
+        {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // /
+        {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // 0
+        {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 1
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // 2
+        {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // 3
+        {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // 4
+        {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // 5
+        {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // 6
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // 7
+        {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // 8
+        {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // 9
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, // :
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}, // ;
+        {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // <
+        {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // =
+        {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // >
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // ?
+        {0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E}, // @
+        {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // A
+        {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // B
+        {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // C
+        {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // D
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // E
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // F
+        {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // G
+        {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // H
+        {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // I
+        {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // J
+        {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // K
+        {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // L
+        {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // M
+        {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // N
+        {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // O
+        {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // P
+        {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // Q
+        {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // R
+        {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // S
+        {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // T
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // U
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // V
+        {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // W
+        {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // X
+        {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04}, // Y
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // Z
+        {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}, // [
+        {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00}, // backslash
+        {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, // ]
+        {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00}, // ^
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, // _
+
+};
+
+// the atlas: 16 x 5 cells of 6 x 8 pixels (a glyph and a pixel of spacing right and below). The 64 glyphs fill the
+// first four rows and cell 64, which is solid, is what the panel and the graph bars are drawn with
+const int CELL_WIDTH = 6, CELL_HEIGHT = 8;
+const int ATLAS_COLUMNS = 16, ATLAS_ROWS = 5;
+const int ATLAS_WIDTH = ATLAS_COLUMNS * CELL_WIDTH, ATLAS_HEIGHT = ATLAS_ROWS * CELL_HEIGHT;
+const int SOLID_CELL = 64;
+
+// screen pixels per font pixel
+const float TEXT_SCALE = 2.0f;
+// frame time at the top of the graph
+const float GRAPH_MAX_MS = 50.0f;
+const float GRAPH_HEIGHT = 64.0f;
+const int MAX_LINES = 24;
+
+void StatsOverlay::Create()
+{
+    std::vector<unsigned char> atlas(ATLAS_WIDTH * ATLAS_HEIGHT, 0);
+    for (int glyph = 0; glyph < 64; glyph++)
+    {
+        int cellX = (glyph % ATLAS_COLUMNS) * CELL_WIDTH, cellY = (glyph / ATLAS_COLUMNS) * CELL_HEIGHT;
+        for (int y = 0; y < 7; y++)
+            for (int x = 0; x < 5; x++)
+                if (FONT_5X7[glyph][y] & (0x10 >> x))
+                    atlas[(cellY + y) * ATLAS_WIDTH + cellX + x] = 255;
+    }
+    int solidX = (SOLID_CELL % ATLAS_COLUMNS) * CELL_WIDTH, solidY = (SOLID_CELL / ATLAS_COLUMNS) * CELL_HEIGHT;
+    for (int y = 0; y < CELL_HEIGHT; y++)
+        for (int x = 0; x < CELL_WIDTH; x++)
+            atlas[(solidY + y) * ATLAS_WIDTH + solidX + x] = 255;
+
+    glGenTextures(1, &fontTexture);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, ATLAS_HEIGHT, 0, GL_RED, GL_UNSIGNED_BYTE, atlas.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+
+    shader.reset(new Shader("../Resources/shader_hud.vert", "../Resources/shader_hud.frag"));
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glBindVertexArray(0);
+}
+
+void StatsOverlay::addQuad(float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, const glm::vec4 &colour)
+{
+    const float corners[6][4] = {
+            {x0, y0, u0, v0}, {x1, y0, u1, v0}, {x1, y1, u1, v1},
+            {x1, y1, u1, v1}, {x0, y1, u0, v1}, {x0, y0, u0, v0}
+    };
+    for (const auto &corner : corners)
+    {
+        vertices.insert(vertices.end(), corner, corner + 4);
+        vertices.push_back(colour.x);
+        vertices.push_back(colour.y);
+        vertices.push_back(colour.z);
+        vertices.push_back(colour.w);
+    }
+}
+
+void StatsOverlay::addSolid(float x0, float y0, float x1, float y1, const glm::vec4 &colour)
+{
+    // every corner samples the middle of the solid cell
+    float u = ((SOLID_CELL % ATLAS_COLUMNS) * CELL_WIDTH + CELL_WIDTH * 0.5f) / ATLAS_WIDTH;
+    float v = ((SOLID_CELL / ATLAS_COLUMNS) * CELL_HEIGHT + CELL_HEIGHT * 0.5f) / ATLAS_HEIGHT;
+    addQuad(x0, y0, x1, y1, u, v, u, v, colour);
+}
+
+void StatsOverlay::addText(float x, float y, const char *text, const glm::vec4 &colour)
+{
+    for (const char *c = text; *c; c++, x += CELL_WIDTH * TEXT_SCALE)
+    {
+        int glyph = std::toupper((unsigned char)*c) - 32;
+        if (glyph <= 0 || glyph >= 64)
+            continue;
+        float u0 = (float)((glyph % ATLAS_COLUMNS) * CELL_WIDTH) / ATLAS_WIDTH;
+        float v0 = (float)((glyph / ATLAS_COLUMNS) * CELL_HEIGHT) / ATLAS_HEIGHT;
+        addQuad(x, y, x + CELL_WIDTH * TEXT_SCALE, y + CELL_HEIGHT * TEXT_SCALE,
+                u0, v0, u0 + (float)CELL_WIDTH / ATLAS_WIDTH, v0 + (float)CELL_HEIGHT / ATLAS_HEIGHT, colour);
+    }
+}
+
+void StatsOverlay::Draw(int viewportWidth, int viewportHeight, const OverdrawView *overdraw)
+{
+    if (!shader || viewportWidth <= 0 || viewportHeight <= 0)
+        return;
+    const RenderStats &stats = RenderStats::Instance();
+    const RenderCounters &counters = stats.Last();
+    unsigned int frames = stats.FrameCount();
+    float lastMs = stats.LastFrameMs();
+
+    char lines[MAX_LINES][64];
+    int lineCount = 0;
+    std::snprintf(lines[lineCount++], 64, "frame    %6.2f ms %5.0f fps", lastMs, lastMs > 0.0f ? 1000.0f / lastMs : 0.0f);
+    const FrameHistogram &histogram = stats.Histogram();
+    std::snprintf(lines[lineCount++], 64, "p50 %.1f p95 %.1f p99 %.1f max %.1f", histogram.Percentile(0.5),
+                  histogram.Percentile(0.95), histogram.Percentile(0.99), histogram.Max());
+    // only measured in profiling builds
+    if (GpuProfiler::Instance().LastFrameMs() > 0.0)
+        std::snprintf(lines[lineCount++], 64, "gpu      %6.2f ms", GpuProfiler::Instance().LastFrameMs());
+    std::snprintf(lines[lineCount++], 64, "draws    %u", counters.drawCalls);
+    std::snprintf(lines[lineCount++], 64, "tris     %zu", counters.triangles);
+    std::snprintf(lines[lineCount++], 64, "verts    %zu", counters.vertices);
+    std::snprintf(lines[lineCount++], 64, "programs %u", counters.programSwitches);
+    std::snprintf(lines[lineCount++], 64, "textures %u", counters.textureBinds);
+    std::snprintf(lines[lineCount++], 64, "uploads  %.1f kb", counters.bufferUploadBytes / 1024.0);
+    std::snprintf(lines[lineCount++], 64, "uniforms %u", counters.uniformUpdates);
+    if (overdraw)
+        std::snprintf(lines[lineCount++], 64, "overdraw %.2f  covered %.2f  max %.0f", overdraw->MeanOverdraw(),
+                      overdraw->CoveredMeanOverdraw(), overdraw->MaxOverdraw());
+    // per pass: vertex shader invocations / vertices submitted, primitives out of / into clipping, fragment shader invocations
+    if (PipelineStatistics::Instance().Enabled())
+    {
+        for (const PassStatistics &pass : PipelineStatistics::Instance().LastFrame())
+        {
+            if (lineCount == MAX_LINES)
+                break;
+            std::snprintf(lines[lineCount++], 64, "%-8s vs %llu/%llu clip %llu/%llu fs %llu", pass.name,
+                          (unsigned long long)pass.vertexShaderInvocations, (unsigned long long)pass.verticesSubmitted,
+                          (unsigned long long)pass.clippingOutputPrimitives, (unsigned long long)pass.clippingInputPrimitives,
+                          (unsigned long long)pass.fragmentShaderInvocations);
+        }
+    }
+    size_t longest = 0;
+    for (int i = 0; i < lineCount; i++)
+        longest = std::max(longest, std::strlen(lines[i]));
+
+    const float margin = 8.0f, lineHeight = CELL_HEIGHT * TEXT_SCALE + 2.0f;
+    float panelWidth = std::max((float)RENDER_STATS_HISTORY, longest * CELL_WIDTH * TEXT_SCALE) + 2.0f * margin;
+    float graphTop = margin + lineCount * lineHeight + margin;
+    float panelHeight = graphTop + GRAPH_HEIGHT + margin;
+
+    vertices.clear();
+    addSolid(0.0f, 0.0f, panelWidth, panelHeight, glm::vec4(0.0f, 0.0f, 0.0f, 0.6f));
+    for (int i = 0; i < lineCount; i++)
+        addText(margin, margin + i * lineHeight, lines[i], glm::vec4(1.0f));
+
+    // a bar per frame, oldest on the left: green in time for 60 Hz, yellow for 30 Hz, red slower than that
+    float graphBottom = graphTop + GRAPH_HEIGHT;
+    for (unsigned int i = 0; i < frames; i++)
+    {
+        float ms = stats.FrameMs(i);
+        float height = std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        glm::vec4 colour = ms <= 1000.0f / 60.0f ? glm::vec4(0.2f, 0.9f, 0.2f, 1.0f) :
+                           ms <= 1000.0f / 30.0f ? glm::vec4(0.9f, 0.8f, 0.1f, 1.0f) : glm::vec4(0.9f, 0.2f, 0.2f, 1.0f);
+        float x = margin + (float)(RENDER_STATS_HISTORY - frames + i);
+        addSolid(x, graphBottom - height, x + 1.0f, graphBottom, colour);
+    }
+    // the 60 Hz line
+    float budgetY = graphBottom - (1000.0f / 60.0f) / GRAPH_MAX_MS * GRAPH_HEIGHT;
+    addSolid(margin, budgetY, margin + RENDER_STATS_HISTORY, budgetY + 1.0f, glm::vec4(1.0f, 1.0f, 1.0f, 0.5f));
+
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // straight glUseProgram, Shader::use would count it
+    glUseProgram(shader->ID);
+    glUniform2f(glGetUniformLocation(shader->ID, "viewport"), (float)viewportWidth, (float)viewportHeight);
+    glUniform1i(glGetUniformLocation(shader->ID, "font"), 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, fontTexture);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    // a new store every frame, so the driver doesn't have to wait for the last frame's draw to finish with the old one
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STREAM_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(vertices.size() / 8));
+    glBindVertexArray(0);
+
+    glDisable(GL_BLEND);
+    glEnable(GL_DEPTH_TEST);
+}
+
+void StatsOverlay::del()
+{
+    if (shader)
+        shader->del();
+    shader.reset();
+    if (fontTexture)
+        glDeleteTextures(1, &fontTexture);
+    if (VAO)
+        glDeleteVertexArrays(1, &VAO);
+    if (VBO)
+        glDeleteBuffers(1, &VBO);
+    fontTexture = VAO = VBO = 0;
+}
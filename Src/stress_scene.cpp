@@ -0,0 +1,273 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <stress_scene.h>
+#include <gpu_residency.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#include <process.h>
+#else
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// side of the generated textures, and of their checkers
+const int STRESS_TEXTURE_SIZE = 256;
+const int STRESS_CHECKER_SIZE = 32;
+
+bool ParseStressValues(const char *text, int minimum, std::vector<int> &values)
+{
+    values.clear();
+    const char *at = text;
+    for (;;)
+    {
+        char *end;
+        long value = std::strtol(at, &end, 10);
+        if (end == at || value < minimum || value > 1 << 24)
+            return false;
+        values.push_back((int)value);
+        if (*end == '\0')
+            return true;
+        if (*end != ',')
+            return false;
+        at = end + 1;
+    }
+}
+
+std::vector<StressSceneConfig> StressSweepConfigs(const std::vector<int> &gridDims, const std::vector<int> &blobs,
+                                                  const std::vector<int> &models, const std::vector<int> &textures)
+{
+    std::vector<StressSceneConfig> configs;
+    for (int gridDim : gridDims)
+        for (int blobCount : blobs)
+            for (int modelCount : models)
+                for (int textureCount : textures)
+                {
+                    StressSceneConfig config;
+                    config.gridDim = gridDim;
+                    config.blobs = blobCount;
+                    config.models = modelCount;
+                    config.textures = textureCount;
+                    configs.push_back(config);
+                }
+    return configs;
+}
+
+bool AppendStressCsv(const std::string &path, const StressSceneConfig &config, const StressSceneResult &result)
+{
+    bool empty;
+    {
+        std::ifstream existing(path, std::ios::binary | std::ios::ate);
+        empty = !existing || existing.tellg() <= 0;
+    }
+    std::ofstream file(path, std::ios::app);
+    if (!file)
+    {
+        std::cout << "Stress: can't write " << path << std::endl;
+        return false;
+    }
+    if (empty)
+        file << "grid_dim,blobs,models,textures,frames,cpu_ms,cpu_p99_ms,gpu_ms,frame_ms,draw_calls,triangles,gpu_mb,peak_rss_mb\n";
+    char row[512];
+    std::snprintf(row, sizeof(row), "%d,%d,%d,%d,%d,%.4f,%.4f,%.4f,%.4f,%u,%zu,%.2f,%.2f\n", config.gridDim, config.blobs,
+                  config.models, config.textures, result.frames, result.cpuMs, result.cpuP99Ms, result.gpuMs, result.frameMs,
+                  result.drawCalls, result.triangles, result.gpuBytes / (1024.0 * 1024.0),
+                  result.peakResidentBytes / (1024.0 * 1024.0));
+    file << row;
+    return (bool)file;
+}
+
+// runs the program command[0] with the arguments and waits for it, true if it exited with 0
+static bool runProcess(const std::vector<std::string> &command)
+{
+    std::cout.flush();
+#ifdef _WIN32
+    // the C runtime joins the arguments with spaces, so each is quoted the way it splits them again
+    std::vector<std::string> quoted;
+    for (const std::string &argument : command)
+    {
+        std::string text = "\"";
+        size_t backslashes = 0;
+        for (char c : argument)
+        {
+            if (c == '\\')
+            {
+                backslashes++;
+                continue;
+            }
+            // backslashes only escape when a quote follows
+            text.append(c == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+            backslashes = 0;
+            text += c;
+        }
+        text.append(backslashes * 2, '\\');
+        quoted.push_back(text + "\"");
+    }
+    std::vector<const char *> arguments;
+    for (const std::string &argument : quoted)
+        arguments.push_back(argument.c_str());
+    arguments.push_back(nullptr);
+    return _spawnvp(_P_WAIT, command[0].c_str(), arguments.data()) == 0;
+#else
+    std::vector<char *> arguments;
+    for (const std::string &argument : command)
+        arguments.push_back(const_cast<char *>(argument.c_str()));
+    arguments.push_back(nullptr);
+    pid_t child = fork();
+    if (child < 0)
+        return false;
+    if (child == 0)
+    {
+        execvp(arguments[0], arguments.data());
+        std::perror("Stress: can't run the configuration");
+        _exit(127);
+    }
+    int status = 0;
+    while (waitpid(child, &status, 0) < 0)
+    {
+        if (errno != EINTR)
+            return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+int RunStressSweep(const std::vector<std::string> &command, const std::vector<StressSceneConfig> &configs,
+                   const std::string &csvPath)
+{
+    // every run appends, so start from nothing
+    std::remove(csvPath.c_str());
+    int failed = 0;
+    for (size_t i = 0; i < configs.size(); i++)
+    {
+        const StressSceneConfig &config = configs[i];
+        char sizes[128];
+        std::snprintf(sizes, sizeof(sizes), " --grid %d --blobs %d --models %d --textures %d", config.gridDim,
+                      config.blobs, config.models, config.textures);
+        std::vector<std::string> run = command;
+        const std::string values[] = {"--grid", std::to_string(config.gridDim), "--blobs", std::to_string(config.blobs),
+                                      "--models", std::to_string(config.models), "--textures", std::to_string(config.textures),
+                                      "--csv", csvPath};
+        run.insert(run.end(), std::begin(values), std::end(values));
+        std::cout << "Stress: [" << i + 1 << "/" << configs.size() << "]" << sizes << std::endl;
+        if (!runProcess(run))
+        {
+            std::cout << "Stress: run failed:" << sizes << std::endl;
+            failed++;
+        }
+    }
+    std::cout << "Stress: " << configs.size() - failed << " of " << configs.size() << " configurations written to "
+              << csvPath << std::endl;
+    return failed;
+}
+
+size_t PeakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    // bytes on macOS, kilobytes everywhere else
+    return (size_t)usage.ru_maxrss;
+#else
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+// fills the bound texture with a checkerboard of the index's colour and white, and its mip chain
+static void fillChecker(unsigned int textureID, int index)
+{
+    // a hue per texture, so it's visible which blob has which
+    float hue = std::fmod((float)index * 0.618034f, 1.0f) * 6.0f;
+    float r = glm::clamp(std::fabs(hue - 3.0f) - 1.0f, 0.0f, 1.0f);
+    float g = glm::clamp(2.0f - std::fabs(hue - 2.0f), 0.0f, 1.0f);
+    float b = glm::clamp(2.0f - std::fabs(hue - 4.0f), 0.0f, 1.0f);
+
+    std::vector<unsigned char> pixels((size_t)STRESS_TEXTURE_SIZE * STRESS_TEXTURE_SIZE * 4);
+    for (int y = 0; y < STRESS_TEXTURE_SIZE; y++)
+    {
+        for (int x = 0; x < STRESS_TEXTURE_SIZE; x++)
+        {
+            bool white = ((x / STRESS_CHECKER_SIZE) + (y / STRESS_CHECKER_SIZE)) % 2 == 0;
+            unsigned char *pixel = &pixels[((size_t)y * STRESS_TEXTURE_SIZE + x) * 4];
+            pixel[0] = white ? 255 : (unsigned char)(r * 255.0f);
+            pixel[1] = white ? 255 : (unsigned char)(g * 255.0f);
+            pixel[2] = white ? 255 : (unsigned char)(b * 255.0f);
+            pixel[3] = 255;
+        }
+    }
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, STRESS_TEXTURE_SIZE, STRESS_TEXTURE_SIZE, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glGenerateMipmap(GL_TEXTURE_2D);
+}
+
+void StressScene::Create(const StressSceneConfig &config, unsigned int texture)
+{
+    this->config = config;
+    side = std::max(1, (int)std::ceil(std::sqrt((double)config.blobs)));
+
+    textures.clear();
+    textures.push_back(texture);
+    for (int i = 1; i < config.textures; i++)
+    {
+        unsigned int id;
+        glGenTextures(1, &id);
+        fillChecker(id, i);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        GpuResidency::Instance().Track(GPU_TEXTURE, id, TextureBytes(id),
+                                       [id]() { EvictTexture(id); },
+                                       [id, i]() { fillChecker(id, i); return true; });
+        textures.push_back(id);
+    }
+}
+
+glm::vec3 StressScene::BlobOffset(int i) const
+{
+    // the blob is 1 wide, so 2 apart leaves a gap between them
+    float half = 0.5f * (float)(side - 1);
+    return glm::vec3(2.0f * ((float)(i % side) - half), 0.0f, 2.0f * ((float)(i / side) - half));
+}
+
+glm::mat4 StressScene::ModelTransform(int i) const
+{
+    float x = 2.5f * ((float)i - 0.5f * (float)(config.models - 1));
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.5f, -4.0f));
+    return glm::scale(model, glm::vec3(0.5f));
+}
+
+void StressScene::del()
+{
+    for (size_t i = 1; i < textures.size(); i++)
+    {
+        GpuResidency::Instance().Untrack(GPU_TEXTURE, textures[i]);
+        glDeleteTextures(1, &textures[i]);
+    }
+    textures.clear();
+}
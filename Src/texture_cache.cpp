@@ -0,0 +1,140 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <texture_cache.h>
+#include <model.h>
+#include <texture_streamer.h>
+#include <gpu_residency.h>
+#include <texture_quality.h>
+
+#include <cstdlib>
+#include <climits>
+#include <vector>
+
+#ifdef _WIN32
+#include <cctype>
+#endif
+
+// lexically removes "." and "x/.." components, used when the file system can't resolve the path for us
+static std::string normalizePath(const std::string &path)
+{
+    bool absolute = !path.empty() && path[0] == '/';
+    std::vector<std::string> parts;
+    size_t start = 0;
+    while (start <= path.size())
+    {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos)
+            end = path.size();
+        std::string part = path.substr(start, end - start);
+        if (part == "..")
+        {
+            if (!parts.empty() && parts.back() != "..")
+                parts.pop_back();
+            else if (!absolute)
+                parts.push_back(part);
+        }
+        else if (!part.empty() && part != ".")
+            parts.push_back(part);
+        start = end + 1;
+    }
+
+    std::string result = absolute ? "/" : "";
+    for (size_t i = 0; i < parts.size(); i++)
+    {
+        if (i > 0)
+            result += '/';
+        result += parts[i];
+    }
+    return result;
+}
+
+std::string CanonicalTexturePath(const char *path, const std::string &directory)
+{
+    std::string filename = directory + '/' + std::string(path);
+    for (char &c : filename)
+        if (c == '\\')
+            c = '/';
+
+#ifdef _WIN32
+    char resolved[_MAX_PATH];
+    if (_fullpath(resolved, filename.c_str(), _MAX_PATH))
+        filename = resolved;
+    for (char &c : filename)
+    {
+        // windows paths are case insensitive, so fold them to avoid duplicate entries
+        c = c == '\\' ? '/' : (char)tolower((unsigned char)c);
+    }
+    return normalizePath(filename);
+#else
+    char resolved[PATH_MAX];
+    if (realpath(filename.c_str(), resolved))
+        return std::string(resolved);
+    return normalizePath(filename);
+#endif
+}
+
+TextureCache &TextureCache::Instance()
+{
+    static TextureCache cache;
+    return cache;
+}
+
+unsigned int TextureCache::Acquire(const char *path, const std::string &directory, bool gamma, int channels, const std::string &type)
+{
+    std::string key = CanonicalTexturePath(path, directory);
+    key += gamma ? "|srgb|" : "|linear|";
+    key += std::to_string(channels);
+    // a normal map kept sharper than the diffuse map using the same file is a different texture
+    key += "|" + TextureQualitySettings::Instance().For(directory + '/' + path, type).Name();
+
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        it->second.refCount++;
+        return it->second.id;
+    }
+
+    Entry entry;
+    entry.id = TextureFromFile(path, directory, gamma, channels, type);
+    entry.refCount = 1;
+    entries.emplace(key, entry);
+    keys.emplace(entry.id, key);
+    return entry.id;
+}
+
+void TextureCache::Retain(unsigned int id)
+{
+    auto key = keys.find(id);
+    if (key != keys.end())
+        entries[key->second].refCount++;
+}
+
+void TextureCache::Release(unsigned int id)
+{
+    auto key = keys.find(id);
+    if (key == keys.end())
+    {
+        std::cout << "TextureCache: release of unknown texture " << id << std::endl;
+        return;
+    }
+
+    auto it = entries.find(key->second);
+    if (--it->second.refCount == 0)
+    {
+        TextureStreamer::Instance().Unregister(id);
+        GpuResidency::Instance().Untrack(GPU_TEXTURE, id);
+        glDeleteTextures(1, &id);
+        entries.erase(it);
+        keys.erase(key);
+    }
+}
+
+unsigned int TextureCache::RefCount(unsigned int id) const
+{
+    auto key = keys.find(id);
+    if (key == keys.end())
+        return 0;
+    return entries.at(key->second).refCount;
+}
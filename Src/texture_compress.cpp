@@ -0,0 +1,437 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <texture_compress.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_COMPRESS_SSE2
+#include <emmintrin.h>
+#endif
+
+// a 4x4 block stored channel by channel (structure of arrays), which is what the SIMD loops want
+struct BcBlock {
+    float c[4][16];
+};
+
+GLenum BcInternalFormat(BcFormat format, bool srgb)
+{
+    switch (format)
+    {
+        case BC1: return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case BC3: return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case BC4: return GL_COMPRESSED_RED_RGTC1;
+        case BC5: return GL_COMPRESSED_RG_RGTC2;
+        case BC7: return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+    }
+    return 0;
+}
+
+unsigned int BcBlockBytes(BcFormat format)
+{
+    return (format == BC1 || format == BC4) ? 8 : 16;
+}
+
+unsigned int BcImageBytes(BcFormat format, int width, int height)
+{
+    return ((width + 3) / 4) * ((height + 3) / 4) * BcBlockBytes(format);
+}
+
+bool IsCompressedFormatSupported(GLenum internalFormat)
+{
+    // RGTC is core since GL 3.0, but drivers aren't required to list it in GL_COMPRESSED_TEXTURE_FORMATS
+    if (internalFormat == GL_COMPRESSED_RED_RGTC1 || internalFormat == GL_COMPRESSED_RG_RGTC2)
+        return true;
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    std::vector<GLint> formats(count > 0 ? count : 0);
+    if (count > 0)
+        glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, &formats[0]);
+    return std::find(formats.begin(), formats.end(), (GLint)internalFormat) != formats.end();
+}
+
+// picks for every pixel the closest of `steps` evenly spaced points on the segment e0 -> e1 (0 is e0, steps - 1 is e1)
+static void projectSteps(const BcBlock &block, int channels, const float *e0, const float *e1, int steps, int *out)
+{
+    float dir[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float len2 = 0.0f;
+    for (int c = 0; c < channels; c++)
+    {
+        dir[c] = e1[c] - e0[c];
+        len2 += dir[c] * dir[c];
+    }
+    if (len2 < 1e-6f)
+    {
+        std::fill(out, out + 16, 0);
+        return;
+    }
+    float scale = (float)(steps - 1) / len2;
+    float base = 0.0f;
+    for (int c = 0; c < channels; c++)
+    {
+        dir[c] *= scale;
+        base += e0[c] * dir[c];
+    }
+
+#ifdef TEXTURE_COMPRESS_SSE2
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 last = _mm_set1_ps((float)(steps - 1));
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (int i = 0; i < 16; i += 4)
+    {
+        __m128 t = _mm_set1_ps(-base);
+        for (int c = 0; c < channels; c++)
+            t = _mm_add_ps(t, _mm_mul_ps(_mm_loadu_ps(&block.c[c][i]), _mm_set1_ps(dir[c])));
+        t = _mm_min_ps(_mm_max_ps(_mm_add_ps(t, half), zero), last);
+        _mm_storeu_si128((__m128i *)(out + i), _mm_cvttps_epi32(t));
+    }
+#else
+    for (int i = 0; i < 16; i++)
+    {
+        float t = -base;
+        for (int c = 0; c < channels; c++)
+            t += block.c[c][i] * dir[c];
+        t = std::min(std::max(t + 0.5f, 0.0f), (float)(steps - 1));
+        out[i] = (int)t;
+    }
+#endif
+}
+
+// finds the endpoints of the segment that best covers the block: principal axis through the mean, clipped to the
+// pixels' extent along it
+static void principalEndpoints(const BcBlock &block, int channels, float *e0, float *e1)
+{
+    float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int c = 0; c < channels; c++)
+    {
+        for (int i = 0; i < 16; i++)
+            mean[c] += block.c[c][i];
+        mean[c] /= 16.0f;
+    }
+
+    float cov[4][4] = {};
+    for (int i = 0; i < 16; i++)
+        for (int a = 0; a < channels; a++)
+            for (int b = a; b < channels; b++)
+                cov[a][b] += (block.c[a][i] - mean[a]) * (block.c[b][i] - mean[b]);
+    for (int a = 0; a < channels; a++)
+        for (int b = 0; b < a; b++)
+            cov[a][b] = cov[b][a];
+
+    // power iteration, seeded with the diagonal so a flat block still gets a sensible axis
+    float axis[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    for (int c = 0; c < channels; c++)
+        axis[c] = cov[c][c] + 1e-3f;
+    for (int iteration = 0; iteration < 8; iteration++)
+    {
+        float next[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        float norm = 0.0f;
+        for (int a = 0; a < channels; a++)
+        {
+            for (int b = 0; b < channels; b++)
+                next[a] += cov[a][b] * axis[b];
+            norm = std::max(norm, std::fabs(next[a]));
+        }
+        if (norm < 1e-6f)
+            break;
+        for (int c = 0; c < channels; c++)
+            axis[c] = next[c] / norm;
+    }
+    float len = 0.0f;
+    for (int c = 0; c < channels; c++)
+        len += axis[c] * axis[c];
+    len = std::sqrt(len);
+    for (int c = 0; c < channels; c++)
+        axis[c] /= len;
+
+    float lo = 1e30f, hi = -1e30f;
+    for (int i = 0; i < 16; i++)
+    {
+        float t = 0.0f;
+        for (int c = 0; c < channels; c++)
+            t += (block.c[c][i] - mean[c]) * axis[c];
+        lo = std::min(lo, t);
+        hi = std::max(hi, t);
+    }
+    for (int c = 0; c < channels; c++)
+    {
+        e0[c] = std::min(std::max(mean[c] + axis[c] * lo, 0.0f), 255.0f);
+        e1[c] = std::min(std::max(mean[c] + axis[c] * hi, 0.0f), 255.0f);
+    }
+}
+
+// least squares fit of the endpoints for a fixed assignment of pixels to steps. Leaves the endpoints untouched if
+// every pixel sits on the same step.
+static void refineEndpoints(const BcBlock &block, int channels, const int *stepIndices, int steps, float *e0, float *e1)
+{
+    float aa = 0.0f, bb = 0.0f, ab = 0.0f;
+    float ax[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float bx[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 16; i++)
+    {
+        float w = (float)stepIndices[i] / (float)(steps - 1);
+        aa += (1.0f - w) * (1.0f - w);
+        bb += w * w;
+        ab += (1.0f - w) * w;
+        for (int c = 0; c < channels; c++)
+        {
+            ax[c] += (1.0f - w) * block.c[c][i];
+            bx[c] += w * block.c[c][i];
+        }
+    }
+    float det = aa * bb - ab * ab;
+    if (std::fabs(det) < 1e-6f)
+        return;
+    for (int c = 0; c < channels; c++)
+    {
+        e0[c] = std::min(std::max((ax[c] * bb - bx[c] * ab) / det, 0.0f), 255.0f);
+        e1[c] = std::min(std::max((bx[c] * aa - ax[c] * ab) / det, 0.0f), 255.0f);
+    }
+}
+
+static unsigned short packRgb565(const float *color)
+{
+    int r = (int)(color[0] * 31.0f / 255.0f + 0.5f);
+    int g = (int)(color[1] * 63.0f / 255.0f + 0.5f);
+    int b = (int)(color[2] * 31.0f / 255.0f + 0.5f);
+    return (unsigned short)((r << 11) | (g << 5) | b);
+}
+
+static void unpackRgb565(unsigned short packed, float *color)
+{
+    int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+    color[0] = (float)((r << 3) | (r >> 2));
+    color[1] = (float)((g << 2) | (g >> 4));
+    color[2] = (float)((b << 3) | (b >> 2));
+}
+
+// BC1 colour block, always in 4 colour mode so it can be reused by BC3
+static void encodeBc1(const BcBlock &block, unsigned char *out)
+{
+    float e0[4], e1[4];
+    int steps[16];
+    principalEndpoints(block, 3, e0, e1);
+    projectSteps(block, 3, e0, e1, 4, steps);
+    refineEndpoints(block, 3, steps, 4, e0, e1);
+
+    unsigned short c0 = packRgb565(e0), c1 = packRgb565(e1);
+    if (c0 < c1)
+        std::swap(c0, c1);
+
+    unsigned int bits = 0;
+    if (c0 != c1)
+    {
+        // index the pixels against what the decoder will actually see
+        float q0[3], q1[3];
+        unpackRgb565(c0, q0);
+        unpackRgb565(c1, q1);
+        projectSteps(block, 3, q0, q1, 4, steps);
+        static const unsigned int codes[4] = {0, 2, 3, 1};
+        for (int i = 0; i < 16; i++)
+            bits |= codes[steps[i]] << (2 * i);
+    }
+
+    out[0] = (unsigned char)(c0 & 0xff);
+    out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xff);
+    out[3] = (unsigned char)(c1 >> 8);
+    for (int i = 0; i < 4; i++)
+        out[4 + i] = (unsigned char)(bits >> (8 * i));
+}
+
+// BC4 single channel block (also the alpha half of BC3 and each half of BC5), in 8 value mode
+static void encodeBc4(const BcBlock &block, int channel, unsigned char *out)
+{
+    float lo = 255.0f, hi = 0.0f;
+    for (int i = 0; i < 16; i++)
+    {
+        lo = std::min(lo, block.c[channel][i]);
+        hi = std::max(hi, block.c[channel][i]);
+    }
+    unsigned char a0 = (unsigned char)(hi + 0.5f), a1 = (unsigned char)(lo + 0.5f);
+
+    unsigned long long bits = 0;
+    if (a0 != a1)
+    {
+        BcBlock single;
+        std::memcpy(single.c[0], block.c[channel], sizeof(single.c[0]));
+        float e0 = (float)a1, e1 = (float)a0;
+        int steps[16];
+        projectSteps(single, 1, &e0, &e1, 8, steps);
+        for (int i = 0; i < 16; i++)
+        {
+            // step 7 is a0 (code 0), step 0 is a1 (code 1), the rest are interpolated from a0 towards a1
+            unsigned long long code = steps[i] == 7 ? 0 : steps[i] == 0 ? 1 : 8 - steps[i];
+            bits |= code << (3 * i);
+        }
+    }
+
+    out[0] = a0;
+    out[1] = a1;
+    for (int i = 0; i < 6; i++)
+        out[2 + i] = (unsigned char)(bits >> (8 * i));
+}
+
+// little endian bit stream used to assemble BC7 blocks
+struct BitWriter {
+    unsigned char *out;
+    int pos;
+
+    void put(unsigned int value, int count)
+    {
+        for (int i = 0; i < count; i++, pos++)
+            if (value & (1u << i))
+                out[pos >> 3] |= (unsigned char)(1u << (pos & 7));
+    }
+};
+
+// quantizes an 8 bit RGBA endpoint to 7 bits per channel plus a shared p-bit
+static void quantizeBc7Endpoint(const float *endpoint, unsigned int *q, unsigned int &pbit)
+{
+    float bestError = 1e30f;
+    for (unsigned int p = 0; p < 2; p++)
+    {
+        unsigned int candidate[4];
+        float error = 0.0f;
+        for (int c = 0; c < 4; c++)
+        {
+            int v = (int)std::floor((endpoint[c] - (float)p) / 2.0f + 0.5f);
+            candidate[c] = (unsigned int)std::min(std::max(v, 0), 127);
+            float d = (float)((candidate[c] << 1) | p) - endpoint[c];
+            error += d * d;
+        }
+        if (error < bestError)
+        {
+            bestError = error;
+            pbit = p;
+            std::memcpy(q, candidate, sizeof(candidate));
+        }
+    }
+}
+
+// BC7 mode 6: one subset, 7.7.7.7 endpoints with p-bits and 4 bit indices. Handles opaque and alpha content alike.
+static void encodeBc7(const BcBlock &block, unsigned char *out)
+{
+    float e0[4], e1[4];
+    int steps[16];
+    principalEndpoints(block, 4, e0, e1);
+    projectSteps(block, 4, e0, e1, 16, steps);
+    refineEndpoints(block, 4, steps, 16, e0, e1);
+
+    unsigned int q0[4], q1[4], p0 = 0, p1 = 0;
+    quantizeBc7Endpoint(e0, q0, p0);
+    quantizeBc7Endpoint(e1, q1, p1);
+    float d0[4], d1[4];
+    for (int c = 0; c < 4; c++)
+    {
+        d0[c] = (float)((q0[c] << 1) | p0);
+        d1[c] = (float)((q1[c] << 1) | p1);
+    }
+    projectSteps(block, 4, d0, d1, 16, steps);
+
+    // the first pixel's index is stored without its top bit, so it has to be in the lower half
+    if (steps[0] >= 8)
+    {
+        std::swap(q0, q1);
+        std::swap(p0, p1);
+        for (int i = 0; i < 16; i++)
+            steps[i] = 15 - steps[i];
+    }
+
+    std::memset(out, 0, 16);
+    BitWriter writer = {out, 0};
+    writer.put(1u << 6, 7);
+    for (int c = 0; c < 4; c++)
+    {
+        writer.put(q0[c], 7);
+        writer.put(q1[c], 7);
+    }
+    writer.put(p0, 1);
+    writer.put(p1, 1);
+    writer.put((unsigned int)steps[0], 3);
+    for (int i = 1; i < 16; i++)
+        writer.put((unsigned int)steps[i], 4);
+}
+
+// gathers the 4x4 block at (bx, by), repeating the last row/column for blocks hanging over the edge
+static void fetchBlock(const unsigned char *rgba, int width, int height, int bx, int by, BcBlock &block)
+{
+    for (int y = 0; y < 4; y++)
+    {
+        int sy = std::min(by * 4 + y, height - 1);
+        for (int x = 0; x < 4; x++)
+        {
+            int sx = std::min(bx * 4 + x, width - 1);
+            const unsigned char *pixel = rgba + ((size_t)sy * width + sx) * 4;
+            for (int c = 0; c < 4; c++)
+                block.c[c][y * 4 + x] = (float)pixel[c];
+        }
+    }
+}
+
+static void encodeBlock(const BcBlock &block, BcFormat format, unsigned char *out)
+{
+    switch (format)
+    {
+        case BC1:
+            encodeBc1(block, out);
+            break;
+        case BC3:
+            encodeBc4(block, 3, out);
+            encodeBc1(block, out + 8);
+            break;
+        case BC4:
+            encodeBc4(block, 0, out);
+            break;
+        case BC5:
+            encodeBc4(block, 0, out);
+            encodeBc4(block, 1, out + 8);
+            break;
+        case BC7:
+            encodeBc7(block, out);
+            break;
+    }
+}
+
+std::vector<unsigned char> CompressBc(const unsigned char *rgba, int width, int height, BcFormat format, int threads)
+{
+    int blocksX = (width + 3) / 4;
+    int blocksY = (height + 3) / 4;
+    unsigned int blockBytes = BcBlockBytes(format);
+    std::vector<unsigned char> blocks((size_t)blocksX * blocksY * blockBytes);
+
+    auto encodeRows = [&](int firstRow, int lastRow) {
+        BcBlock block;
+        for (int by = firstRow; by < lastRow; by++)
+            for (int bx = 0; bx < blocksX; bx++)
+            {
+                fetchBlock(rgba, width, height, bx, by, block);
+                encodeBlock(block, format, &blocks[((size_t)by * blocksX + bx) * blockBytes]);
+            }
+    };
+
+    if (threads <= 0)
+        threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, blocksY);
+    if (threads <= 1)
+    {
+        encodeRows(0, blocksY);
+        return blocks;
+    }
+
+    // every worker gets a contiguous band of block rows, the calling thread takes the last one
+    std::vector<std::thread> workers;
+    int rowsPerThread = (blocksY + threads - 1) / threads;
+    for (int t = 0; t < threads - 1; t++)
+        workers.emplace_back(encodeRows, t * rowsPerThread, std::min((t + 1) * rowsPerThread, blocksY));
+    encodeRows(std::min((threads - 1) * rowsPerThread, blocksY), blocksY);
+    for (auto &worker : workers)
+        worker.join();
+    return blocks;
+}
@@ -0,0 +1,73 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <texture_cooker.h>
+#include <image_decode.h>
+#include <ktx.h>
+#include <mipmap.h>
+#include <stb_image.h>
+
+#include <iostream>
+#include <vector>
+
+BcFormat CookFormatFor(TextureUsage usage, bool hasAlpha, bool highQuality)
+{
+    switch (usage)
+    {
+        case TEXTURE_NORMAL:
+            return BC5;
+        case TEXTURE_AO:
+            return BC4;
+        case TEXTURE_SPECULAR:
+            return hasAlpha ? BC3 : BC1;
+        case TEXTURE_DIFFUSE:
+        default:
+            if (highQuality)
+                return BC7;
+            return hasAlpha ? BC3 : BC1;
+    }
+}
+
+bool CookTexture(const std::string &source, const std::string &destination, TextureUsage usage, const CookOptions &options)
+{
+    int width, height, nrComponents;
+    unsigned char *data = DecodeImageFile(source, &width, &height, &nrComponents, 4);
+    if (!data)
+    {
+        std::cout << "Cooker: texture failed to load at path: " << source << std::endl;
+        return false;
+    }
+    // single channel images are expanded to grey, so their (absent) alpha reads as opaque
+    bool hasAlpha = nrComponents == 2 || nrComponents == 4;
+    BcFormat format = CookFormatFor(usage, hasAlpha, options.highQuality);
+
+    KtxImage image;
+    image.glInternalFormat = BcInternalFormat(format, options.srgb && usage == TEXTURE_DIFFUSE);
+    image.glBaseInternalFormat = format == BC4 ? GL_RED : format == BC5 ? GL_RG : format == BC1 ? GL_RGB : GL_RGBA;
+    image.width = width;
+    image.height = height;
+
+    // sRGB diffuse maps are filtered in linear space, like TextureFromFile does for uncompressed textures
+    std::vector<std::vector<unsigned char>> chain = BuildMipChainRgba(data, width, height, options.srgb && usage == TEXTURE_DIFFUSE,
+                                                                      MIP_FILTER_KAISER, options.threads);
+    stbi_image_free(data);
+    for (size_t i = 0; i < chain.size(); i++)
+        image.levels.push_back(CompressBc(chain[i].data(), KtxLevelWidth(image, (int)i), KtxLevelHeight(image, (int)i), format, options.threads));
+
+    return WriteKtx(destination, image);
+}
+
+bool RestartJpeg(const std::string &source, const std::string &destination, const JpegEncodeOptions &options)
+{
+    int width, height, nrComponents;
+    unsigned char *data = DecodeImageFile(source, &width, &height, &nrComponents, 0);
+    if (!data)
+    {
+        std::cout << "Cooker: texture failed to load at path: " << source << std::endl;
+        return false;
+    }
+    bool written = WriteJpeg(destination, data, width, height, nrComponents, options);
+    stbi_image_free(data);
+    return written;
+}
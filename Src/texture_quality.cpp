@@ -0,0 +1,138 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <texture_quality.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+int TextureQuality::FirstLevel(int width, int height, int levels) const
+{
+    int first = std::max(0, skipLevels);
+    if (maxDimension > 0)
+    {
+        // the longer side decides: a 1xN strip keeps halving its height after its width reached 1
+        while (std::max(width >> first, height >> first) > maxDimension && std::max(width >> first, height >> first) > 1)
+            first++;
+    }
+    return std::min(first, std::max(0, levels - 1));
+}
+
+std::string TextureQuality::Name() const
+{
+    static const char *tiers[] = {"full", "half", "quarter", "eighth"};
+    std::string name = skipLevels >= 0 && skipLevels < 4 ? tiers[skipLevels] : "skip" + std::to_string(skipLevels);
+    if (maxDimension > 0)
+        name += "/" + std::to_string(maxDimension);
+    return name;
+}
+
+static bool parseTier(const std::string &text, int &skipLevels)
+{
+    static const char *tiers[] = {"full", "half", "quarter", "eighth"};
+    for (int i = 0; i < 4; i++)
+    {
+        if (text == tiers[i])
+        {
+            skipLevels = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseDimension(const std::string &text, int &maxDimension)
+{
+    char *end = nullptr;
+    long value = std::strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || value <= 0)
+        return false;
+    maxDimension = (int)value;
+    return true;
+}
+
+bool ParseTextureQuality(const std::string &text, TextureQuality &quality)
+{
+    TextureQuality parsed;
+    size_t slash = text.find('/');
+    if (slash != std::string::npos)
+    {
+        if (!parseTier(text.substr(0, slash), parsed.skipLevels) || !parseDimension(text.substr(slash + 1), parsed.maxDimension))
+            return false;
+    }
+    else if (!parseTier(text, parsed.skipLevels) && !parseDimension(text, parsed.maxDimension))
+        return false;
+    quality = parsed;
+    return true;
+}
+
+TextureQualitySettings &TextureQualitySettings::Instance()
+{
+    static TextureQualitySettings settings;
+    return settings;
+}
+
+void TextureQualitySettings::SetTypeOverride(const std::string &type, const TextureQuality &quality)
+{
+    typeOverrides.push_back(std::make_pair(type, quality));
+}
+
+void TextureQualitySettings::SetPathOverride(const std::string &pattern, const TextureQuality &quality)
+{
+    pathOverrides.push_back(std::make_pair(pattern, quality));
+}
+
+void TextureQualitySettings::ClearOverrides()
+{
+    typeOverrides.clear();
+    pathOverrides.clear();
+}
+
+bool TextureQualitySettings::LoadOverrides(const std::string &filename)
+{
+    std::ifstream in(filename);
+    if (!in)
+        return false;
+
+    std::string line;
+    int number = 0;
+    while (std::getline(in, line))
+    {
+        number++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string pattern, text;
+        if (!(fields >> pattern))
+            continue;
+        TextureQuality quality;
+        if (!(fields >> text) || !ParseTextureQuality(text, quality))
+        {
+            std::cout << "Texture quality: " << filename << ":" << number << ": expected \"<type or path> <quality>\"" << std::endl;
+            continue;
+        }
+        if (pattern.compare(0, 8, "texture_") == 0)
+            SetTypeOverride(pattern, quality);
+        else
+            SetPathOverride(pattern, quality);
+    }
+    return true;
+}
+
+TextureQuality TextureQualitySettings::For(const std::string &path, const std::string &type) const
+{
+    for (auto it = pathOverrides.rbegin(); it != pathOverrides.rend(); ++it)
+    {
+        if (path.find(it->first) != std::string::npos)
+            return it->second;
+    }
+    for (auto it = typeOverrides.rbegin(); it != typeOverrides.rend(); ++it)
+    {
+        if (!type.empty() && type == it->first)
+            return it->second;
+    }
+    return defaultQuality;
+}
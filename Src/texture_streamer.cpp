@@ -0,0 +1,229 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <texture_streamer.h>
+#include <texture_compress.h>
+#include <gpu_residency.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+float ProjectedSize(const glm::vec3 &center, float radius, const glm::vec3 &cameraPosition, float fovY, int viewportHeight)
+{
+    float distance = std::max(glm::length(center - cameraPosition) - radius, 0.01f);
+    return radius / (distance * std::tan(glm::radians(fovY) * 0.5f)) * (float)viewportHeight;
+}
+
+TextureStreamer &TextureStreamer::Instance()
+{
+    static TextureStreamer streamer;
+    return streamer;
+}
+
+bool TextureStreamer::Register(unsigned int textureID, const std::string &ktxPath, const TextureQuality &quality, bool srgb)
+{
+    StreamedTexture texture;
+    if (!ReadKtxLayout(ktxPath, texture.layout, texture.ranges) || !MatchKtxColorSpace(texture.layout, srgb))
+        return false;
+    if (texture.layout.compressed() && !IsCompressedFormatSupported(texture.layout.glInternalFormat))
+        return false;
+
+    int last = (int)texture.ranges.size() - 1;
+    texture.path = ktxPath;
+    texture.finestLevel = quality.FirstLevel(texture.layout.width, texture.layout.height, last + 1);
+    texture.initialLevel = texture.finestLevel;
+    while (texture.initialLevel < last &&
+           std::max(KtxLevelWidth(texture.layout, texture.initialLevel), KtxLevelHeight(texture.layout, texture.initialLevel)) > STREAM_INITIAL_SIZE)
+        texture.initialLevel++;
+    texture.residentLevel = last + 1;
+    texture.wantedLevel = texture.initialLevel;
+    texture.lastRequested = frame;
+
+    // every initial level is read before GL or the byte count is touched, so a file that fails halfway leaves
+    // both as they were
+    std::vector<std::vector<unsigned char>> initialLevels(last + 1 - texture.initialLevel);
+    for (int level = texture.initialLevel; level <= last; level++)
+    {
+        if (!readLevel(texture, level, initialLevels[level - texture.initialLevel]))
+            return false;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, last);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // smallest first, so the texture is complete (and drawable) as early as possible
+    while (texture.residentLevel > texture.initialLevel)
+        uploadLevel(textureID, texture, initialLevels[texture.residentLevel - 1 - texture.initialLevel]);
+    textures[textureID] = texture;
+
+    // counted against the residency budget, but pinned: the streamer evicts its levels itself
+    GpuResidency::Instance().Track(GPU_TEXTURE, textureID, 0);
+    residencyResize(textureID, texture);
+    return true;
+}
+
+void TextureStreamer::Unregister(unsigned int textureID)
+{
+    auto it = textures.find(textureID);
+    if (it == textures.end())
+        return;
+    for (int level = it->second.residentLevel; level < (int)it->second.ranges.size(); level++)
+        residentBytes -= it->second.ranges[level].size;
+    textures.erase(it);
+    GpuResidency::Instance().Untrack(GPU_TEXTURE, textureID);
+}
+
+void TextureStreamer::RequestScreenSize(unsigned int textureID, float pixels)
+{
+    auto it = textures.find(textureID);
+    if (it == textures.end())
+        return;
+    StreamedTexture &texture = it->second;
+
+    // one texel per pixel: every halving of the on-screen size drops one level
+    int size = std::max(texture.layout.width, texture.layout.height);
+    int level = pixels <= 1.0f ? (int)texture.ranges.size() - 1 : (int)std::floor(std::log2((float)size / pixels));
+    level = std::max(texture.finestLevel, std::min(level, texture.initialLevel));
+    // the first request of a frame replaces last frame's wish, later ones (other meshes) can only ask for more
+    texture.wantedLevel = texture.lastRequested == frame ? std::min(texture.wantedLevel, level) : level;
+    texture.lastRequested = frame;
+}
+
+int TextureStreamer::ResidentLevel(unsigned int textureID) const
+{
+    auto it = textures.find(textureID);
+    return it == textures.end() ? -1 : it->second.residentLevel;
+}
+
+int TextureStreamer::targetLevel(const StreamedTexture &texture) const
+{
+    if (frame - texture.lastRequested > STREAM_GRACE_FRAMES)
+        return texture.initialLevel;
+    return texture.wantedLevel;
+}
+
+unsigned int TextureStreamer::pickVictim(unsigned int keep) const
+{
+    // textures holding more than they currently need go first, then the ones that were seen longest ago
+    unsigned int victim = 0;
+    bool victimHasSurplus = false;
+    unsigned int victimSeen = 0;
+    for (const auto &entry : textures)
+    {
+        const StreamedTexture &texture = entry.second;
+        if (entry.first == keep || texture.residentLevel >= texture.initialLevel)
+            continue;
+        bool surplus = texture.residentLevel < targetLevel(texture);
+        if (victim == 0 || (surplus && !victimHasSurplus) ||
+            (surplus == victimHasSurplus && texture.lastRequested < victimSeen))
+        {
+            victim = entry.first;
+            victimHasSurplus = surplus;
+            victimSeen = texture.lastRequested;
+        }
+    }
+    return victim;
+}
+
+bool TextureStreamer::readLevel(const StreamedTexture &texture, int level, std::vector<unsigned char> &data)
+{
+    if (ReadKtxLevel(texture.path, texture.ranges[level], data))
+        return true;
+    std::cout << "TextureStreamer: failed to read level " << level << " of " << texture.path << std::endl;
+    return false;
+}
+
+void TextureStreamer::uploadLevel(unsigned int textureID, StreamedTexture &texture, const std::vector<unsigned char> &data)
+{
+    int level = texture.residentLevel - 1;
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    UploadKtxLevel(texture.layout, level, data.data(), (unsigned int)data.size());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    texture.residentLevel = level;
+    residentBytes += texture.ranges[level].size;
+    residencyResize(textureID, texture);
+}
+
+void TextureStreamer::evictLevel(unsigned int textureID, StreamedTexture &texture)
+{
+    int level = texture.residentLevel;
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level + 1);
+    // respecifying the level as 0x0 releases its storage, it's outside [base, max] so the texture stays complete
+    glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    texture.residentLevel = level + 1;
+    residentBytes -= texture.ranges[level].size;
+    residencyResize(textureID, texture);
+}
+
+void TextureStreamer::residencyResize(unsigned int textureID, const StreamedTexture &texture)
+{
+    size_t bytes = 0;
+    for (int level = texture.residentLevel; level < (int)texture.ranges.size(); level++)
+        bytes += texture.ranges[level].size;
+    GpuResidency::Instance().Resize(GPU_TEXTURE, textureID, bytes);
+}
+
+void TextureStreamer::Update(size_t maxUploadBytes)
+{
+    // textures that want finer levels, the ones furthest from what they need first
+    std::vector<std::pair<int, unsigned int>> upgrades;
+    for (auto &entry : textures)
+    {
+        int missing = entry.second.residentLevel - targetLevel(entry.second);
+        if (missing > 0)
+            upgrades.push_back(std::make_pair(missing, entry.first));
+    }
+    std::sort(upgrades.begin(), upgrades.end(), [](const std::pair<int, unsigned int> &a, const std::pair<int, unsigned int> &b) {
+        return a.first > b.first;
+    });
+
+    size_t uploaded = 0;
+    for (const auto &upgrade : upgrades)
+    {
+        StreamedTexture &texture = textures[upgrade.second];
+        size_t bytes = texture.ranges[texture.residentLevel - 1].size;
+        if (uploaded > 0 && uploaded + bytes > maxUploadBytes)
+            break;
+
+        // make room, but never at the expense of a texture that needs its levels more than this one
+        while (residentBytes + bytes > budget)
+        {
+            unsigned int victim = pickVictim(upgrade.second);
+            if (victim == 0)
+                break;
+            StreamedTexture &candidate = textures[victim];
+            if (candidate.residentLevel >= targetLevel(candidate) && candidate.lastRequested >= texture.lastRequested)
+                break;
+            evictLevel(victim, candidate);
+        }
+        // the residency budget is the hard cap over everything, streamed or not
+        if (residentBytes + bytes > budget || !GpuResidency::Instance().Reserve(bytes))
+            continue;
+
+        std::vector<unsigned char> data;
+        if (!readLevel(texture, texture.residentLevel - 1, data))
+            continue;
+        uploadLevel(upgrade.second, texture, data);
+        uploaded += bytes;
+    }
+
+    // the budget may have shrunk, or the view moved away from what was loaded
+    while (residentBytes > budget)
+    {
+        unsigned int victim = pickVictim(0);
+        if (victim == 0)
+            break;
+        evictLevel(victim, textures[victim]);
+    }
+
+    // requests made from now on belong to the next frame
+    frame++;
+}
@@ -0,0 +1,452 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <benchmark.h>
+#include <camera.h>
+#include <shader.h>
+#include <mesh.h>
+#include <model.h>
+#include <stb_image.h>
+#include <render_stats.h>
+#include <headless.h>
+#ifdef BLOB_SEA_NULL_GL
+#include <null_gl.h>
+#endif
+
+#include <dirent.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+// microbenchmarks of the renderer's hot CPU paths: camera matrix updates, Shader's uniform setters, the vertex
+// conversion of Model::processMesh, frustum culling on each of its paths, decoding textures with stb_image (every
+// JPEG under Resources, once per SIMD level of its kernels) and submitting draws.
+//
+//   blob_sea_bench [--filter text] [--repetitions n] [--warmup ms] [--sample ms] [--json out.json]
+//                  [--baseline old.json [--threshold percent]]
+//
+// Each benchmark is warmed up, then timed over many samples; the median and p99 time per operation are printed and
+// written to --json. With --baseline (an earlier --json), benchmarks whose median got slower by more than the
+// threshold (10% by default) are listed and the exit code is 1, for running it before and after a change. So is it
+// when two paths of the same code (the SIMD and scalar culling or decoding) disagree.
+// The GL benchmarks need a context: the EGL headless one when built with -DBLOB_SEA_HEADLESS=ON, otherwise a hidden
+// GLFW window; without either they're skipped. Built with -DBLOB_SEA_NULL_GL=ON they run on the null backend instead
+// (Inc/null_gl.h), anywhere, and time only the renderer's own side of each call; compare against a baseline from the
+// same backend. Run it from the build directory, like blob_sea_src, so ../Resources resolves.
+
+static void printUsage()
+{
+    std::cout << "usage: blob_sea_bench [--filter text] [--repetitions n] [--warmup ms] [--sample ms] [--json out.json]" << std::endl;
+    std::cout << "                      [--baseline old.json [--threshold percent]]" << std::endl;
+}
+
+// the benchmarks run, in order, and those their names match --filter
+struct BenchmarkRun {
+    std::string filter;
+    BenchmarkOptions options;
+    std::vector<BenchmarkResult> results;
+    // a benchmark's paths gave different results
+    bool mismatch = false;
+
+    void Run(const std::string &name, const BenchmarkBody &body)
+    {
+        if (!filter.empty() && name.find(filter) == std::string::npos)
+            return;
+        BenchmarkResult result = RunBenchmark(name, body, options);
+        std::cout << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(1)
+                  << " median " << std::setw(10) << result.medianNs << " ns   p99 " << std::setw(10) << result.p99Ns
+                  << " ns   min " << std::setw(10) << result.minNs << " ns   (" << result.samples << " x "
+                  << result.operations << ")" << std::endl;
+        results.push_back(result);
+    }
+};
+
+// an assimp mesh like the ones Model::processMesh gets: positions, normals, one set of texture coordinates and
+// a tangent frame
+static void fillMesh(aiMesh &mesh, unsigned int vertexCount)
+{
+    mesh.mNumVertices = vertexCount;
+    mesh.mVertices = new aiVector3D[vertexCount];
+    mesh.mNormals = new aiVector3D[vertexCount];
+    mesh.mTangents = new aiVector3D[vertexCount];
+    mesh.mBitangents = new aiVector3D[vertexCount];
+    mesh.mTextureCoords[0] = new aiVector3D[vertexCount];
+    mesh.mNumUVComponents[0] = 2;
+    for (unsigned int i = 0; i < vertexCount; i++)
+    {
+        float t = (float)i / (float)vertexCount;
+        mesh.mVertices[i] = aiVector3D(t, 1.0f - t, 0.5f * t);
+        mesh.mNormals[i] = aiVector3D(0.0f, 1.0f, 0.0f);
+        mesh.mTangents[i] = aiVector3D(1.0f, 0.0f, 0.0f);
+        mesh.mBitangents[i] = aiVector3D(0.0f, 0.0f, 1.0f);
+        mesh.mTextureCoords[0][i] = aiVector3D(t, t, 0.0f);
+    }
+}
+
+// every .jpg under directory, subdirectories included, sorted so runs decode them in the same order
+static void findJpegs(const std::string &directory, std::vector<std::string> &paths)
+{
+    DIR *dir = opendir(directory.c_str());
+    if (!dir)
+        return;
+    while (dirent *entry = readdir(dir))
+    {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..")
+            continue;
+        std::string path = directory + '/' + name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".jpg") == 0)
+            paths.push_back(path);
+        else
+            findJpegs(path, paths);
+    }
+    closedir(dir);
+    std::sort(paths.begin(), paths.end());
+}
+
+static std::vector<unsigned char> readFile(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<unsigned char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+// decodes every JPEG under Resources with stb_image's kernels capped at each SIMD level in turn, so the AVX2, SSE2
+// and scalar paths can be compared on the same images. The levels have to decode to the same bytes
+static void decodeBenchmarks(BenchmarkRun &run)
+{
+    std::vector<std::string> paths;
+    findJpegs("../Resources", paths);
+    std::vector<std::vector<unsigned char>> jpegs;
+    for (const std::string &path : paths)
+    {
+        jpegs.push_back(readFile(path));
+        if (jpegs.back().empty())
+            jpegs.pop_back();
+    }
+    if (jpegs.empty())
+    {
+        std::cout << "skipping stb_decode_resources_jpg: no JPEGs under ../Resources" << std::endl;
+        return;
+    }
+
+    static const struct {
+        int level;
+        const char *name;
+    } LEVELS[] = {{STBI_SIMD_SCALAR, "scalar"}, {STBI_SIMD_SSE2, "sse2"}, {STBI_SIMD_AVX2, "avx2"}};
+    std::vector<std::vector<unsigned char>> reference(jpegs.size());
+    for (const auto &level : LEVELS)
+    {
+        stbi_set_jpeg_simd_level(level.level);
+        // the scalar level's output is the reference the others are compared to
+        for (size_t i = 0; i < jpegs.size(); i++)
+        {
+            int width, height, channels;
+            unsigned char *pixels = stbi_load_from_memory(jpegs[i].data(), (int)jpegs[i].size(), &width, &height, &channels, 0);
+            std::vector<unsigned char> decoded;
+            if (pixels)
+                decoded.assign(pixels, pixels + (size_t)width * height * channels);
+            stbi_image_free(pixels);
+            if (level.level == STBI_SIMD_SCALAR)
+                reference[i] = decoded;
+            else if (decoded != reference[i])
+            {
+                std::cout << "stb_decode_resources_jpg: the " << level.name << " kernels decode " << paths[i]
+                          << " differently from the scalar ones" << std::endl;
+                run.mismatch = true;
+            }
+        }
+        run.Run(std::string("stb_decode_resources_jpg_") + level.name, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i++)
+            {
+                for (const std::vector<unsigned char> &jpeg : jpegs)
+                {
+                    int width, height, channels;
+                    unsigned char *pixels = stbi_load_from_memory(jpeg.data(), (int)jpeg.size(), &width, &height, &channels, 0);
+                    KeepValue(pixels);
+                    stbi_image_free(pixels);
+                }
+            }
+        });
+    }
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    if (!__builtin_cpu_supports("avx2"))
+        std::cout << "stb_decode_resources_jpg_avx2: this CPU has no AVX2, it ran the SSE2 kernels" << std::endl;
+#endif
+    stbi_set_jpeg_simd_level(STBI_SIMD_AVX2);
+}
+
+// culls the same random boxes (a scene's worth of meshes all around the camera, a few percent of them visible) with
+// each of CullBoxes' loops, which have to agree on every box
+static void cullBenchmarks(BenchmarkRun &run)
+{
+    Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+    camera.SetViewport(800, 600);
+    Frustum frustum = camera.GetFrustum();
+
+    std::mt19937 random(36);
+    std::uniform_real_distribution<float> position(-50.0f, 50.0f), size(0.1f, 4.0f);
+    BoundingBoxes boxes;
+    for (int i = 0; i < 4099; i++)
+    {
+        glm::vec3 center(position(random), position(random), position(random)), extent(size(random), size(random), size(random));
+        boxes.Add(center - extent, center + extent);
+    }
+
+    static const struct {
+        CullPath path;
+        const char *name;
+    } PATHS[] = {{CULL_SCALAR, "scalar"}, {CULL_SSE, "sse"}, {CULL_AVX, "avx"}};
+    std::vector<unsigned int> reference, visible;
+    CullBoxes(frustum, boxes, reference, CULL_SCALAR);
+    for (const auto &path : PATHS)
+    {
+        CullBoxes(frustum, boxes, visible, path.path);
+        if (visible != reference)
+        {
+            std::cout << "cull_boxes_4k: the " << path.name << " loop finds " << visible.size() << " of " << boxes.Size()
+                      << " boxes visible, the scalar one " << reference.size() << std::endl;
+            run.mismatch = true;
+        }
+        run.Run(std::string("cull_boxes_4k_") + path.name, [&](size_t operations) {
+            for (size_t i = 0; i < operations; i++)
+            {
+                CullBoxes(frustum, boxes, visible, path.path);
+                KeepValue(visible.data());
+            }
+        });
+    }
+}
+
+static void cpuBenchmarks(BenchmarkRun &run)
+{
+    Camera camera(glm::vec3(0.0f, 0.0f, 3.0f));
+    camera.SetViewport(800, 600);
+    // turning back and forth, so the camera stays put over any number of operations
+    float turn = 0.25f;
+    run.Run("camera_update_matrices", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+        {
+            turn = -turn;
+            camera.ProcessMouseMovement(turn, 0.0f, true);
+            KeepValue(camera.GetViewProjectionMatrix()[0][0]);
+        }
+    });
+    run.Run("camera_update_frustum", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+        {
+            turn = -turn;
+            camera.ProcessMouseMovement(turn, 0.0f, true);
+            KeepValue(camera.GetFrustum());
+        }
+    });
+    run.Run("camera_cached_matrices", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            KeepValue(camera.GetViewProjectionMatrix()[0][0]);
+    });
+
+    aiMesh mesh;
+    fillMesh(mesh, 1 << 16);
+    std::vector<Vertex> vertices;
+    run.Run("convert_mesh_vertices_64k", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+        {
+            // a fresh vector each time, like processMesh's
+            std::vector<Vertex>().swap(vertices);
+            ConvertMeshVertices(&mesh, vertices);
+            KeepValue(vertices.data());
+        }
+    });
+
+    cullBenchmarks(run);
+    decodeBenchmarks(run);
+
+    std::vector<unsigned char> jpeg = readFile("../Resources/container.jpg");
+    if (jpeg.empty())
+    {
+        std::cout << "skipping stb_decode_container_jpg: can't read ../Resources/container.jpg" << std::endl;
+        return;
+    }
+    run.Run("stb_decode_container_jpg", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+        {
+            int width, height, channels;
+            unsigned char *pixels = stbi_load_from_memory(jpeg.data(), (int)jpeg.size(), &width, &height, &channels, 0);
+            KeepValue(pixels);
+            stbi_image_free(pixels);
+        }
+    });
+}
+
+static void glBenchmarks(BenchmarkRun &run)
+{
+    Shader shader("../Resources/shader_terrain.vert", "../Resources/shader_terrain.frag");
+    shader.use();
+    shader.setMat4("view", glm::mat4(1.0f));
+    shader.setMat4("projection", glm::mat4(1.0f));
+
+    glm::mat4 model = glm::mat4(1.0f);
+    run.Run("shader_set_mat4", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            shader.setMat4("model", model);
+    });
+    run.Run("shader_set_vec4", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            shader.setVec4("aColour", 1.0f, 0.0f, 0.0f, 1.0f);
+    });
+
+    // one square of the terrain, drawn the way draw_grid draws each visible square
+    float square[] = {
+            -1.0f, 0.0f, -1.0f,   1.0f, 0.0f, -1.0f,   1.0f, 0.0f, 1.0f,
+            1.0f, 0.0f, 1.0f,   -1.0f, 0.0f, 1.0f,   -1.0f, 0.0f, -1.0f,
+    };
+    unsigned int VAO, VBO;
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(square), square, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // the squares are scaled down to nothing, so this measures submitting them and not rasterizing them
+    glm::mat4 hidden = glm::scale(glm::mat4(1.0f), glm::vec3(0.0f));
+    run.Run("draw_submit_grid_cell", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+        {
+            shader.setVec4("aColour", (float)(i & 1), 0.0f, 0.0f, 1.0f);
+            shader.setMat4("model", hidden);
+            CountedDrawArrays(GL_TRIANGLES, 0, 6);
+        }
+        glFlush();
+    });
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+
+    aiMesh source;
+    fillMesh(source, 1024);
+    std::vector<Vertex> vertices;
+    ConvertMeshVertices(&source, vertices);
+    std::vector<unsigned int> indices(vertices.size());
+    for (unsigned int i = 0; i < indices.size(); i++)
+        indices[i] = i;
+    Mesh mesh(vertices, indices, std::vector<Texture>());
+    shader.setMat4("model", hidden);
+    run.Run("mesh_draw", [&](size_t operations) {
+        for (size_t i = 0; i < operations; i++)
+            mesh.Draw(shader);
+        glFlush();
+    });
+    glFinish();
+    mesh.del();
+    shader.del();
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkRun run;
+    std::string jsonPath, baselinePath;
+    double threshold = 10.0;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc)
+            run.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--repetitions") == 0 && i + 1 < argc)
+            run.options.repetitions = (unsigned int)std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            run.options.warmupMs = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--sample") == 0 && i + 1 < argc)
+            run.options.sampleMs = std::max(0.01, std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+            jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc)
+            baselinePath = argv[++i];
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+            threshold = std::atof(argv[++i]);
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    cpuBenchmarks(run);
+
+#if defined(BLOB_SEA_NULL_GL)
+    if (gladLoadGLLoader((GLADloadproc)NullGl::GetProcAddress))
+    {
+        std::cout << "GL: " << (const char *)glGetString(GL_RENDERER) << std::endl;
+        NullGl::Reset();
+        glBenchmarks(run);
+        const NullGlCounters &counters = NullGl::Counters();
+        std::cout << "null GL: " << counters.calls << " calls, " << counters.draws << " draws, " << counters.stateChanges
+                  << " state changes, " << counters.uniforms << " uniforms, " << counters.uploads << " uploads ("
+                  << counters.uploadBytes << " bytes)" << std::endl;
+    }
+    else
+        std::cout << "skipping the GL benchmarks: the null backend failed to load" << std::endl;
+#elif defined(BLOB_SEA_HEADLESS)
+    HeadlessContext context;
+    if (context.Create() && gladLoadGLLoader((GLADloadproc)HeadlessContext::GetProcAddress))
+    {
+        // there's no default framebuffer to draw into
+        OffscreenTarget target;
+        target.Create(64, 64);
+        std::cout << "GL: " << context.Renderer() << std::endl;
+        glBenchmarks(run);
+        target.del();
+    }
+    else
+        std::cout << "skipping the GL benchmarks: no headless context" << std::endl;
+    context.del();
+#else
+    GLFWwindow *window = nullptr;
+    if (glfwInit())
+    {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        window = glfwCreateWindow(64, 64, "blob_sea_bench", NULL, NULL);
+    }
+    if (window)
+    {
+        glfwMakeContextCurrent(window);
+        // uncapped, so a swap never shows up in a timing
+        glfwSwapInterval(0);
+    }
+    if (window && gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+        glBenchmarks(run);
+    else
+        std::cout << "skipping the GL benchmarks: no window (configure with -DBLOB_SEA_HEADLESS=ON for EGL)" << std::endl;
+    glfwTerminate();
+#endif
+
+    if (!jsonPath.empty() && !WriteBenchmarkJson(jsonPath, run.results))
+        return 1;
+
+    if (baselinePath.empty())
+        return run.mismatch ? 1 : 0;
+    std::vector<BenchmarkResult> baseline;
+    if (!ReadBenchmarkJson(baselinePath, baseline))
+        return 1;
+    std::vector<BenchmarkRegression> regressions = CompareBenchmarks(baseline, run.results, threshold / 100.0);
+    for (const BenchmarkRegression &regression : regressions)
+        std::cout << "REGRESSION " << regression.name << ": " << std::setprecision(1) << regression.baselineNs
+                  << " ns -> " << regression.currentNs << " ns (+" << (regression.ratio - 1.0) * 100.0 << "%)" << std::endl;
+    std::cout << regressions.size() << " regression(s) over " << threshold << "% against " << baselinePath << std::endl;
+    return regressions.empty() && !run.mismatch ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+#include <texture_cooker.h>
+#include <image_decode.h>
+#include <ktx.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+
+// offline texture cooker: turns the source images into block compressed, pre-mipmapped KTX files that
+// TextureFromFile uploads directly instead of decoding.
+//
+//   blob_sea_cook [options] --model <model file>           cooks every texture referenced by the model's materials
+//   blob_sea_cook [options] --type <usage> <image> [out]   cooks a single image (usage: diffuse, specular, normal, ao)
+//   blob_sea_cook [jpeg options] --jpeg --model <file>     re-encodes the model's JPEG textures in place with restart markers
+//   blob_sea_cook [jpeg options] --jpeg <image> [out]      re-encodes a single JPEG with restart markers
+//
+// options: --fast (BC1/BC3 instead of BC7 for diffuse maps), --srgb (diffuse maps are sRGB), --threads <n>
+// jpeg options: --quality <1-100> (default 95), --restart <MCUs> (default one MCU row), --444 (no chroma subsampling)
+
+static void printUsage()
+{
+    std::cout << "usage: blob_sea_cook [--fast] [--srgb] [--threads n] --model <file>" << std::endl;
+    std::cout << "       blob_sea_cook [--fast] [--srgb] [--threads n] --type <diffuse|specular|normal|ao> <image> [output]" << std::endl;
+    std::cout << "       blob_sea_cook [--quality q] [--restart mcus] [--444] --jpeg (--model <file> | <image> [output])" << std::endl;
+}
+
+static bool parseUsage(const char *name, TextureUsage &usage)
+{
+    if (std::strcmp(name, "diffuse") == 0)
+        usage = TEXTURE_DIFFUSE;
+    else if (std::strcmp(name, "specular") == 0)
+        usage = TEXTURE_SPECULAR;
+    else if (std::strcmp(name, "normal") == 0)
+        usage = TEXTURE_NORMAL;
+    else if (std::strcmp(name, "ao") == 0)
+        usage = TEXTURE_AO;
+    else
+        return false;
+    return true;
+}
+
+static bool isJpeg(const std::string &path)
+{
+    std::string extension = path.substr(path.find_last_of('.') + 1);
+    for (auto &c : extension)
+        c = (char)std::tolower((unsigned char)c);
+    return extension == "jpg" || extension == "jpeg";
+}
+
+// re-encodes a JPEG with restart markers unless it already has them, re-encoding is lossy so it's only done once
+static bool restartJpeg(const std::string &source, const std::string &destination, const JpegEncodeOptions &options)
+{
+    if (source == destination && JpegRestartInterval(source) > 0)
+    {
+        std::cout << "already has restart markers: " << source << std::endl;
+        return true;
+    }
+    std::cout << "re-encoding " << source << std::endl;
+    return RestartJpeg(source, destination, options);
+}
+
+// cooks the material textures of a model, using the same texture type -> sampler convention as Model::processMesh
+// (or with jpeg set, only rewrites its JPEG textures with restart markers)
+static int cookModel(const std::string &path, const CookOptions &options, const JpegEncodeOptions *jpeg)
+{
+    Assimp::Importer importer;
+    const aiScene *scene = importer.ReadFile(path, 0);
+    if (!scene)
+    {
+        std::cout << "ERROR::ASSIMP:: " << importer.GetErrorString() << std::endl;
+        return 1;
+    }
+    std::string directory = path.substr(0, path.find_last_of('/'));
+
+    struct { aiTextureType type; TextureUsage usage; } slots[] = {
+        {aiTextureType_DIFFUSE, TEXTURE_DIFFUSE},
+        {aiTextureType_SPECULAR, TEXTURE_SPECULAR},
+        {aiTextureType_HEIGHT, TEXTURE_NORMAL},
+        {aiTextureType_AMBIENT, TEXTURE_AO},
+    };
+
+    std::set<std::string> cooked;
+    int failures = 0;
+    for (unsigned int m = 0; m < scene->mNumMaterials; m++)
+    {
+        aiMaterial *material = scene->mMaterials[m];
+        for (const auto &slot : slots)
+        {
+            for (unsigned int i = 0; i < material->GetTextureCount(slot.type); i++)
+            {
+                aiString str;
+                material->GetTexture(slot.type, i, &str);
+                std::string source = directory + '/' + str.C_Str();
+                if (!cooked.insert(source).second)
+                    continue;
+                if (jpeg)
+                {
+                    if (isJpeg(source) && !restartJpeg(source, source, *jpeg))
+                        failures++;
+                    continue;
+                }
+                std::cout << "cooking " << source << std::endl;
+                if (!CookTexture(source, CookedTexturePath(source), slot.usage, options))
+                    failures++;
+            }
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    CookOptions options;
+    JpegEncodeOptions jpegOptions;
+    bool jpeg = false;
+    std::string model;
+    TextureUsage usage = TEXTURE_DIFFUSE;
+    bool single = false;
+    std::string source, destination;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--fast") == 0)
+            options.highQuality = false;
+        else if (std::strcmp(argv[i], "--srgb") == 0)
+            options.srgb = true;
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            options.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--jpeg") == 0)
+            jpeg = true;
+        else if (std::strcmp(argv[i], "--quality") == 0 && i + 1 < argc)
+            jpegOptions.quality = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--restart") == 0 && i + 1 < argc)
+            jpegOptions.restartInterval = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--444") == 0)
+            jpegOptions.subsample = false;
+        else if (std::strcmp(argv[i], "--model") == 0 && i + 1 < argc)
+            model = argv[++i];
+        else if (std::strcmp(argv[i], "--type") == 0 && i + 1 < argc)
+        {
+            if (!parseUsage(argv[++i], usage))
+            {
+                printUsage();
+                return 1;
+            }
+            single = true;
+        }
+        else if (source.empty())
+            source = argv[i];
+        else if (destination.empty())
+            destination = argv[i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // decoding the sources is serial otherwise
+    SetImageDecodeThreads(options.threads);
+
+    if (!model.empty())
+        return cookModel(model, options, jpeg ? &jpegOptions : nullptr);
+    if (jpeg && !source.empty())
+    {
+        if (destination.empty())
+            destination = source;
+        return restartJpeg(source, destination, jpegOptions) ? 0 : 1;
+    }
+    if (!single || source.empty())
+    {
+        printUsage();
+        return 1;
+    }
+    if (destination.empty())
+        destination = CookedTexturePath(source);
+    return CookTexture(source, destination, usage, options) ? 0 : 1;
+}
@@ -8,8 +8,39 @@
 #include <stb_image.h>
 #include <camera.h>
 #include <iostream>
+#include <cstdlib>
+#include <algorithm>
 #include <mesh.h>
 #include <model.h>
+#include <material_packer.h>
+#include <texture_cache.h>
+#include <image_decode.h>
+#include <texture_streamer.h>
+#include <gpu_residency.h>
+#include <texture_quality.h>
+#include <frustum.h>
+#include <headless.h>
+#include <profiler.h>
+#include <perf_counters.h>
+#include <alloc_tracker.h>
+#include <gpu_profiler.h>
+#include <render_stats.h>
+#include <stats_overlay.h>
+#include <pipeline_statistics.h>
+#include <overdraw.h>
+#include <stress_scene.h>
+#include <hitch_recorder.h>
+#include <input_log.h>
+#include <camera_path.h>
+#include <gl_capture.h>
+
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -31,6 +62,11 @@ bool firstMouse = true;
 // timing
 float deltaTime = 0.0f;	// time between current frame and last frame
 float lastFrame = 0.0f;
+// the clock of headless runs, input playback and camera paths, which advance by the same step every frame
+const float FIXED_TIMESTEP = 1.0f / 60.0f;
+
+// the camera and blob input gathered from GLFW since the last frame (see input_log.h)
+FrameInput liveInput;
 
 // movement things
 float move_x = 0.0f;
@@ -43,38 +79,296 @@ glm::vec3 grid_scale = 0.5f * blob_scale;
 
 int grid_dim = 16;
 
+// the HUD with the render statistics (--hud, H toggles it)
+bool showHud = false;
+
+// the overdraw view (--overdraw counts fragments passing the depth test, --overdraw-all every fragment; O cycles
+// through off, depth tested and all)
+enum OverdrawMode {
+    OVERDRAW_OFF,
+    OVERDRAW_DEPTH_TESTED,
+    OVERDRAW_ALL
+};
+OverdrawMode overdrawMode = OVERDRAW_OFF;
+
+// memory budget for streamed (cooked) textures
+const size_t TEXTURE_BUDGET = 256 * 1024 * 1024;
+// hard cap on all GPU memory (buffers and textures, streamed or not); BLOB_SEA_GPU_BUDGET_MB overrides it so
+// several instances can share a machine
+const size_t GPU_BUDGET = 512 * 1024 * 1024;
+
 void draw_grid(glm::mat4 terrain_model, Shader TerrainShader);
 void mouse_callback(GLFWwindow *window, double xpos, double ypos);
 void scroll_callback(GLFWwindow *window, double xoffset, double yoffset);
 void processInput(GLFWwindow *window);
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
+void apply_input(const FrameInput &input);
+void print_frame_stats(std::vector<double> frameMs);
+void print_frame_percentiles(const char *label, const FrameHistogram &histogram);
+StressSceneResult measure_stress_run(const std::vector<double> &frameMs, std::vector<double> cpuMs, const std::vector<double> &gpuMs);
 
-int main()
+int main(int argc, char **argv)
 {
-    // glfw: initialize and configure
-    // ------------------------------
-    glfwInit();
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    // command line: --headless renders a fixed number of frames into an offscreen target, without a window or display
+    // ------------------------------------------------------------------------------------------------------------------
+    bool headless = false;
+    int headlessWidth = SCR_WIDTH, headlessHeight = SCR_HEIGHT;
+    int headlessFrames = 600;
+    const char *screenshot = NULL;
+    // --trace writes the CPU zones (see profiler.h) of the whole run as a Chrome trace when it ends
+    const char *trace = NULL;
+    // --pipeline-stats measures every pass with pipeline statistics queries
+    bool pipelineStats = false;
+    // the stress scene: --grid, --blobs, --models and --textures size it (see stress_scene.h), --model picks the model
+    // its instances are of. Given lists of values, every combination is run headless and --csv gets a row for each
+    std::vector<int> gridDims(1, grid_dim), blobCounts(1, 1), modelCounts(1, 0), textureCounts(1, 1);
+    const char *modelPath = "../Resources/backpack/backpack.obj";
+    const char *csv = NULL;
+    // --pack-materials draws the model instances with their textures packed into texture arrays (see material_packer.h)
+    bool packMaterials = false;
+    // --hitch-ms turns the flight recorder on: a frame slower than that dumps the last --hitch-window seconds of
+    // zones to <--hitch-trace>_0001.json ... (see hitch_recorder.h)
+    float hitchMs = 0.0f, hitchWindow = 5.0f;
+    const char *hitchTrace = "hitch";
+    // --record-input logs the camera and blob input of every frame, --play-input replays such a log (one logged frame
+    // per frame, ending the run with the log) and --camera-path flies the camera along an authored spline instead
+    const char *recordInput = NULL, *playInput = NULL, *cameraPathFile = NULL;
+    // --gl-capture records the GL calls of --gl-capture-frames frames from frame --gl-capture-from on, for
+    // blob_sea_replay (see gl_capture.h)
+    const char *glCapture = NULL;
+    unsigned int glCaptureFrom = 30, glCaptureFrames = 1;
+    // --alloc-stats counts heap allocations per frame and subsystem (see alloc_tracker.h), --alloc-assert aborts on
+    // the first allocation of the render loop from that frame on
+    bool allocStats = false;
+    int allocAssertFrom = -1;
+    bool framesGiven = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc &&
+                 std::sscanf(argv[i + 1], "%dx%d", &headlessWidth, &headlessHeight) == 2 && headlessWidth > 0 && headlessHeight > 0)
+            i++;
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+            headlessFrames = std::atoi(argv[++i]);
+            framesGiven = true;
+        }
+        else if (std::strcmp(argv[i], "--screenshot") == 0 && i + 1 < argc)
+            screenshot = argv[++i];
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            trace = argv[++i];
+        else if (std::strcmp(argv[i], "--hud") == 0)
+            showHud = true;
+        else if (std::strcmp(argv[i], "--overdraw") == 0)
+            overdrawMode = OVERDRAW_DEPTH_TESTED;
+        else if (std::strcmp(argv[i], "--overdraw-all") == 0)
+            overdrawMode = OVERDRAW_ALL;
+        else if (std::strcmp(argv[i], "--pipeline-stats") == 0)
+            pipelineStats = true;
+        else if (std::strcmp(argv[i], "--grid") == 0 && i + 1 < argc && ParseStressValues(argv[i + 1], 1, gridDims))
+            i++;
+        else if (std::strcmp(argv[i], "--blobs") == 0 && i + 1 < argc && ParseStressValues(argv[i + 1], 0, blobCounts))
+            i++;
+        else if (std::strcmp(argv[i], "--models") == 0 && i + 1 < argc && ParseStressValues(argv[i + 1], 0, modelCounts))
+            i++;
+        else if (std::strcmp(argv[i], "--textures") == 0 && i + 1 < argc && ParseStressValues(argv[i + 1], 1, textureCounts))
+            i++;
+        else if (std::strcmp(argv[i], "--model") == 0 && i + 1 < argc)
+            modelPath = argv[++i];
+        else if (std::strcmp(argv[i], "--pack-materials") == 0)
+            packMaterials = true;
+        else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            csv = argv[++i];
+        else if (std::strcmp(argv[i], "--hitch-ms") == 0 && i + 1 < argc)
+            hitchMs = (float)std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--hitch-window") == 0 && i + 1 < argc)
+            hitchWindow = (float)std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--hitch-trace") == 0 && i + 1 < argc)
+            hitchTrace = argv[++i];
+        else if (std::strcmp(argv[i], "--record-input") == 0 && i + 1 < argc)
+            recordInput = argv[++i];
+        else if (std::strcmp(argv[i], "--play-input") == 0 && i + 1 < argc)
+            playInput = argv[++i];
+        else if (std::strcmp(argv[i], "--camera-path") == 0 && i + 1 < argc)
+            cameraPathFile = argv[++i];
+        else if (std::strcmp(argv[i], "--gl-capture") == 0 && i + 1 < argc)
+            glCapture = argv[++i];
+        else if (std::strcmp(argv[i], "--gl-capture-from") == 0 && i + 1 < argc)
+            glCaptureFrom = (unsigned int)std::max(0, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--gl-capture-frames") == 0 && i + 1 < argc)
+            glCaptureFrames = (unsigned int)std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--alloc-stats") == 0)
+            allocStats = true;
+        else if (std::strcmp(argv[i], "--alloc-assert") == 0 && i + 1 < argc)
+            allocAssertFrom = std::max(0, std::atoi(argv[++i]));
+        else {
+            std::cout << "usage: blob_sea_src [--headless [--size WxH] [--frames n] [--screenshot out.ppm]] [--trace out.json] [--hud] [--overdraw | --overdraw-all] [--pipeline-stats]" << std::endl;
+            std::cout << "                    [--grid n,...] [--blobs n,...] [--models n,...] [--textures n,...] [--model file] [--pack-materials]" << std::endl;
+            std::cout << "                    [--csv out.csv]" << std::endl;
+            std::cout << "                    [--hitch-ms ms [--hitch-window s] [--hitch-trace prefix]]" << std::endl;
+            std::cout << "                    [--record-input out.bin] [--play-input in.bin | --camera-path path.txt]" << std::endl;
+            std::cout << "                    [--gl-capture out.glc [--gl-capture-from frame] [--gl-capture-frames n]]" << std::endl;
+            std::cout << "                    [--alloc-stats] [--alloc-assert frame]" << std::endl;
+            return -1;
+        }
+    }
+    if (playInput && cameraPathFile) {
+        std::cout << "Input: --play-input and --camera-path both move the camera, pick one" << std::endl;
+        return -1;
+    }
+    std::vector<StressSceneConfig> stressConfigs = StressSweepConfigs(gridDims, blobCounts, modelCounts, textureCounts);
+    if (csv && !headless) {
+        std::cout << "Stress: --csv needs --headless" << std::endl;
+        return -1;
+    }
+    if (stressConfigs.size() > 1) {
+        // a sweep runs this executable again for each configuration, with the same size, frames and model
+        if (!csv) {
+            std::cout << "Stress: sweeping several configurations needs --headless and --csv" << std::endl;
+            return -1;
+        }
+        // options writing a file of their own would have every run overwrite the last one's
+        if (screenshot || trace || hitchMs > 0.0f || recordInput || glCapture) {
+            std::cout << "Stress: --screenshot, --trace, --hitch-ms, --record-input and --gl-capture can't be combined with a sweep" << std::endl;
+            return -1;
+        }
+        // everything else that shapes the runs is passed on, so each one measures the setup asked for
+        std::vector<std::string> command;
+        command.push_back(argv[0]);
+        command.push_back("--headless");
+        command.push_back("--size");
+        command.push_back(std::to_string(headlessWidth) + "x" + std::to_string(headlessHeight));
+        // without --frames each run works it out itself, e.g. from the input log or the camera path
+        if (framesGiven) {
+            command.push_back("--frames");
+            command.push_back(std::to_string(headlessFrames));
+        }
+        command.push_back("--model");
+        command.push_back(modelPath);
+        if (packMaterials)
+            command.push_back("--pack-materials");
+        // the same views in every configuration
+        if (cameraPathFile) {
+            command.push_back("--camera-path");
+            command.push_back(cameraPathFile);
+        }
+        if (playInput) {
+            command.push_back("--play-input");
+            command.push_back(playInput);
+        }
+        if (showHud)
+            command.push_back("--hud");
+        if (overdrawMode != OVERDRAW_OFF)
+            command.push_back(overdrawMode == OVERDRAW_ALL ? "--overdraw-all" : "--overdraw");
+        if (pipelineStats)
+            command.push_back("--pipeline-stats");
+        if (allocStats)
+            command.push_back("--alloc-stats");
+        if (allocAssertFrom >= 0) {
+            command.push_back("--alloc-assert");
+            command.push_back(std::to_string(allocAssertFrom));
+        }
+        return RunStressSweep(command, stressConfigs, csv) == 0 ? 0 : -1;
+    }
+    const StressSceneConfig &stressConfig = stressConfigs[0];
+    grid_dim = stressConfig.gridDim;
+#ifndef BLOB_SEA_PROFILE
+    if (trace)
+        std::cout << "Profiler: built without zones, configure with -DBLOB_SEA_PROFILE=ON to record them" << std::endl;
+    if (allocStats || allocAssertFrom >= 0)
+        std::cout << "Alloc: built without the allocation hook, configure with -DBLOB_SEA_PROFILE=ON to count" << std::endl;
+#endif
+    if (allocStats || allocAssertFrom >= 0)
+        AllocTracker::Instance().Enable();
+    PROFILE_THREAD("main");
+
+    InputRecorder inputRecorder;
+    InputPlayback inputPlayback;
+    CameraPath cameraPath;
+    if (playInput) {
+        if (!inputPlayback.Open(playInput))
+            return -1;
+        const InputStart &start = inputPlayback.Start();
+        camera.SetPose(start.position, start.yaw, start.pitch, start.zoom);
+        move_x = start.blobX;
+        move_z = start.blobZ;
+        // until the log ends
+        if (!framesGiven)
+            headlessFrames = INT_MAX;
+    }
+    if (cameraPathFile) {
+        if (!cameraPath.Load(cameraPathFile))
+            return -1;
+        // the whole path, its last keyframe included
+        if (!framesGiven)
+            headlessFrames = (int)(cameraPath.Duration() / FIXED_TIMESTEP) + 1;
+    }
+    if (recordInput) {
+        InputStart start;
+        start.position = camera.Position;
+        start.yaw = camera.Yaw;
+        start.pitch = camera.Pitch;
+        start.zoom = camera.Zoom;
+        start.blobX = move_x;
+        start.blobZ = move_z;
+        if (!inputRecorder.Open(recordInput, start))
+            return -1;
+    }
+    bool fixedTimestep = headless || playInput || cameraPathFile;
+    HitchRecorder hitchRecorder;
+    hitchRecorder.Configure(hitchMs, hitchWindow, hitchTrace);
+
+    GLFWwindow* window = NULL;
+    HeadlessContext headlessContext;
+    OffscreenTarget offscreen;
+    if (headless) {
+        // egl: a context without any surface, then the same glad loading through EGL
+        // ---------------------------------------------------------------------------
+        if (!headlessContext.Create())
+            return -1;
+        if (!gladLoadGLLoader((GLADloadproc)HeadlessContext::GetProcAddress))
+        {
+            std::cout << "Failed to initialize GLAD" << std::endl;
+            return -1;
+        }
+        std::cout << "Headless: " << headlessContext.Renderer() << ", " << headlessWidth << "x" << headlessHeight
+                  << ", " << headlessFrames << " frames" << std::endl;
+        camera.SetViewport(headlessWidth, headlessHeight);
+    } else {
+        // glfw: initialize and configure
+        // ------------------------------
+        glfwInit();
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
 #ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+        glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
-    // glfw window creation
-    // --------------------
-    GLFWwindow* window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "LearnOpenGL", NULL, NULL);
-    glfwMakeContextCurrent(window);
-    glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-
-    // glad: load all OpenGL function pointers
-    // ---------------------------------------
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-    {
-        std::cout << "Failed to initialize GLAD" << std::endl;
-        return -1;
+        // glfw window creation
+        // --------------------
+        window = glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "LearnOpenGL", NULL, NULL);
+        glfwMakeContextCurrent(window);
+        glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+
+        // the framebuffer can be larger than the window (retina), and its shape is what the projection needs
+        int framebufferWidth, framebufferHeight;
+        glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+        camera.SetViewport(framebufferWidth, framebufferHeight);
+
+        // glad: load all OpenGL function pointers
+        // ---------------------------------------
+        if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+        {
+            std::cout << "Failed to initialize GLAD" << std::endl;
+            return -1;
+        }
     }
+    // right after glad, so every object the captured frames use is created through the capture
+    if (glCapture && !GlCapture::Instance().Start(glCapture, camera.ViewportWidth(), camera.ViewportHeight(), glCaptureFrom, glCaptureFrames))
+        return -1;
+    if (headless && !offscreen.Create(headlessWidth, headlessHeight))
+        return -1;
 
     // configure global opengl state
     // -----------------------------
@@ -84,28 +378,71 @@ int main()
     // ------------------------------------
     Shader BlobShader("../Resources/shader_blob.vert", "../Resources/shader_blob.frag");
     Shader TerrainShader("../Resources/shader_terrain.vert", "../Resources/shader_terrain.frag");
+    StatsOverlay hud;
+    hud.Create();
+    // the passes' vertex shaders with a fragment shader counting fragments, for the overdraw view
+    Shader BlobOverdrawShader("../Resources/shader_blob.vert", "../Resources/shader_overdraw.frag");
+    Shader TerrainOverdrawShader("../Resources/shader_terrain.vert", "../Resources/shader_overdraw.frag");
+    OverdrawView overdrawView;
+    overdrawView.Create();
+    if (pipelineStats)
+        PipelineStatistics::Instance().SetEnabled(true);
 
     // doing texture things
     // --------------------
-    unsigned int texture;
-    glGenTextures(1, &texture);
-    glBindTexture(GL_TEXTURE_2D, texture);
-
-    // set the texture wrapping/filtering options (on the currently bound texture object)
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    // load and generate the texture
-    int width, height, nrChannels;
-    unsigned char *data = stbi_load("../Resources/container.jpg", &width, &height, &nrChannels, 0);
-    if (data) {
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    } else {
-        std::cout << "Failed to load texture" << std::endl;
+    size_t gpuBudget = GPU_BUDGET;
+    if (const char *budgetMB = std::getenv("BLOB_SEA_GPU_BUDGET_MB"))
+        gpuBudget = (size_t)std::strtoull(budgetMB, NULL, 10) * 1024 * 1024;
+    GpuResidency::Instance().SetBudget(gpuBudget);
+    // streamed textures count against the hard cap too, so they get at most half of it (0 means no cap). Packed
+    // materials are copies of whatever levels are resident when they're packed, so those textures load whole instead
+    if (!packMaterials)
+        TextureStreamer::Instance().SetBudget(gpuBudget == 0 ? TEXTURE_BUDGET : std::min(TEXTURE_BUDGET, gpuBudget / 2));
+    // BLOB_SEA_TEXTURE_QUALITY ("half", "quarter", "1024", "half/1024" ...) lowers every texture's resolution for small
+    // machines; texture_quality.txt next to the resources can keep some of them (e.g. texture_normal) sharper
+    if (const char *quality = std::getenv("BLOB_SEA_TEXTURE_QUALITY"))
+    {
+        TextureQuality tier;
+        if (ParseTextureQuality(quality, tier))
+            TextureQualitySettings::Instance().SetDefault(tier);
+        else
+            std::cout << "Texture quality: unknown setting " << quality << std::endl;
+    }
+    TextureQualitySettings::Instance().LoadOverrides("../Resources/texture_quality.txt");
+    // JPEGs with restart markers (see blob_sea_cook --jpeg) decode on every core
+    SetImageDecodeThreads(0);
+
+    // the container texture goes through the shared cache like every model texture, so it is only ever decoded once
+    unsigned int texture = TextureCache::Instance().Acquire("container.jpg", "../Resources");
+
+    // the stress scene's blob layout and textures, and its model instances if the model loads
+    StressScene stressScene;
+    stressScene.Create(stressConfig, texture);
+    std::unique_ptr<Model> stressModel;
+    std::unique_ptr<Shader> ModelShader, ModelOverdrawShader;
+    MaterialPacker materialPacker;
+    bool packedMaterials = false;
+    if (stressConfig.models > 0) {
+        stressModel.reset(new Model(modelPath));
+        if (stressModel->meshes.empty()) {
+            std::cout << "Stress: no meshes in " << modelPath << ", drawing no model instances" << std::endl;
+            stressModel.reset();
+        } else {
+            ModelShader.reset(new Shader("../Resources/shader_model.vert", "../Resources/shader_model.frag"));
+            ModelOverdrawShader.reset(new Shader("../Resources/shader_model.vert", "../Resources/shader_overdraw.frag"));
+            if (packMaterials) {
+                stressModel->AddTextures(materialPacker);
+                materialPacker.Pack();
+                // a texture left out (no image, or an array past the texture units) would be read from the wrong
+                // layer, so the model is drawn unpacked then
+                packedMaterials = stressModel->UsePacker(materialPacker);
+                if (packedMaterials)
+                    ModelShader.reset(new Shader("../Resources/shader_model.vert", "../Resources/shader_model_packed.frag"));
+                else
+                    std::cout << "Stress: not every texture of " << modelPath << " could be packed, drawing it unpacked" << std::endl;
+            }
+        }
     }
-    stbi_image_free(data);
 
     // set up vertex data (and buffer(s)) and configure vertex attributes
     // ------------------------------------------------------------------
@@ -173,7 +510,8 @@ int main()
     glBindVertexArray(VAO_blob);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO_blob);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(blobVertices), blobVertices, GL_STATIC_DRAW);
+    CountedBufferData(GL_ARRAY_BUFFER, sizeof(blobVertices), blobVertices, GL_STATIC_DRAW);
+    GpuResidency::Instance().Track(GPU_BUFFER, VBO_blob, sizeof(blobVertices));
 
     // position attribute
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
@@ -189,42 +527,114 @@ int main()
     glBindVertexArray(VAO_terrain);
 
     glBindBuffer(GL_ARRAY_BUFFER, VBO_terrain);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(terrainVertices), terrainVertices, GL_STATIC_DRAW);
+    CountedBufferData(GL_ARRAY_BUFFER, sizeof(terrainVertices), terrainVertices, GL_STATIC_DRAW);
+    GpuResidency::Instance().Track(GPU_BUFFER, VBO_terrain, sizeof(terrainVertices));
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
+    // camera version the shaders' view and projection uniforms were last set from
+    unsigned int uploadedCameraVersion = 0;
+
+    // headless runs time every frame (including waiting for the GPU) and advance the clock by fixed steps,
+    // so two runs render the same frames
+    std::vector<double> frameMs;
+    int frameIndex = 0;
+    // for the --csv row: the time spent issuing each frame, and each frame's GPU time
+    std::vector<double> cpuMs, gpuMs;
+    // reserved for every frame, so a growing history doesn't allocate in the render loop. A --play-input run without
+    // --frames has no count (it ends with its log): it reserves a good while, and past that the histories grow, as
+    // ALLOC_RECORDING allocations --alloc-assert lets through
+    bool playUntilEnd = playInput && !framesGiven;
+    if (headless) {
+        size_t reserved = playUntilEnd ? (size_t)1 << 16 : (size_t)std::max(0, headlessFrames);
+        frameMs.reserve(reserved);
+        cpuMs.reserve(reserved);
+        gpuMs.reserve(reserved);
+    }
+    if (allocAssertFrom >= 0)
+        AllocTracker::Instance().AssertSteadyState((unsigned int)allocAssertFrom);
+
     // render loop
     // -----------
-    while (!glfwWindowShouldClose(window)) {
+    while (headless ? frameIndex < headlessFrames : !glfwWindowShouldClose(window)) {
+        PROFILE_ZONE("frame");
+        AllocTracker::Instance().BeginFrame();
+        GlCapture::Instance().BeginFrame();
+        // stress runs time the GPU whether or not the profiler's zones are compiled in. The time of the frame issued
+        // GPU_PROFILE_FRAMES ago is only there if its queries were ready; a dropped frame adds nothing
+        if (csv) {
+            if (GpuProfiler::Instance().BeginFrame()) {
+                ALLOC_SCOPE(ALLOC_RECORDING);
+                gpuMs.push_back(GpuProfiler::Instance().LastFrameMs());
+            }
+        }
+        else
+            PROFILE_GPU_FRAME();
+        RenderStats::Instance().BeginFrame();
+        hitchRecorder.FrameEnded(RenderStats::Instance().LastFrameMs());
+        PipelineStatistics::Instance().BeginFrame();
+        std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
         // --------------------
-        float currentFrame = static_cast<float>(glfwGetTime());
+        float currentFrame = fixedTimestep ? (float)frameIndex * FIXED_TIMESTEP : static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        // input
+        // input: live from GLFW or the next frame of the log being played back, recorded if asked; or the camera path
         // -----
-        processInput(window);
+        if (window) {
+            PROFILE_ZONE("input");
+            processInput(window);
+        }
+        FrameInput input = liveInput;
+        input.deltaTime = deltaTime;
+        liveInput = FrameInput();
+        if (playInput) {
+            if (!inputPlayback.Next(input)) {
+                std::cout << "Input: " << playInput << " ended after " << inputPlayback.Frames() << " frames" << std::endl;
+                break;
+            }
+            // moving by the recorded steps puts the camera exactly where it was in the recording
+            deltaTime = input.deltaTime;
+        }
+        apply_input(input);
+        inputRecorder.Add(input);
+        if (cameraPathFile) {
+            CameraKey key = cameraPath.Sample(currentFrame);
+            camera.SetPose(key.position, key.yaw, key.pitch, key.zoom);
+        }
 
         // render
         // ------
+        if (headless)
+            offscreen.Bind();
         glEnable(GL_DEPTH_TEST);
         glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        // bind textures
-        glBindTexture(GL_TEXTURE_2D, texture);
+        if (csv)
+            GpuProfiler::Instance().Begin("scene");
 
         // transformation things
         // ---------------------
 
-        // think of this as zooming things? i think?
-        glm::mat4 projection;
-        projection = glm::perspective(glm::radians(camera.Zoom), 800.0f / 600.0f, 0.1f, 100.0f);
+        // think of this as zooming things? i think? (the camera only rebuilds these when it moved, zoomed or was resized)
+        const glm::mat4 &projection = camera.GetProjectionMatrix();
 
         // this is like the camera
-        glm::mat4 view;
-        view = camera.GetViewMatrix();
+        const glm::mat4 &view = camera.GetViewMatrix();
+
+        // whatever is outside of this isn't drawn
+        const Frustum &frustum = camera.GetFrustum();
+
+        // the overdraw view draws the same passes into its counters, through shaders that count fragments
+        bool overdraw = overdrawMode != OVERDRAW_OFF;
+        Shader &blobShader = overdraw ? BlobOverdrawShader : BlobShader;
+        Shader &terrainShader = overdraw ? TerrainOverdrawShader : TerrainShader;
+
+        // uniforms keep their values, so the camera matrices are only sent again when they changed (the counting
+        // shaders get them every frame, and the scene's get them again once the view is off)
+        bool cameraChanged = camera.Version() != uploadedCameraVersion || overdraw;
+        uploadedCameraVersion = overdraw ? 0 : camera.Version();
 
         // movement of the box itself
         glm::mat4 model = glm::mat4(1.0f);
@@ -237,43 +647,213 @@ int main()
         terrain_model = glm::scale(terrain_model, grid_scale);
         terrain_model = glm::translate(terrain_model, glm::vec3(-(float)grid_dim, 0.0f, -(float)grid_dim));
 
+        // let the streamer know how big the blob's texture is on screen, then stream this frame's mip levels
+        glm::vec3 blob_center = glm::vec3(model * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        float blob_radius = 0.87f * blob_scale.x; // half the diagonal of the unit cube
+        TextureStreamer::Instance().RequestScreenSize(texture, ProjectedSize(blob_center, blob_radius, camera.Position, camera.Zoom, camera.ViewportHeight()));
+        for (int i = 0; stressModel && i < stressScene.Models(); i++)
+            stressModel->StreamTextures(stressScene.ModelTransform(i), camera.Position, camera.Zoom, camera.ViewportHeight());
+        {
+            PROFILE_ZONE("stream textures");
+            ALLOC_SCOPE(ALLOC_STREAMING);
+            TextureStreamer::Instance().Update();
+        }
+
+        // bind textures (after streaming, which binds the textures it uploads to)
+        GpuResidency::Instance().Touch(GPU_TEXTURE, texture);
+        CountedBindTexture(GL_TEXTURE_2D, texture);
+
         // activating shaders
         // ------------------
 
+        if (overdraw)
+            overdrawView.Begin(camera.ViewportWidth(), camera.ViewportHeight(), overdrawMode == OVERDRAW_DEPTH_TESTED);
+
         // activate the blob shader
-        BlobShader.use();
-        BlobShader.setMat4("projection", projection);
-        BlobShader.setMat4("view", view);
-        BlobShader.setMat4("model", model);
+        blobShader.use();
+        if (cameraChanged) {
+            blobShader.setMat4("projection", projection);
+            blobShader.setMat4("view", view);
+        }
 
-        // render the blob triangles
-        glBindVertexArray(VAO_blob);
-        glDrawArrays(GL_TRIANGLES,0, 36);
+        // render the blob triangles (a square of blobs in a stress scene, going through its textures)
+        {
+            PROFILE_ZONE("draw blob");
+            PROFILE_GPU_ZONE("blob");
+            ALLOC_SCOPE(ALLOC_RENDER);
+            PROFILE_COUNTERS("blob loop", stressScene.Blobs());
+            PipelineStatisticsPass statisticsPass("blob");
+            glBindVertexArray(VAO_blob);
+            unsigned int boundTexture = texture;
+            for (int i = 0; i < stressScene.Blobs(); i++) {
+                glm::mat4 blobModel = glm::translate(model, stressScene.BlobOffset(i));
+                if (!SphereInFrustum(frustum, glm::vec3(blobModel * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)), blob_radius))
+                    continue;
+                if (stressScene.BlobTexture(i) != boundTexture) {
+                    boundTexture = stressScene.BlobTexture(i);
+                    GpuResidency::Instance().Touch(GPU_TEXTURE, boundTexture);
+                    CountedBindTexture(GL_TEXTURE_2D, boundTexture);
+                }
+                blobShader.setMat4("model", blobModel);
+                CountedDrawArrays(GL_TRIANGLES,0, 36);
+            }
+        }
 
         // activate the terrain shader
-        TerrainShader.use();
-        TerrainShader.setMat4("projection", projection);
-        TerrainShader.setMat4("view", view);
+        terrainShader.use();
+        if (cameraChanged) {
+            terrainShader.setMat4("projection", projection);
+            terrainShader.setMat4("view", view);
+        }
 
         // render the blob triangles
         glBindVertexArray(VAO_terrain);
 
         // drawing the grid
-        draw_grid(terrain_model, TerrainShader);
+        {
+            PROFILE_GPU_ZONE("terrain");
+            ALLOC_SCOPE(ALLOC_RENDER);
+            PipelineStatisticsPass statisticsPass("terrain");
+            draw_grid(terrain_model, terrainShader);
+        }
+
+        // the stress scene's model instances
+        if (stressModel) {
+            PROFILE_ZONE("draw models");
+            ALLOC_SCOPE(ALLOC_RENDER);
+            Shader &modelShader = overdraw ? *ModelOverdrawShader : *ModelShader;
+            modelShader.use();
+            if (cameraChanged) {
+                modelShader.setMat4("projection", projection);
+                modelShader.setMat4("view", view);
+            }
+            for (int i = 0; i < stressScene.Models(); i++) {
+                glm::mat4 instance = stressScene.ModelTransform(i);
+                modelShader.setMat4("model", instance);
+                if (packedMaterials)
+                    stressModel->Draw(modelShader, materialPacker, frustum, instance);
+                else
+                    stressModel->Draw(modelShader, frustum, instance);
+            }
+        }
+
+        // the counts replace the scene
+        if (overdraw) {
+            overdrawView.End();
+            overdrawView.Show();
+        }
+
+        // last, over everything else
+        if (showHud) {
+            PROFILE_ZONE("hud");
+            ALLOC_SCOPE(ALLOC_PROFILER);
+            hud.Draw(camera.ViewportWidth(), camera.ViewportHeight(), overdraw ? &overdrawView : nullptr);
+        }
+
+        // evict what went cold if this frame's loads pushed usage over the budget
+        {
+            PROFILE_ZONE("residency");
+            ALLOC_SCOPE(ALLOC_STREAMING);
+            GpuResidency::Instance().EndFrame();
+        }
+
+        if (csv)
+            GpuProfiler::Instance().End();
+
+        if (headless) {
+            {
+                ALLOC_SCOPE(ALLOC_RECORDING);
+                cpuMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+            }
+            // nothing presents the frame, so wait for it to be rendered to know what it cost
+            {
+                PROFILE_ZONE("finish");
+                glFinish();
+            }
+            {
+                ALLOC_SCOPE(ALLOC_RECORDING);
+                frameMs.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+            }
+            frameIndex++;
+            continue;
+        }
 
         // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
         // -------------------------------------------------------------------------------
+        PROFILE_ZONE("swap");
         glfwSwapBuffers(window);
         glfwPollEvents();
+        frameIndex++;
+    }
+    AllocTracker::Instance().EndFrames();
+    // a run shorter than the capture ends it here
+    GlCapture::Instance().del();
+    if (inputRecorder.IsOpen()) {
+        std::cout << "Input: recorded " << inputRecorder.Frames() << " frames to " << recordInput << std::endl;
+        inputRecorder.Close();
+    }
+
+    if (trace) {
+        // the last frames' GPU zones are still in flight
+        GpuProfiler::Instance().Flush();
+        Profiler::Instance().WriteChromeTrace(trace);
+    }
+
+    // closes the last frame's counters and time
+    RenderStats::Instance().BeginFrame();
+    print_frame_percentiles("frame ms", RenderStats::Instance().Histogram());
+    // IPC and misses per element of the PROFILE_COUNTERS loops (see perf_counters.h)
+    PerfCounters::Instance().Print();
+    AllocTracker::Instance().Print();
+    if (hitchRecorder.Enabled())
+        std::printf("hitches over %.1f ms: %u, %u traces written\n", hitchMs, hitchRecorder.Hitches(), hitchRecorder.Dumps());
+    hitchRecorder.del();
+
+    if (headless) {
+        print_frame_stats(frameMs);
+        if (overdrawMode != OVERDRAW_OFF)
+            std::printf("overdraw (%s): mean %.3f  covered mean %.3f  max %.0f\n", overdrawMode == OVERDRAW_ALL ? "all fragments" : "depth tested",
+                        overdrawView.MeanOverdraw(), overdrawView.CoveredMeanOverdraw(), overdrawView.MaxOverdraw());
+        for (const PassStatistics &pass : PipelineStatistics::Instance().LastFrame())
+            std::printf("%s: %llu vertices submitted  %llu vertex shader invocations  %llu primitives clipped into %llu  %llu fragment shader invocations\n",
+                        pass.name, (unsigned long long)pass.verticesSubmitted, (unsigned long long)pass.vertexShaderInvocations,
+                        (unsigned long long)pass.clippingInputPrimitives, (unsigned long long)pass.clippingOutputPrimitives,
+                        (unsigned long long)pass.fragmentShaderInvocations);
+        if (screenshot && !offscreen.WritePpm(screenshot))
+            return -1;
+        if (csv && !AppendStressCsv(csv, stressConfig, measure_stress_run(frameMs, cpuMs, gpuMs)))
+            return -1;
     }
 
     // optional: de-allocate all resources once they've outlived their purpose:
     // ------------------------------------------------------------------------
     glDeleteVertexArrays(1, &VAO_blob);
     glDeleteVertexArrays(1, &VAO_terrain);
+    GpuResidency::Instance().Untrack(GPU_BUFFER, VBO_blob);
+    GpuResidency::Instance().Untrack(GPU_BUFFER, VBO_terrain);
     glDeleteBuffers(1, &VBO_blob);
     glDeleteBuffers(1, &VBO_terrain);
-
+    stressScene.del();
+    if (stressModel) {
+        stressModel->del();
+        materialPacker.del();
+        ModelShader->del();
+        ModelOverdrawShader->del();
+    }
+    TextureCache::Instance().Release(texture);
+    GpuProfiler::Instance().del();
+    hud.del();
+    overdrawView.del();
+    BlobOverdrawShader.del();
+    TerrainOverdrawShader.del();
+    PipelineStatistics::Instance().del();
+
+
+    if (headless) {
+        offscreen.del();
+        headlessContext.del();
+        return 0;
+    }
 
     // glfw: terminate, clearing all previously allocated GLFW resources.
     // ------------------------------------------------------------------
@@ -281,33 +861,97 @@ int main()
     return 0;
 }
 
-void draw_grid(glm::mat4 terrain_model, Shader TerrainShader) {
-    float val1, val2;
-    // rows
-    for (int i = 0; i < grid_dim; i++) {
-        // setting val1 and val2 to get the checkered pattern
-        if (i % 2 == 0) {
-            val1 = 1.0f;
-            val2 = 0.0f;
-        } else {
-            val1 = 0.0f;
-            val2 = 1.0f;
+// frame time percentiles, at exit and when P is pressed
+void print_frame_percentiles(const char *label, const FrameHistogram &histogram) {
+    std::printf("%s over %llu frames: p50 %.2f  p95 %.2f  p99 %.2f  max %.2f\n", label, (unsigned long long)histogram.Count(),
+                histogram.Percentile(0.5), histogram.Percentile(0.95), histogram.Percentile(0.99), histogram.Max());
+    std::fflush(stdout);
+}
+
+// headless summary: how long frames took, from the first (which includes warming up) to the slowest
+void print_frame_stats(std::vector<double> frameMs) {
+    if (frameMs.empty())
+        return;
+    double total = 0.0;
+    for (double ms : frameMs)
+        total += ms;
+    std::sort(frameMs.begin(), frameMs.end());
+    size_t count = frameMs.size();
+    std::printf("frames: %zu in %.3f s (%.1f fps)\n", count, total / 1000.0, count * 1000.0 / total);
+    std::printf("frame ms: min %.3f  mean %.3f  median %.3f  p99 %.3f  max %.3f\n", frameMs[0], total / count,
+                frameMs[count / 2], frameMs[std::min(count - 1, (size_t)(count * 0.99))], frameMs[count - 1]);
+    const RenderCounters &last = RenderStats::Instance().Last();
+    std::printf("last frame: %u draws  %zu triangles  %zu vertices  %u program switches  %u texture binds  %zu bytes uploaded  %u uniform updates\n",
+                last.drawCalls, last.triangles, last.vertices, last.programSwitches, last.textureBinds, last.bufferUploadBytes, last.uniformUpdates);
+}
+
+// the --csv row of a headless run: means over the frames after the first tenth (loading and warming up), peak memory
+StressSceneResult measure_stress_run(const std::vector<double> &frameMs, std::vector<double> cpuMs, const std::vector<double> &gpuMs) {
+    StressSceneResult result;
+    result.frames = (int)frameMs.size();
+    size_t skip = frameMs.size() / 10;
+    if (cpuMs.size() > skip) {
+        double cpuTotal = 0.0, frameTotal = 0.0;
+        for (size_t i = skip; i < cpuMs.size(); i++) {
+            cpuTotal += cpuMs[i];
+            frameTotal += frameMs[i];
         }
-        // columns
-        for (int j = 0; j < grid_dim; j++) {
-            // setting the uniform to its colour
-            if (j % 2 == 0) {
-                TerrainShader.setVec4("aColour", val1, 0.0f, 0.0f, 1.0f);
-            } else {
-                TerrainShader.setVec4("aColour", val2, 0.0f, 0.0f, 1.0f);
+        result.cpuMs = cpuTotal / (double)(cpuMs.size() - skip);
+        result.frameMs = frameTotal / (double)(cpuMs.size() - skip);
+        std::sort(cpuMs.begin() + skip, cpuMs.end());
+        size_t count = cpuMs.size() - skip;
+        result.cpuP99Ms = cpuMs[skip + std::min(count - 1, (size_t)(count * 0.99))];
+    }
+    // gpuMs holds the frames whose GPU time came in, from GPU_PROFILE_FRAMES frames late on, without the dropped ones
+    if (gpuMs.size() > skip) {
+        double gpuTotal = 0.0;
+        for (size_t i = skip; i < gpuMs.size(); i++)
+            gpuTotal += gpuMs[i];
+        result.gpuMs = gpuTotal / (double)(gpuMs.size() - skip);
+    }
+    const RenderCounters &last = RenderStats::Instance().Last();
+    result.drawCalls = last.drawCalls;
+    result.triangles = last.triangles;
+    result.gpuBytes = GpuResidency::Instance().HighWaterBytes();
+    result.peakResidentBytes = PeakResidentBytes();
+    return result;
+}
+
+void draw_grid(glm::mat4 terrain_model, Shader TerrainShader) {
+    // world space boxes of all the squares, in row order, and the ones that were visible. Both are only redone
+    // when the camera or the grid moved
+    static BoundingBoxes cells;
+    static std::vector<unsigned int> visible;
+    static unsigned int culledVersion = 0;
+    static glm::mat4 culledModel;
+    static int culledDim = 0;
+    PROFILE_ZONE("draw_grid");
+    if (culledVersion != camera.Version() || culledModel != terrain_model || culledDim != grid_dim) {
+        PROFILE_ZONE("cull grid");
+        PROFILE_COUNTERS("cull grid", grid_dim * grid_dim);
+        cells.Clear();
+        for (int i = 0; i < grid_dim; i++) {
+            for (int j = 0; j < grid_dim; j++) {
+                // square (i, j) sits j + 1 steps along the row and i rows down
+                glm::mat4 cell = glm::translate(terrain_model, glm::vec3(2.0f * (float)(j + 1), 0.0f, 2.0f * (float)i));
+                glm::vec3 a = glm::vec3(cell * glm::vec4(-1.0f, 0.0f, -1.0f, 1.0f));
+                glm::vec3 b = glm::vec3(cell * glm::vec4(1.0f, 0.0f, 1.0f, 1.0f));
+                cells.Add(glm::min(a, b), glm::max(a, b));
             }
-            // moving each square
-            terrain_model = glm::translate(terrain_model, glm::vec3(2.0f,  0.0f, 0.0f));
-            TerrainShader.setMat4("model", terrain_model);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
         }
-        // moving to the next row
-        terrain_model = glm::translate(terrain_model, glm::vec3(-(float)grid_dim * 2.0f, 0.0f, 2.0f));
+        CullBoxes(camera.GetFrustum(), cells, visible);
+        culledVersion = camera.Version();
+        culledModel = terrain_model;
+        culledDim = grid_dim;
+    }
+
+    for (unsigned int index : visible) {
+        int i = (int)index / grid_dim, j = (int)index % grid_dim;
+        // the checkered pattern: red where row and column are both even or both odd
+        float colour = (i + j) % 2 == 0 ? 1.0f : 0.0f;
+        TerrainShader.setVec4("aColour", colour, 0.0f, 0.0f, 1.0f);
+        TerrainShader.setMat4("model", glm::translate(terrain_model, glm::vec3(2.0f * (float)(j + 1), 0.0f, 2.0f * (float)i)));
+        CountedDrawArrays(GL_TRIANGLES, 0, 6);
     }
 }
 
@@ -327,11 +971,39 @@ void mouse_callback(GLFWwindow *window, double xpos, double ypos) {
     lastX = xpos;
     lastY = ypos;
 
-    camera.ProcessMouseMovement(xoffset, yoffset, true);
+    // applied with the rest of the frame's input (see apply_input)
+    liveInput.mouseX += xoffset;
+    liveInput.mouseY += yoffset;
 }
 
 void scroll_callback(GLFWwindow *window, double xoffset, double yoffset) {
-    camera.ProcessMouseScroll(yoffset);
+    liveInput.scroll += (float)yoffset;
+}
+
+// moves the camera and the blob by one frame's input, live or played back
+void apply_input(const FrameInput &input) {
+    if (input.keys & INPUT_FORWARD)
+        camera.ProcessKeyboard(FORWARD, input.deltaTime);
+    if (input.keys & INPUT_BACKWARD)
+        camera.ProcessKeyboard(BACKWARD, input.deltaTime);
+    if (input.keys & INPUT_LEFT)
+        camera.ProcessKeyboard(LEFT, input.deltaTime);
+    if (input.keys & INPUT_RIGHT)
+        camera.ProcessKeyboard(RIGHT, input.deltaTime);
+
+    if (input.keys & INPUT_BLOB_LEFT)
+        move_x -= moveAdjustment;
+    if (input.keys & INPUT_BLOB_RIGHT)
+        move_x += moveAdjustment;
+    if (input.keys & INPUT_BLOB_UP)
+        move_z -= moveAdjustment;
+    if (input.keys & INPUT_BLOB_DOWN)
+        move_z += moveAdjustment;
+
+    if (input.mouseX != 0.0f || input.mouseY != 0.0f)
+        camera.ProcessMouseMovement(input.mouseX, input.mouseY, true);
+    if (input.scroll != 0.0f)
+        camera.ProcessMouseScroll(input.scroll);
 }
 
 // process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
@@ -346,23 +1018,45 @@ void processInput(GLFWwindow *window) {
 
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
+    // the keys moving the camera and the blob are collected into liveInput, apply_input acts on them
     if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
-        camera.ProcessKeyboard(FORWARD, deltaTime);
+        liveInput.keys |= INPUT_FORWARD;
     if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
-        camera.ProcessKeyboard(BACKWARD, deltaTime);
+        liveInput.keys |= INPUT_BACKWARD;
     if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
-        camera.ProcessKeyboard(LEFT, deltaTime);
+        liveInput.keys |= INPUT_LEFT;
     if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
-        camera.ProcessKeyboard(RIGHT, deltaTime);
+        liveInput.keys |= INPUT_RIGHT;
 
     if(glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
-        move_x -= moveAdjustment;
+        liveInput.keys |= INPUT_BLOB_LEFT;
     if(glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
-        move_x += moveAdjustment;
+        liveInput.keys |= INPUT_BLOB_RIGHT;
     if(glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
-        move_z -= moveAdjustment;
+        liveInput.keys |= INPUT_BLOB_UP;
     if(glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
-        move_z += moveAdjustment;
+        liveInput.keys |= INPUT_BLOB_DOWN;
+
+    // H shows and hides the HUD, once per press
+    static bool hudKeyDown = false;
+    bool hudKey = glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS;
+    if (hudKey && !hudKeyDown)
+        showHud = !showHud;
+    hudKeyDown = hudKey;
+
+    // O cycles the overdraw view: off, depth tested, every fragment
+    static bool overdrawKeyDown = false;
+    bool overdrawKey = glfwGetKey(window, GLFW_KEY_O) == GLFW_PRESS;
+    if (overdrawKey && !overdrawKeyDown)
+        overdrawMode = (OverdrawMode)((overdrawMode + 1) % 3);
+    overdrawKeyDown = overdrawKey;
+
+    // P prints the frame time percentiles so far
+    static bool percentilesKeyDown = false;
+    bool percentilesKey = glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS;
+    if (percentilesKey && !percentilesKeyDown)
+        print_frame_percentiles("frame ms", RenderStats::Instance().Histogram());
+    percentilesKeyDown = percentilesKey;
 
 
 }
@@ -373,4 +1067,6 @@ void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     // make sure the viewport matches the new window dimensions; note that width and
     // height will be significantly larger than specified on retina displays.
     glViewport(0, 0, width, height);
+    // and the projection its aspect ratio
+    camera.SetViewport(width, height);
 }
\ No newline at end of file
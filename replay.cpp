@@ -0,0 +1,180 @@
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <gl_replay.h>
+#include <headless.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// plays the frames of a GL capture (blob_sea_src --gl-capture, see Inc/gl_capture.h) in a loop and times them, to
+// see what the driver and the GPU spend on exactly the app's command stream with nothing of the app around it.
+//
+//   blob_sea_replay capture.glc [--loops n] [--warmup n]
+//
+// Every frame is timed twice: until its calls are issued ("submit", the driver's CPU cost) and until glFinish
+// returns ("frame", with the GPU's). Run the same capture on two drivers, llvmpipe and the hardware one, to compare
+// them on identical frames. Built with -DBLOB_SEA_HEADLESS=ON it renders through EGL into an offscreen target of the
+// captured size, otherwise into a hidden GLFW window.
+
+static void printUsage()
+{
+    std::cout << "usage: blob_sea_replay capture.glc [--loops n] [--warmup n]" << std::endl;
+}
+
+// nearest rank
+static double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t rank = (size_t)std::max(1.0, std::ceil(p * (double)values.size()));
+    return values[std::min(rank, values.size()) - 1];
+}
+
+static void printTimes(const char *label, unsigned int calls, const std::vector<double> &submitMs, const std::vector<double> &frameMs)
+{
+    std::printf("%-10s %7u calls   submit median %8.3f ms  p99 %8.3f ms   frame median %8.3f ms  p99 %8.3f ms\n", label,
+                calls, percentile(submitMs, 0.5), percentile(submitMs, 0.99), percentile(frameMs, 0.5), percentile(frameMs, 0.99));
+}
+
+static void replay(GlReplay &capture, unsigned int loops, unsigned int warmup)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    capture.PlaySetup();
+    glFinish();
+    std::printf("setup: %u calls, %.1f ms\n", capture.Calls(),
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+    // the first plays fill the driver's caches (shader variants, buffer residency), like the app's first frames did
+    for (unsigned int loop = 0; loop < warmup; loop++)
+        for (unsigned int frame = 0; frame < capture.Frames(); frame++)
+            capture.PlayFrame(frame);
+    glFinish();
+
+    std::vector<std::vector<double>> submitMs(capture.Frames()), frameMs(capture.Frames());
+    std::vector<unsigned int> calls(capture.Frames());
+    std::vector<double> allSubmitMs, allFrameMs;
+    for (unsigned int loop = 0; loop < loops; loop++)
+    {
+        for (unsigned int frame = 0; frame < capture.Frames(); frame++)
+        {
+            std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+            capture.PlayFrame(frame);
+            std::chrono::steady_clock::time_point submitted = std::chrono::steady_clock::now();
+            glFinish();
+            std::chrono::steady_clock::time_point finished = std::chrono::steady_clock::now();
+            submitMs[frame].push_back(std::chrono::duration<double, std::milli>(submitted - frameStart).count());
+            frameMs[frame].push_back(std::chrono::duration<double, std::milli>(finished - frameStart).count());
+            allSubmitMs.push_back(submitMs[frame].back());
+            allFrameMs.push_back(frameMs[frame].back());
+            calls[frame] = capture.Calls();
+        }
+    }
+
+    for (unsigned int frame = 0; frame < capture.Frames() && capture.Frames() > 1; frame++)
+    {
+        char label[32];
+        std::snprintf(label, sizeof(label), "frame %u", frame);
+        printTimes(label, calls[frame], submitMs[frame], frameMs[frame]);
+    }
+    unsigned int totalCalls = 0;
+    for (unsigned int frameCalls : calls)
+        totalCalls += frameCalls;
+    std::printf("%u loop(s) of %u frame(s):\n", loops, capture.Frames());
+    printTimes("all", totalCalls / std::max(1u, capture.Frames()), allSubmitMs, allFrameMs);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = NULL;
+    unsigned int loops = 100, warmup = 10;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--loops") == 0 && i + 1 < argc)
+            loops = (unsigned int)std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            warmup = (unsigned int)std::max(0, std::atoi(argv[++i]));
+        else if (argv[i][0] != '-' && !path)
+            path = argv[i];
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (!path)
+    {
+        printUsage();
+        return 1;
+    }
+
+    GlReplay capture;
+#ifdef BLOB_SEA_HEADLESS
+    HeadlessContext context;
+    if (!context.Create() || !gladLoadGLLoader((GLADloadproc)HeadlessContext::GetProcAddress))
+    {
+        std::cout << "GL replay: no headless context" << std::endl;
+        return 1;
+    }
+    std::cout << "GL: " << context.Renderer() << std::endl;
+    if (!capture.Load(path))
+        return 1;
+    // stands in for the default framebuffer the capture drew to
+    OffscreenTarget target;
+    if (!target.Create(capture.Width(), capture.Height()))
+        return 1;
+    capture.SetDefaultFramebuffer(target.Framebuffer());
+    replay(capture, loops, warmup);
+    capture.del();
+    target.del();
+    context.del();
+#else
+    if (!glfwInit())
+    {
+        std::cout << "GL replay: GLFW failed to initialise" << std::endl;
+        return 1;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    // a placeholder size until the capture says which
+    GLFWwindow *window = glfwCreateWindow(64, 64, "blob_sea_replay", NULL, NULL);
+    if (!window)
+    {
+        std::cout << "GL replay: no window (configure with -DBLOB_SEA_HEADLESS=ON for EGL)" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        glfwTerminate();
+        return 1;
+    }
+    std::cout << "GL: " << (const char *)glGetString(GL_RENDERER) << std::endl;
+    if (!capture.Load(path))
+    {
+        glfwTerminate();
+        return 1;
+    }
+    glfwSetWindowSize(window, capture.Width(), capture.Height());
+    replay(capture, loops, warmup);
+    capture.del();
+    glfwTerminate();
+#endif
+    return 0;
+}
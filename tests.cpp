@@ -0,0 +1,287 @@
+//
+// Created on 2026-10-18.
+//
+
+#include <benchmark.h>
+#include <input_log.h>
+#include <ktx.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// round trips of the formats the tools write and read back: cooked KTX textures, --record-input logs and
+// blob_sea_bench's --json results (and the --baseline comparison made from them). Run by ctest, or on its own:
+//
+//   blob_sea_tests
+//
+// Every test writes its files into the working directory and removes them again. The exit code is the number of
+// failed checks.
+
+static int failures = 0;
+
+#define CHECK(condition)                                                                                        \
+    do {                                                                                                        \
+        if (!(condition))                                                                                       \
+        {                                                                                                       \
+            std::cout << __FILE__ << ":" << __LINE__ << ": check failed: " #condition << std::endl;            \
+            failures++;                                                                                         \
+        }                                                                                                       \
+    } while (0)
+
+static std::vector<unsigned char> readBytes(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<unsigned char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void writeBytes(const std::string &path, const std::vector<unsigned char> &bytes)
+{
+    std::ofstream file(path, std::ios::binary);
+    file.write((const char *)bytes.data(), (std::streamsize)bytes.size());
+}
+
+// an 8x4 RGBA8 texture with its full chain, every byte different so a level read from the wrong place shows
+static KtxImage testImage()
+{
+    KtxImage image;
+    image.glInternalFormat = GL_RGBA8;
+    image.glBaseInternalFormat = GL_RGBA;
+    image.glFormat = GL_RGBA;
+    image.glType = GL_UNSIGNED_BYTE;
+    image.width = 8;
+    image.height = 4;
+    unsigned char value = 0;
+    for (int level = 0; level < 4; level++)
+    {
+        image.levels.emplace_back((size_t)KtxLevelWidth(image, level) * KtxLevelHeight(image, level) * 4);
+        for (unsigned char &byte : image.levels.back())
+            byte = value++;
+    }
+    return image;
+}
+
+// the header's 32 bit fields follow the 12 byte identifier in this order
+enum KtxHeaderField {
+    KTX_PIXEL_WIDTH = 6,
+    KTX_PIXEL_HEIGHT = 7,
+    KTX_MIPMAP_LEVELS = 11
+};
+
+static void setHeaderField(std::vector<unsigned char> &bytes, KtxHeaderField field, unsigned int value)
+{
+    std::memcpy(bytes.data() + 12 + field * 4, &value, sizeof(value));
+}
+
+static void testKtx()
+{
+    const std::string path = "blob_sea_tests.ktx";
+    KtxImage image = testImage();
+    CHECK(WriteKtx(path, image));
+
+    KtxImage read;
+    CHECK(ReadKtx(path, read));
+    CHECK(read.glInternalFormat == image.glInternalFormat && read.glBaseInternalFormat == image.glBaseInternalFormat);
+    CHECK(read.glFormat == image.glFormat && read.glType == image.glType);
+    CHECK(read.width == image.width && read.height == image.height);
+    CHECK(read.levels == image.levels);
+
+    // the streaming path finds the same levels, from the file and from memory
+    KtxImage layout;
+    std::vector<KtxLevelRange> ranges;
+    CHECK(ReadKtxLayout(path, layout, ranges) && layout.levels.empty());
+    CHECK(ranges.size() == image.levels.size());
+    for (size_t level = 0; level < ranges.size() && level < image.levels.size(); level++)
+    {
+        std::vector<unsigned char> data;
+        CHECK(ReadKtxLevel(path, ranges[level], data) && data == image.levels[level]);
+    }
+    std::vector<unsigned char> bytes = readBytes(path);
+    std::vector<KtxLevelRange> memoryRanges;
+    CHECK(ParseKtxLayout(bytes.data(), bytes.size(), path, layout, memoryRanges));
+    CHECK(memoryRanges.size() == ranges.size() && memoryRanges.back().offset == ranges.back().offset);
+
+    // corrupt headers are turned down before they size anything, and leave the image as it was
+    std::vector<unsigned char> corrupt = bytes;
+    setHeaderField(corrupt, KTX_MIPMAP_LEVELS, 0x7fffffff);
+    writeBytes(path, corrupt);
+    CHECK(!ReadKtx(path, read) && read.width == image.width && read.levels == image.levels);
+    CHECK(!ReadKtxLayout(path, layout, ranges));
+    CHECK(!ParseKtxLayout(corrupt.data(), corrupt.size(), path, layout, ranges));
+
+    corrupt = bytes;
+    setHeaderField(corrupt, KTX_MIPMAP_LEVELS, 5);  // an 8x4 texture has 4
+    writeBytes(path, corrupt);
+    CHECK(!ReadKtx(path, read));
+
+    corrupt = bytes;
+    setHeaderField(corrupt, KTX_PIXEL_WIDTH, 0);
+    writeBytes(path, corrupt);
+    CHECK(!ReadKtx(path, read));
+
+    corrupt = bytes;
+    setHeaderField(corrupt, KTX_PIXEL_HEIGHT, 0x80000000u);
+    writeBytes(path, corrupt);
+    CHECK(!ReadKtx(path, read));
+
+    // a level size that doesn't match the header, and a file cut short
+    corrupt = bytes;
+    setHeaderField(corrupt, KTX_PIXEL_WIDTH, 16);
+    writeBytes(path, corrupt);
+    CHECK(!ReadKtx(path, read));
+
+    corrupt.assign(bytes.begin(), bytes.end() - 8);
+    writeBytes(path, corrupt);
+    CHECK(!ReadKtx(path, read));
+
+    writeBytes(path, std::vector<unsigned char>(bytes.begin(), bytes.begin() + 20));
+    CHECK(!ReadKtx(path, read));
+    CHECK(!ParseKtxLayout(bytes.data(), 20, path, layout, ranges));
+
+    std::remove(path.c_str());
+}
+
+static bool sameInput(const FrameInput &a, const FrameInput &b)
+{
+    return a.deltaTime == b.deltaTime && a.keys == b.keys && a.mouseX == b.mouseX && a.mouseY == b.mouseY &&
+           a.scroll == b.scroll;
+}
+
+static void testInputLog()
+{
+    const std::string path = "blob_sea_tests.bsin";
+    InputStart start;
+    start.position = glm::vec3(1.0f, 2.5f, -3.0f);
+    start.yaw = -90.0f;
+    start.pitch = 12.5f;
+    start.zoom = 45.0f;
+    start.blobX = 0.25f;
+    start.blobZ = -4.0f;
+
+    // frames with and without mouse movement and scrolling, which are only written when there
+    std::vector<FrameInput> frames(4);
+    frames[0].deltaTime = 1.0f / 60.0f;
+    frames[1].deltaTime = 0.02f;
+    frames[1].keys = INPUT_FORWARD | INPUT_BLOB_LEFT;
+    frames[1].mouseX = 3.5f;
+    frames[1].mouseY = -1.0f;
+    frames[2].deltaTime = 0.5f;
+    frames[2].scroll = -2.0f;
+    frames[3].deltaTime = 0.001f;
+    frames[3].keys = INPUT_BACKWARD | INPUT_RIGHT | INPUT_BLOB_DOWN;
+    frames[3].mouseY = 0.125f;
+    frames[3].scroll = 1.0f;
+
+    {
+        InputRecorder recorder;
+        CHECK(recorder.Open(path, start));
+        for (const FrameInput &input : frames)
+            recorder.Add(input);
+        CHECK(recorder.Frames() == frames.size());
+    }
+
+    InputPlayback playback;
+    CHECK(playback.Open(path));
+    CHECK(playback.Start().position == start.position && playback.Start().yaw == start.yaw &&
+          playback.Start().pitch == start.pitch && playback.Start().zoom == start.zoom &&
+          playback.Start().blobX == start.blobX && playback.Start().blobZ == start.blobZ);
+    FrameInput input;
+    for (const FrameInput &expected : frames)
+        CHECK(playback.Next(input) && sameInput(input, expected));
+    CHECK(!playback.Next(input));
+    CHECK(playback.Frames() == frames.size());
+    playback.Close();
+
+    // 4 + 4 bytes of magic and version, 8 floats of start, then 6 bytes per frame plus what follows
+    CHECK(readBytes(path).size() == 8 + 8 * 4 + 4 * 6 + 2 * 4 + 4 + 2 * 4 + 4);
+
+    // a frame cut off in the middle ends the log, a file that isn't a log doesn't open
+    std::vector<unsigned char> bytes = readBytes(path);
+    writeBytes(path, std::vector<unsigned char>(bytes.begin(), bytes.end() - 2));
+    CHECK(playback.Open(path));
+    for (size_t i = 0; i + 1 < frames.size(); i++)
+        CHECK(playback.Next(input));
+    CHECK(!playback.Next(input));
+    playback.Close();
+
+    bytes[0] = 'X';
+    writeBytes(path, bytes);
+    CHECK(!playback.Open(path) && !playback.IsOpen());
+
+    std::remove(path.c_str());
+}
+
+static BenchmarkResult benchmarkResult(const std::string &name, double medianNs, double madNs)
+{
+    BenchmarkResult result;
+    result.name = name;
+    result.operations = 1024;
+    result.samples = 101;
+    result.medianNs = medianNs;
+    result.p99Ns = medianNs * 1.5;
+    result.minNs = medianNs * 0.75;
+    result.meanNs = medianNs * 1.125;
+    result.madNs = madNs;
+    return result;
+}
+
+static void testBenchmarkJson()
+{
+    const std::string path = "blob_sea_tests.json";
+    std::vector<BenchmarkResult> results;
+    results.push_back(benchmarkResult("camera_view_matrix", 12.5, 0.25));
+    results.push_back(benchmarkResult("cull_boxes_4k_avx", 1250.0, 10.0));
+    results.push_back(benchmarkResult("stb_decode_resources_jpg_scalar", 91000000.0, 250000.0));
+    CHECK(WriteBenchmarkJson(path, results));
+
+    std::vector<BenchmarkResult> read;
+    CHECK(ReadBenchmarkJson(path, read));
+    CHECK(read.size() == results.size());
+    for (size_t i = 0; i < read.size() && i < results.size(); i++)
+    {
+        CHECK(read[i].name == results[i].name);
+        CHECK(read[i].medianNs == results[i].medianNs && read[i].p99Ns == results[i].p99Ns);
+        CHECK(read[i].minNs == results[i].minNs && read[i].meanNs == results[i].meanNs);
+        CHECK(read[i].madNs == results[i].madNs);
+    }
+    std::remove(path.c_str());
+    CHECK(!ReadBenchmarkJson(path, read));
+
+    // a run against itself has no regressions
+    CHECK(CompareBenchmarks(results, results, 0.1).empty());
+
+    // slower by more than the threshold and the noise of both runs
+    std::vector<BenchmarkResult> current;
+    current.push_back(benchmarkResult("camera_view_matrix", 15.0, 0.25));
+    // slower by more than the threshold, but not by more than the noise
+    current.push_back(benchmarkResult("cull_boxes_4k_avx", 1500.0, 300.0));
+    // slower, but within the threshold
+    current.push_back(benchmarkResult("stb_decode_resources_jpg_scalar", 95000000.0, 250000.0));
+    // not in the baseline
+    current.push_back(benchmarkResult("stb_decode_resources_jpg_avx2", 1.0e9, 0.0));
+    std::vector<BenchmarkRegression> regressions = CompareBenchmarks(results, current, 0.1);
+    CHECK(regressions.size() == 1);
+    if (regressions.size() == 1)
+    {
+        CHECK(regressions[0].name == "camera_view_matrix");
+        CHECK(regressions[0].baselineNs == 12.5 && regressions[0].currentNs == 15.0);
+        CHECK(regressions[0].ratio == 1.2);
+    }
+    CHECK(CompareBenchmarks(results, current, 0.25).empty());
+}
+
+int main()
+{
+    testKtx();
+    testInputLog();
+    testBenchmarkJson();
+    if (failures > 0)
+        std::cout << failures << " checks failed" << std::endl;
+    else
+        std::cout << "all checks passed" << std::endl;
+    return failures;
+}